@@ -0,0 +1,242 @@
+#include "bench_graphs.hpp"
+#include "graph/algorithm/shortest_paths.hpp"
+#include "graph/algorithm/mis.hpp"
+#include "graph/algorithm/transitive_closure.hpp"
+#include "graph/algorithm/triangle_count.hpp"
+#include "graph/algorithm/page_rank.hpp"
+#include "graph/algorithm/connected_components.hpp"
+#include "graph/algorithm/strongly_connected_components.hpp"
+#include "graph/algorithm/biconnected_components.hpp"
+#include "graph/algorithm/mst.hpp"
+#include "graph/algorithm/label_propagation.hpp"
+#include <vector>
+#include <iterator>
+
+using std::graph::vertex_id_t;
+using std::graph::vertices;
+using std::graph::edge_reference_t;
+
+using namespace graph_benchmark;
+
+// An output iterator that only counts the values assigned to it.
+struct counting_output_iterator {
+  using difference_type = ptrdiff_t;
+  size_t* count         = nullptr;
+
+  counting_output_iterator& operator*() { return *this; }
+  counting_output_iterator& operator++() { return *this; }
+  counting_output_iterator  operator++(int) { return *this; }
+  template <class T>
+  counting_output_iterator& operator=(T&&) {
+    ++*count;
+    return *this;
+  }
+};
+
+template <class G>
+static void BM_dijkstra_shortest_paths(benchmark::State& state) {
+  auto&&              g    = bench_graph<G>(state);
+  auto                seed = max_degree_vertex(g);
+  const size_t        n    = std::ranges::size(vertices(g));
+  std::vector<int>    distance(n);
+  std::vector<size_t> predecessor(n);
+  auto                weight = [&g](edge_reference_t<G> uv) { return std::graph::edge_value(g, uv); };
+  for (auto _ : state) {
+    std::ranges::fill(distance, std::graph::dijkstra_invalid_distance<G, int>());
+    std::graph::dijkstra_shortest_paths(g, seed, distance, predecessor, weight);
+    benchmark::DoNotOptimize(distance.data());
+  }
+  set_graph_counters(state, g, n);
+}
+
+template <class G>
+static void BM_maximal_independent_set(benchmark::State& state) {
+  auto&&                      g = bench_graph<G>(state);
+  std::vector<vertex_id_t<G>> mis;
+  for (auto _ : state) {
+    mis.clear();
+    std::graph::maximal_independent_set(g, std::back_inserter(mis), vertex_id_t<G>(0));
+    benchmark::DoNotOptimize(mis.data());
+  }
+  state.counters["mis"] = static_cast<double>(mis.size());
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_dfs_transitive_closure(benchmark::State& state) {
+  auto&& g     = bench_graph<G>(state);
+  size_t pairs = 0;
+  for (auto _ : state) {
+    pairs = 0;
+    std::graph::dfs_transitive_closure(g, counting_output_iterator{&pairs});
+  }
+  state.counters["pairs"] = static_cast<double>(pairs);
+  set_graph_counters(state, g, pairs);
+}
+
+// triangle_count requires a symmetric graph
+template <class G>
+static void BM_triangle_count(benchmark::State& state) {
+  auto&& g         = bench_graph<G>(state);
+  size_t triangles = 0;
+  for (auto _ : state) {
+    triangles = std::graph::triangle_count(g);
+    benchmark::DoNotOptimize(triangles);
+  }
+  state.counters["triangles"] = static_cast<double>(triangles);
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_page_rank(benchmark::State& state) {
+  auto&&              g  = bench_graph<G>(state);
+  auto&&              gt = bench_transpose<G>(state);
+  std::vector<double> ranks(std::ranges::size(vertices(g)));
+  size_t              iterations = 0;
+  for (auto _ : state) {
+    iterations = std::graph::page_rank(g, gt, ranks);
+    benchmark::DoNotOptimize(ranks.data());
+  }
+  state.counters["iterations"] = static_cast<double>(iterations);
+  size_t edge_count            = 0;
+  for (auto&& u : vertices(g))
+    edge_count += static_cast<size_t>(std::ranges::distance(std::graph::edges(g, u)));
+  set_graph_counters(state, g, edge_count * iterations);
+}
+
+template <class G>
+static void BM_connected_components(benchmark::State& state) {
+  auto&&                g = bench_graph<G>(state);
+  std::vector<uint32_t> component(std::ranges::size(vertices(g)));
+  size_t                components = 0;
+  for (auto _ : state) {
+    components = std::graph::connected_components(g, component);
+    benchmark::DoNotOptimize(component.data());
+  }
+  state.counters["components"] = static_cast<double>(components);
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+// afforest_connected_components requires a symmetric graph
+template <class G>
+static void BM_afforest_connected_components(benchmark::State& state) {
+  auto&&                g = bench_graph<G>(state);
+  std::vector<uint32_t> component(std::ranges::size(vertices(g)));
+  size_t                components = 0;
+  for (auto _ : state) {
+    components = std::graph::afforest_connected_components(g, component);
+    benchmark::DoNotOptimize(component.data());
+  }
+  state.counters["components"] = static_cast<double>(components);
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_strongly_connected_components(benchmark::State& state) {
+  auto&&                g = bench_graph<G>(state);
+  std::vector<uint32_t> component(std::ranges::size(vertices(g)));
+  size_t                components = 0;
+  for (auto _ : state) {
+    components = std::graph::strongly_connected_components(g, component);
+    benchmark::DoNotOptimize(component.data());
+  }
+  state.counters["components"] = static_cast<double>(components);
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_parallel_strongly_connected_components(benchmark::State& state) {
+  auto&&                g  = bench_graph<G>(state);
+  auto&&                gt = bench_transpose<G>(state);
+  std::vector<uint32_t> component(std::ranges::size(vertices(g)));
+  size_t                components = 0;
+  for (auto _ : state) {
+    components = std::graph::strongly_connected_components(g, gt, component);
+    benchmark::DoNotOptimize(component.data());
+  }
+  state.counters["components"] = static_cast<double>(components);
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_biconnected_components(benchmark::State& state) {
+  auto&&                                  g = bench_graph<G>(state);
+  std::vector<std::vector<vertex_id_t<G>>> components;
+  for (auto _ : state) {
+    components.clear();
+    std::graph::biconnected_components(g, components);
+    benchmark::DoNotOptimize(components.data());
+  }
+  state.counters["components"] = static_cast<double>(components.size());
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_articulation_points(benchmark::State& state) {
+  auto&&                      g = bench_graph<G>(state);
+  std::vector<vertex_id_t<G>> cut;
+  for (auto _ : state) {
+    cut.clear();
+    std::graph::articulation_points(g, std::back_inserter(cut));
+    benchmark::DoNotOptimize(cut.data());
+  }
+  state.counters["articulation_points"] = static_cast<double>(cut.size());
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_kruskal_minimum_spanning_tree(benchmark::State& state) {
+  auto&& g          = bench_graph<G>(state);
+  auto   weight     = [&g](edge_reference_t<G> uv) { return std::graph::edge_value(g, uv); };
+  size_t tree_edges = 0;
+  for (auto _ : state) {
+    tree_edges = 0;
+    benchmark::DoNotOptimize(
+          std::graph::kruskal_minimum_spanning_tree(g, weight, counting_output_iterator{&tree_edges}));
+  }
+  state.counters["tree_edges"] = static_cast<double>(tree_edges);
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_prim_minimum_spanning_tree(benchmark::State& state) {
+  auto&&                      g      = bench_graph<G>(state);
+  const size_t                n      = std::ranges::size(vertices(g));
+  auto                        weight = [&g](edge_reference_t<G> uv) { return std::graph::edge_value(g, uv); };
+  std::vector<vertex_id_t<G>> predecessor(n);
+  std::vector<int>            tree_weight(n);
+  for (auto _ : state) {
+    std::graph::prim_minimum_spanning_tree(g, predecessor, tree_weight, weight);
+    benchmark::DoNotOptimize(predecessor.data());
+  }
+  set_graph_counters(state, g, n);
+}
+
+template <class G>
+static void BM_label_propagation(benchmark::State& state) {
+  auto&&                      g = bench_graph<G>(state);
+  const size_t                n = std::ranges::size(vertices(g));
+  std::vector<vertex_id_t<G>> labels(n);
+  size_t                      iterations = 0;
+  for (auto _ : state) {
+    iterations = std::graph::label_propagation(g, labels);
+    benchmark::DoNotOptimize(labels.data());
+  }
+  state.counters["iterations"] = static_cast<double>(iterations);
+  set_graph_counters(state, g, n);
+}
+
+GRAPH_BENCHMARK_CONTAINERS(BM_dijkstra_shortest_paths, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_maximal_independent_set, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_dfs_transitive_closure, small_graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_triangle_count, symmetric_graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_page_rank, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_connected_components, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_afforest_connected_components, symmetric_graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_strongly_connected_components, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_parallel_strongly_connected_components, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_biconnected_components, symmetric_graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_articulation_points, symmetric_graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_kruskal_minimum_spanning_tree, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_prim_minimum_spanning_tree, symmetric_graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_label_propagation, symmetric_graph_args);
@@ -0,0 +1,122 @@
+#pragma once
+
+// The graph containers used by the benchmarks and the cached graphs generated for them.
+//
+// Benchmarks that take graph_args() get two arguments: the generator kind (generator_kind) and log10 of the
+// number of edges, in [4,7]. The graph for the arguments is built before timing starts and is kept until a
+// benchmark asks for a different one, so only one graph of each container type is held at a time.
+
+#include <benchmark/benchmark.h>
+#include "graph_generators.hpp"
+#include "graph/graph.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include <memory>
+#include <string>
+#include <utility>
+#include <cstdint>
+
+namespace graph_benchmark {
+
+using csr_graph_type  = std::graph::container::csr_graph<int, void, void>;
+using vofl_graph_type = std::graph::container::dynamic_adjacency_graph<std::graph::container::vofl_graph_traits<int>>;
+using vol_graph_type  = std::graph::container::dynamic_adjacency_graph<std::graph::container::vol_graph_traits<int>>;
+using vov_graph_type  = std::graph::container::dynamic_adjacency_graph<std::graph::container::vov_graph_traits<int>>;
+
+// The edges for a generator kind and log10 of the number of edges.
+inline const edge_list_type& bench_edges(int64_t kind, int64_t log10_edges) {
+  static std::pair<int64_t, int64_t> key(-1, -1);
+  static edge_list_type              edges;
+  if (key != std::pair(kind, log10_edges)) {
+    edges = generate_edges(kind, static_cast<size_t>(std::pow(10.0, static_cast<double>(log10_edges))));
+    key   = {kind, log10_edges};
+  }
+  return edges;
+}
+
+// The graph of type G for a benchmark's arguments, with counters for its size. Items processed are edges.
+template <class G>
+G& bench_graph(benchmark::State& state) {
+  static std::pair<int64_t, int64_t> key(-1, -1);
+  static std::unique_ptr<G>          g;
+  if (key != std::pair(state.range(0), state.range(1))) {
+    g.reset();
+    const edge_list_type& edge_list = bench_edges(state.range(0), state.range(1));
+    g                               = std::make_unique<G>();
+    g->load_edges(edge_list, std::identity(), vertex_count(edge_list));
+    key = {state.range(0), state.range(1)};
+  }
+  state.SetLabel(generator_name(state.range(0)));
+  return *g;
+}
+
+// The transpose of bench_graph<G>(state), with an edge (v,u) for each edge (u,v), for algorithms that take a
+// transpose graph. The rmat and grid graphs are symmetric, but the erdos_renyi graphs are directed.
+template <class G>
+G& bench_transpose(benchmark::State& state) {
+  static std::pair<int64_t, int64_t> key(-1, -1);
+  static std::unique_ptr<G>          gt;
+  if (key != std::pair(state.range(0), state.range(1))) {
+    gt.reset();
+    edge_list_type edge_list = bench_edges(state.range(0), state.range(1));
+    for (auto&& uv : edge_list)
+      std::swap(uv.source_id, uv.target_id);
+    normalize_edges(edge_list);
+    gt = std::make_unique<G>();
+    gt->load_edges(edge_list, std::identity(), vertex_count(edge_list));
+    key = {state.range(0), state.range(1)};
+  }
+  return *gt;
+}
+
+// Set the counters after the timing loop. work is the number of edges (or vertices) processed per iteration.
+template <class G>
+void set_graph_counters(benchmark::State& state, G&& g, size_t work) {
+  size_t edge_count = 0;
+  for (auto&& u : std::graph::vertices(g))
+    edge_count += static_cast<size_t>(std::ranges::distance(std::graph::edges(g, u)));
+  state.counters["vertices"] = static_cast<double>(std::ranges::size(std::graph::vertices(g)));
+  state.counters["edges"]    = static_cast<double>(edge_count);
+  state.SetItemsProcessed(static_cast<int64_t>(work) * state.iterations());
+}
+
+// The vertex with the most edges, so searches from it reach the largest component.
+template <class G>
+std::graph::vertex_id_t<G> max_degree_vertex(G&& g) {
+  std::graph::vertex_id_t<G> seed = 0;
+  size_t                     most = 0;
+  for (std::graph::vertex_id_t<G> uid = 0; uid < std::ranges::size(std::graph::vertices(g)); ++uid) {
+    auto degree = static_cast<size_t>(std::ranges::distance(std::graph::edges(g, uid)));
+    if (degree > most) {
+      most = degree;
+      seed = uid;
+    }
+  }
+  return seed;
+}
+
+inline void graph_args(benchmark::internal::Benchmark* b) {
+  b->ArgsProduct({{rmat, grid, erdos_renyi}, {4, 5, 6, 7}})->ArgNames({"gen", "log10_edges"});
+  b->Unit(benchmark::kMillisecond);
+}
+
+// The symmetric (undirected) graphs only, for algorithms that require them
+inline void symmetric_graph_args(benchmark::internal::Benchmark* b) {
+  b->ArgsProduct({{rmat, grid}, {4, 5, 6, 7}})->ArgNames({"gen", "log10_edges"});
+  b->Unit(benchmark::kMillisecond);
+}
+
+// Smaller graphs, for algorithms with super-linear cost or output
+inline void small_graph_args(benchmark::internal::Benchmark* b) {
+  b->ArgsProduct({{rmat, grid, erdos_renyi}, {4, 5}})->ArgNames({"gen", "log10_edges"});
+  b->Unit(benchmark::kMillisecond);
+}
+
+} // namespace graph_benchmark
+
+// Register a benchmark template for each of the graph containers
+#define GRAPH_BENCHMARK_CONTAINERS(fn, args)                                                                           \
+  BENCHMARK_TEMPLATE(fn, graph_benchmark::csr_graph_type)->Apply(args);                                               \
+  BENCHMARK_TEMPLATE(fn, graph_benchmark::vofl_graph_type)->Apply(args);                                              \
+  BENCHMARK_TEMPLATE(fn, graph_benchmark::vol_graph_type)->Apply(args);                                               \
+  BENCHMARK_TEMPLATE(fn, graph_benchmark::vov_graph_type)->Apply(args)
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include "graph_generators.hpp"
+#include "graph/graph.hpp"
+#include "graph/views/breadth_first_search.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/ring_queue.hpp"
+#include <queue>
+#include <map>
+
+using std::graph::vertex_id_t;
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::vertices_breadth_first_search_view;
+using std::graph::edges_breadth_first_search_view;
+
+using namespace graph_benchmark;
+
+using bench_csr_graph_type = std::graph::container::csr_graph<int, void, void>;
+
+// The benchmark graphs, by argument: 0 is data/karate.mtx, otherwise it's the R-MAT scale.
+static bench_csr_graph_type& bfs_graph(int64_t arg) {
+  static std::map<int64_t, bench_csr_graph_type> graphs;
+  auto                                           it = graphs.find(arg);
+  if (it == graphs.end()) {
+    edge_list_type       edge_list = (arg == 0) ? mtx_edges(BENCHMARK_DATA_ROOT_DIR "karate.mtx")
+                                                : rmat_edges(static_cast<uint32_t>(arg));
+    bench_csr_graph_type g;
+    g.load_edges(edge_list, std::identity(), vertex_count(edge_list));
+    it = graphs.emplace(arg, std::move(g)).first;
+  }
+  return it->second;
+}
+
+// The seed is the vertex with the most edges so the search reaches the giant component.
+static vertex_id_t<bench_csr_graph_type> bfs_seed(const bench_csr_graph_type& g) {
+  vertex_id_t<bench_csr_graph_type> seed = 0;
+  size_t                            most = 0;
+  for (vertex_id_t<bench_csr_graph_type> uid = 0; uid < size(vertices(g)); ++uid) {
+    if (size(edges(g, uid)) > most) {
+      most = size(edges(g, uid));
+      seed = uid;
+    }
+  }
+  return seed;
+}
+
+static void set_bfs_label(benchmark::State& state, const bench_csr_graph_type& g, size_t visited) {
+  size_t edge_count = 0;
+  for (vertex_id_t<bench_csr_graph_type> uid = 0; uid < size(vertices(g)); ++uid)
+    edge_count += size(edges(g, uid));
+  state.SetLabel(state.range(0) == 0 ? "karate" : "rmat" + std::to_string(state.range(0)));
+  state.counters["vertices"] = static_cast<double>(size(vertices(g)));
+  state.counters["edges"]    = static_cast<double>(edge_count);
+  state.counters["visited"]  = static_cast<double>(visited);
+}
+
+template <class Queue>
+static void BM_vertices_bfs(benchmark::State& state) {
+  auto&& g       = bfs_graph(state.range(0));
+  auto   seed    = bfs_seed(g);
+  size_t visited = 0;
+  for (auto _ : state) {
+    visited = 0;
+    for (auto&& [vid, v] : vertices_breadth_first_search_view<bench_csr_graph_type, void, Queue>(g, seed)) {
+      benchmark::DoNotOptimize(vid);
+      ++visited;
+    }
+  }
+  set_bfs_label(state, g, visited);
+}
+
+template <class Queue>
+static void BM_edges_bfs(benchmark::State& state) {
+  auto&& g       = bfs_graph(state.range(0));
+  auto   seed    = bfs_seed(g);
+  size_t visited = 0;
+  for (auto _ : state) {
+    visited = 0;
+    for (auto&& [vid, uv] : edges_breadth_first_search_view<bench_csr_graph_type, void, false, Queue>(g, seed)) {
+      benchmark::DoNotOptimize(vid);
+      ++visited;
+    }
+  }
+  set_bfs_label(state, g, visited);
+}
+
+using ring_queue_type  = std::graph::container::ring_queue<vertex_id_t<bench_csr_graph_type>>;
+using deque_queue_type = std::queue<vertex_id_t<bench_csr_graph_type>>;
+
+// 0 = karate; 16, 18, 20 = R-MAT scale
+#define BFS_GRAPHS ->Arg(0)->Arg(16)->Arg(18)->Arg(20)->Unit(benchmark::kMicrosecond)
+
+BENCHMARK_TEMPLATE(BM_vertices_bfs, ring_queue_type) BFS_GRAPHS;
+BENCHMARK_TEMPLATE(BM_vertices_bfs, deque_queue_type) BFS_GRAPHS;
+BENCHMARK_TEMPLATE(BM_edges_bfs, ring_queue_type) BFS_GRAPHS;
+BENCHMARK_TEMPLATE(BM_edges_bfs, deque_queue_type) BFS_GRAPHS;
@@ -0,0 +1,111 @@
+#include "bench_graphs.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace graph_benchmark;
+
+// The edges for the benchmark's arguments in random order
+static const edge_list_type& shuffled_edges(benchmark::State& state) {
+  static std::pair<int64_t, int64_t> key(-1, -1);
+  static edge_list_type              edges;
+  if (key != std::pair(state.range(0), state.range(1))) {
+    edges = bench_edges(state.range(0), state.range(1));
+    std::ranges::shuffle(edges, std::mt19937(42));
+    key = {state.range(0), state.range(1)};
+  }
+  state.SetLabel(generator_name(state.range(0)));
+  return edges;
+}
+
+// Sort the edges by source_id so they can be passed to load_edges()
+static void BM_csr_sort_load_edges(benchmark::State& state) {
+  const edge_list_type& edge_list = shuffled_edges(state);
+  const size_t          n         = vertex_count(edge_list);
+  for (auto _ : state) {
+    edge_list_type sorted = edge_list;
+    std::ranges::sort(sorted, {}, &edge_type::source_id);
+    csr_graph_type g;
+    g.load_edges(sorted, std::identity(), n);
+    benchmark::DoNotOptimize(g);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(edge_list.size()) * state.iterations());
+}
+
+static void BM_csr_load_unsorted_edges(benchmark::State& state) {
+  const edge_list_type& edge_list = shuffled_edges(state);
+  const size_t          n         = vertex_count(edge_list);
+  for (auto _ : state) {
+    csr_graph_type g;
+    g.load_unsorted_edges(edge_list, std::identity(), n);
+    benchmark::DoNotOptimize(g);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(edge_list.size()) * state.iterations());
+}
+
+// sort_rows() after load_unsorted_edges(), for the rows in random order
+static void BM_csr_sort_rows(benchmark::State& state) {
+  const edge_list_type& edge_list = shuffled_edges(state);
+  const size_t          n         = vertex_count(edge_list);
+  for (auto _ : state) {
+    state.PauseTiming();
+    csr_graph_type g;
+    g.load_unsorted_edges(edge_list, std::identity(), n);
+    state.ResumeTiming();
+    g.sort_rows();
+    benchmark::DoNotOptimize(g);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(edge_list.size()) * state.iterations());
+}
+
+// The transpose of the graph, for the incoming edges
+static void BM_csr_transpose(benchmark::State& state) {
+  const edge_list_type& edge_list = bench_edges(state.range(0), state.range(1));
+  csr_graph_type        g;
+  g.load_edges(edge_list, std::identity(), vertex_count(edge_list));
+  for (auto _ : state) {
+    csr_graph_type gt = g.transpose();
+    benchmark::DoNotOptimize(gt);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(edge_list.size()) * state.iterations());
+}
+
+BENCHMARK(BM_csr_sort_load_edges)->Apply(graph_args);
+BENCHMARK(BM_csr_load_unsorted_edges)->Apply(graph_args);
+BENCHMARK(BM_csr_sort_rows)->Apply(graph_args);
+BENCHMARK(BM_csr_transpose)->Apply(graph_args);
+
+// contains_edge(g,uid,vid) for the vertex with the most edges, for the targets of its edges and as many
+// random vertices (mostly absent), without and with index_edges().
+static void BM_csr_contains_edge(benchmark::State& state) {
+  const edge_list_type& edge_list = bench_edges(state.range(0), state.range(1));
+  const size_t          n         = vertex_count(edge_list);
+  csr_graph_type        g;
+  g.load_edges(edge_list, std::identity(), n);
+  if (state.range(2))
+    g.index_edges();
+
+  const uint32_t                          uid = max_degree_vertex(g);
+  std::vector<uint32_t>                   targets;
+  std::mt19937                            rng(42);
+  std::uniform_int_distribution<uint32_t> vid_dist(0, static_cast<uint32_t>(n - 1));
+  for (auto&& uv : std::graph::edges(g, uid)) {
+    targets.push_back(std::graph::target_id(g, uv));
+    targets.push_back(vid_dist(rng));
+  }
+
+  for (auto _ : state) {
+    size_t found = 0;
+    for (auto vid : targets)
+      found += std::graph::contains_edge(g, uid, vid);
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetLabel(generator_name(state.range(0)));
+  state.counters["degree"] = static_cast<double>(targets.size() / 2);
+  state.SetItemsProcessed(static_cast<int64_t>(targets.size()) * state.iterations());
+}
+
+BENCHMARK(BM_csr_contains_edge)
+      ->ArgsProduct({{rmat}, {5, 6, 7}, {0, 1}})
+      ->ArgNames({"gen", "log10_edges", "indexed"})
+      ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,179 @@
+#pragma once
+
+// Synthetic graph generators used by the benchmarks.
+// Each generator returns an edge list, sorted by source_id, that can be loaded into any of the graph containers.
+
+#include "graph/graph.hpp"
+#include "graph/views/views_utility.hpp"
+#include "graph/io/matrix_market.hpp"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <stdexcept>
+#include <cmath>
+
+namespace graph_benchmark {
+
+using vertex_id_type = uint32_t;
+using edge_type      = std::graph::copyable_edge_t<vertex_id_type, int>; // {source_id, target_id, value}
+using edge_list_type = std::vector<edge_type>;
+
+// Sort by source_id, then target_id, and remove duplicate edges and self-loops.
+inline void normalize_edges(edge_list_type& edges) {
+  std::erase_if(edges, [](const edge_type& uv) { return uv.source_id == uv.target_id; });
+  std::ranges::sort(edges, [](const edge_type& lhs, const edge_type& rhs) {
+    return std::tie(lhs.source_id, lhs.target_id) < std::tie(rhs.source_id, rhs.target_id);
+  });
+  auto dups = std::ranges::unique(edges, [](const edge_type& lhs, const edge_type& rhs) {
+    return lhs.source_id == rhs.source_id && lhs.target_id == rhs.target_id;
+  });
+  edges.erase(dups.begin(), dups.end());
+}
+
+// Add the reverse of each edge so the graph is symmetric (undirected).
+inline void symmetrize_edges(edge_list_type& edges) {
+  const size_t n = edges.size();
+  edges.reserve(2 * n);
+  for (size_t i = 0; i < n; ++i)
+    edges.push_back({edges[i].target_id, edges[i].source_id, edges[i].value});
+  normalize_edges(edges);
+}
+
+// R-MAT (Chakrabarti, Zhan & Faloutsos) with 2^scale vertices and edge_factor * 2^scale edges before
+// duplicates and self-loops are removed. The default a,b,c are those of the Graph500 Kronecker generator
+// and give the skewed degree distribution and small diameter of social networks. Values are in [1,255].
+inline edge_list_type rmat_edges(uint32_t     scale,
+                                 uint32_t     edge_factor = 16,
+                                 bool         symmetric   = true,
+                                 unsigned int seed        = 42,
+                                 double       a           = 0.57,
+                                 double       b           = 0.19,
+                                 double       c           = 0.19) {
+  std::mt19937_64                        rng(seed);
+  std::uniform_real_distribution<double> unif(0.0, 1.0);
+  const size_t                           edge_count = size_t(edge_factor) << scale;
+
+  edge_list_type edges;
+  edges.reserve(symmetric ? 2 * edge_count : edge_count);
+  for (size_t i = 0; i < edge_count; ++i) {
+    vertex_id_type uid = 0, vid = 0;
+    for (uint32_t bit = 0; bit < scale; ++bit) {
+      const double r = unif(rng);
+      if (r < a) {
+      } else if (r < a + b) {
+        vid |= vertex_id_type(1) << bit;
+      } else if (r < a + b + c) {
+        uid |= vertex_id_type(1) << bit;
+      } else {
+        uid |= vertex_id_type(1) << bit;
+        vid |= vertex_id_type(1) << bit;
+      }
+    }
+    edges.push_back({uid, vid, static_cast<int>(1 + rng() % 255)});
+  }
+  // permute the ids so high-degree vertices aren't clustered at low ids
+  std::vector<vertex_id_type> perm(size_t(1) << scale);
+  for (vertex_id_type uid = 0; uid < perm.size(); ++uid)
+    perm[uid] = uid;
+  std::ranges::shuffle(perm, rng);
+  for (auto&& uv : edges) {
+    uv.source_id = perm[uv.source_id];
+    uv.target_id = perm[uv.target_id];
+  }
+  if (symmetric)
+    symmetrize_edges(edges);
+  else
+    normalize_edges(edges);
+  return edges;
+}
+
+// A rows x cols grid with edges in both directions between horizontal and vertical neighbors, giving a
+// large-diameter graph with uniform degree (e.g. a road network). Values are in [1,255].
+inline edge_list_type grid_edges(uint32_t rows, uint32_t cols, unsigned int seed = 42) {
+  std::mt19937   rng(seed);
+  edge_list_type edges;
+  edges.reserve(4 * size_t(rows) * cols);
+  auto add = [&](vertex_id_type uid, vertex_id_type vid) {
+    edges.push_back({uid, vid, static_cast<int>(1 + rng() % 255)});
+  };
+  for (uint32_t r = 0; r < rows; ++r) {
+    for (uint32_t c = 0; c < cols; ++c) {
+      const vertex_id_type uid = r * cols + c;
+      if (r > 0)
+        add(uid, uid - cols);
+      if (c > 0)
+        add(uid, uid - 1);
+      if (c + 1 < cols)
+        add(uid, uid + 1);
+      if (r + 1 < rows)
+        add(uid, uid + cols);
+    }
+  }
+  return edges; // already ordered by source_id, target_id
+}
+
+// Erdos-Renyi G(n,m): edge_count directed edges between uniformly random vertices, before duplicates and
+// self-loops are removed. Values are in [1,255].
+inline edge_list_type erdos_renyi_edges(uint32_t vertex_count, size_t edge_count, unsigned int seed = 42) {
+  std::mt19937_64                         rng(seed);
+  std::uniform_int_distribution<uint32_t> any(0, vertex_count - 1);
+  edge_list_type                          edges;
+  edges.reserve(edge_count);
+  for (size_t i = 0; i < edge_count; ++i)
+    edges.push_back({any(rng), any(rng), static_cast<int>(1 + rng() % 255)});
+  normalize_edges(edges);
+  return edges;
+}
+
+enum generator_kind : int64_t { rmat = 0, grid = 1, erdos_renyi = 2 };
+
+inline const char* generator_name(int64_t kind) {
+  switch (kind) {
+  case rmat: return "rmat";
+  case grid: return "grid";
+  case erdos_renyi: return "erdos_renyi";
+  }
+  return "unknown";
+}
+
+// Generate a graph of the given kind with about edge_count edges. All have an average degree of 4 to 16.
+inline edge_list_type generate_edges(int64_t kind, size_t edge_count) {
+  switch (kind) {
+  case rmat: { // 2^scale vertices with 8 undirected (16 directed) edges each
+    uint32_t scale = 1;
+    while ((size_t(16) << (scale + 1)) <= edge_count)
+      ++scale;
+    return rmat_edges(scale, 8, true);
+  }
+  case grid: {
+    const auto side = static_cast<uint32_t>(std::max(2.0, std::sqrt(static_cast<double>(edge_count) / 4.0)));
+    return grid_edges(side, side);
+  }
+  case erdos_renyi: return erdos_renyi_edges(static_cast<uint32_t>(std::max(size_t(2), edge_count / 8)), edge_count);
+  }
+  throw std::invalid_argument("unknown generator kind");
+}
+
+// Read the edges of a MatrixMarket coordinate file (e.g. data/karate.mtx). Ids are converted to 0-based.
+// Symmetric matrices get both directions. Pattern matrices get a value of 1.
+inline edge_list_type mtx_edges(const std::string& path) {
+  std::graph::io::mtx_reader<vertex_id_type, int> mtx(path);
+  edge_list_type                                  edges;
+  edges.reserve(mtx.max_edge_count());
+  std::ranges::copy(mtx, std::back_inserter(edges));
+  normalize_edges(edges);
+  return edges;
+}
+
+// The number of vertices referenced by a list of edges.
+inline size_t vertex_count(const edge_list_type& edges) {
+  vertex_id_type n = 0;
+  for (auto&& uv : edges)
+    n = std::max(n, std::max(uv.source_id, uv.target_id) + 1);
+  return n;
+}
+
+} // namespace graph_benchmark
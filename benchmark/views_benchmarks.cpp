@@ -0,0 +1,105 @@
+#include "bench_graphs.hpp"
+#include "graph/views/vertexlist.hpp"
+#include "graph/views/incidence.hpp"
+#include "graph/views/neighbors.hpp"
+#include "graph/views/edgelist.hpp"
+#include "graph/views/breadth_first_search.hpp"
+#include "graph/views/depth_first_search.hpp"
+
+using std::graph::vertex_id_t;
+using std::graph::vertices;
+
+using namespace graph_benchmark;
+
+template <class G>
+static void BM_vertexlist(benchmark::State& state) {
+  auto&& g = bench_graph<G>(state);
+  for (auto _ : state) {
+    for (auto&& [uid, u] : std::graph::views::vertexlist(g))
+      benchmark::DoNotOptimize(uid);
+  }
+  set_graph_counters(state, g, std::ranges::size(vertices(g)));
+}
+
+template <class G>
+static void BM_incidence(benchmark::State& state) {
+  auto&& g          = bench_graph<G>(state);
+  size_t edge_count = 0;
+  for (auto _ : state) {
+    edge_count = 0;
+    for (vertex_id_t<G> uid = 0; uid < std::ranges::size(vertices(g)); ++uid) {
+      for (auto&& [vid, uv] : std::graph::views::incidence(g, uid)) {
+        benchmark::DoNotOptimize(vid);
+        ++edge_count;
+      }
+    }
+  }
+  set_graph_counters(state, g, edge_count);
+}
+
+template <class G>
+static void BM_neighbors(benchmark::State& state) {
+  auto&& g          = bench_graph<G>(state);
+  size_t edge_count = 0;
+  for (auto _ : state) {
+    edge_count = 0;
+    for (vertex_id_t<G> uid = 0; uid < std::ranges::size(vertices(g)); ++uid) {
+      for (auto&& [vid, v] : std::graph::views::neighbors(g, uid)) {
+        benchmark::DoNotOptimize(vid);
+        ++edge_count;
+      }
+    }
+  }
+  set_graph_counters(state, g, edge_count);
+}
+
+template <class G>
+static void BM_edgelist(benchmark::State& state) {
+  auto&& g          = bench_graph<G>(state);
+  size_t edge_count = 0;
+  for (auto _ : state) {
+    edge_count = 0;
+    for (auto&& [uid, vid, uv] : std::graph::views::edgelist(g)) {
+      benchmark::DoNotOptimize(vid);
+      ++edge_count;
+    }
+  }
+  set_graph_counters(state, g, edge_count);
+}
+
+template <class G>
+static void BM_breadth_first_search(benchmark::State& state) {
+  auto&& g       = bench_graph<G>(state);
+  auto   seed    = max_degree_vertex(g);
+  size_t visited = 0;
+  for (auto _ : state) {
+    visited = 0;
+    for (auto&& [vid, uv] : std::graph::views::edges_breadth_first_search(g, seed)) {
+      benchmark::DoNotOptimize(vid);
+      ++visited;
+    }
+  }
+  set_graph_counters(state, g, visited);
+}
+
+template <class G>
+static void BM_depth_first_search(benchmark::State& state) {
+  auto&& g       = bench_graph<G>(state);
+  auto   seed    = max_degree_vertex(g);
+  size_t visited = 0;
+  for (auto _ : state) {
+    visited = 0;
+    for (auto&& [vid, uv] : std::graph::views::edges_depth_first_search(g, seed)) {
+      benchmark::DoNotOptimize(vid);
+      ++visited;
+    }
+  }
+  set_graph_counters(state, g, visited);
+}
+
+GRAPH_BENCHMARK_CONTAINERS(BM_vertexlist, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_incidence, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_neighbors, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_edgelist, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_breadth_first_search, graph_args);
+GRAPH_BENCHMARK_CONTAINERS(BM_depth_first_search, graph_args);
@@ -0,0 +1,19 @@
+include(FetchContent)
+set(FETCHCONTENT_QUIET ON)
+
+# Use an installed google benchmark if there is one
+find_package(benchmark QUIET)
+if(NOT benchmark_FOUND)
+  message(STATUS "Cloning External Project: benchmark")
+
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+  FetchContent_Declare(
+      benchmark
+      GIT_REPOSITORY https://github.com/google/benchmark.git
+      GIT_TAG        v1.8.3
+  )
+  FetchContent_MakeAvailable(benchmark)
+endif()
@@ -0,0 +1,243 @@
+/**
+ * @file bfs_levels.hpp
+ *
+ * @brief Parallel, direction-optimizing breadth-first search that evaluates the level (hop count)
+ * of every vertex from a set of seed vertices.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/detail/parallel.hpp"
+#include <vector>
+#include <atomic>
+#include <limits>
+#include <bit>
+#include <cstdint>
+
+#ifndef GRAPH_BFS_LEVELS_HPP
+#  define GRAPH_BFS_LEVELS_HPP
+
+namespace std::graph {
+
+namespace _detail {
+  /**
+   * @brief The number of outgoing edges of a vertex.
+  */
+  template <adjacency_list G>
+  size_t out_degree(G&& g, vertex_id_t<G> uid) {
+    auto&& rng = edges(g, uid);
+    if constexpr (ranges::sized_range<decltype(rng)>)
+      return static_cast<size_t>(ranges::size(rng));
+    else
+      return static_cast<size_t>(ranges::distance(rng));
+  }
+
+  // Direction-optimizing BFS (Beamer, Asanovic & Patterson). gt is only used when BottomUp is true.
+  template <bool BottomUp, adjacency_list G, adjacency_list GT, ranges::input_range Seeds, ranges::random_access_range LevelRange>
+  void bfs_levels(G&& g, GT&& gt, const Seeds& seeds, LevelRange& level, size_t num_threads) {
+    using vertex_id_type = vertex_id_t<G>;
+    using level_type     = ranges::range_value_t<LevelRange>;
+    using id_list        = vector<vertex_id_type>;
+    using word_type      = uint64_t;
+
+    constexpr level_type unreached = numeric_limits<level_type>::max();
+    constexpr size_t     bits      = numeric_limits<word_type>::digits;
+    constexpr size_t     alpha     = 15;   // switch to bottom-up when frontier edges > unexplored edges / alpha
+    constexpr size_t     beta      = 18;   // switch to top-down when frontier vertices < |V| / beta
+    constexpr size_t     grain     = 1024; // vertices per chunk of work; a multiple of bits
+
+    const size_t V = ranges::size(vertices(g));
+    assert(size(level) >= V);
+    const size_t words = (V + bits - 1) / bits;
+
+    thread_team     team(num_threads);
+    vector<id_list> next(team.size());
+    vector<size_t>  thread_count(team.size());
+
+    team.for_each_chunk(V, grain * 16, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid)
+        level[uid] = unreached;
+    });
+
+    id_list frontier;
+    for (auto&& seed : seeds) {
+      const vertex_id_type uid = static_cast<vertex_id_type>(seed);
+      assert(static_cast<size_t>(uid) < V);
+      if (level[uid] != unreached)
+        continue;
+      level[uid] = 0;
+      frontier.push_back(uid);
+    }
+
+    // sums thread_count after a parallel region and resets it
+    auto sum_counts = [&thread_count]() {
+      size_t n = 0;
+      for (auto&& c : thread_count)
+        n += exchange(c, size_t(0));
+      return n;
+    };
+
+    size_t edges_to_check = 0; // edges of vertices that haven't been in the frontier (approximate)
+    size_t scout          = 0; // edges of the vertices in the frontier
+    for (auto&& uid : frontier)
+      scout += out_degree(g, uid);
+    if constexpr (BottomUp) {
+      team.for_each_chunk(V, grain * 16, [&](size_t tid, size_t first, size_t last) {
+        size_t n = 0;
+        for (size_t uid = first; uid < last; ++uid)
+          n += out_degree(g, static_cast<vertex_id_type>(uid));
+        thread_count[tid] += n;
+      });
+      edges_to_check = sum_counts();
+    }
+
+    // top-down: discover the unreached targets of the vertices in the frontier
+    auto top_down_step = [&](level_type depth) {
+      team.for_each_chunk(frontier.size(), 64, [&](size_t tid, size_t first, size_t last) {
+        size_t n = 0;
+        for (size_t i = first; i < last; ++i) {
+          for (auto&& uv : edges(g, frontier[i])) {
+            const vertex_id_type  vid   = static_cast<vertex_id_type>(target_id(g, uv));
+            atomic_ref<level_type> lv(level[vid]);
+            level_type             seen = lv.load(memory_order_relaxed);
+            if (seen == unreached && lv.compare_exchange_strong(seen, depth + 1, memory_order_relaxed)) {
+              next[tid].push_back(vid);
+              n += out_degree(g, vid);
+            }
+          }
+        }
+        thread_count[tid] += n;
+      });
+      gather(team, frontier, [&](size_t tid) -> id_list& { return next[tid]; });
+      return sum_counts();
+    };
+
+    vector<word_type> front, curr; // frontier bitmaps for bottom-up
+
+    // bottom-up: each unreached vertex looks for a source in the frontier
+    auto bottom_up_step = [&](level_type depth) {
+      ranges::fill(curr, word_type(0));
+      team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+        size_t n = 0; // chunks start on a word boundary, so curr's words are owned by one thread
+        for (size_t vid = first; vid < last; ++vid) {
+          if (level[vid] != unreached)
+            continue;
+          for (auto&& vu : edges(gt, static_cast<vertex_id_t<GT>>(vid))) {
+            const size_t uid = static_cast<size_t>(target_id(gt, vu));
+            if ((front[uid / bits] >> (uid % bits)) & 1u) {
+              level[vid] = depth + 1;
+              curr[vid / bits] |= word_type(1) << (vid % bits);
+              ++n;
+              break;
+            }
+          }
+        }
+        thread_count[tid] += n;
+      });
+      return sum_counts();
+    };
+
+    for (level_type depth = 0; !frontier.empty();) {
+      if (BottomUp && scout > edges_to_check / alpha) {
+        front.assign(words, word_type(0));
+        curr.assign(words, word_type(0));
+        for (auto&& uid : frontier)
+          front[static_cast<size_t>(uid) / bits] |= word_type(1) << (static_cast<size_t>(uid) % bits);
+        size_t awake = frontier.size(), old_awake;
+        do {
+          old_awake = awake;
+          awake     = bottom_up_step(depth++);
+          front.swap(curr);
+        } while (awake >= old_awake || awake > V / beta);
+
+        // back to a queue for top-down
+        team.for_each_chunk(words, grain / bits, [&](size_t tid, size_t first, size_t last) {
+          for (size_t w = first; w < last; ++w)
+            for (word_type ws = front[w]; ws; ws &= ws - 1)
+              next[tid].push_back(static_cast<vertex_id_type>(w * bits + static_cast<size_t>(countr_zero(ws))));
+        });
+        gather(team, frontier, [&](size_t tid) -> id_list& { return next[tid]; });
+        scout = 1;
+      } else {
+        edges_to_check -= min(edges_to_check, scout);
+        scout = top_down_step(depth++);
+      }
+    }
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Parallel breadth-first search that evaluates the level of all vertices reachable from a set of
+ * seed vertices, using top-down steps only.
+ *
+ * Each level is evaluated in parallel by expanding the vertices of the frontier across the threads.
+ * Use the overload with a transpose graph to switch to bottom-up steps for large frontiers.
+ *
+ * Complexity: O(|V| + |E|), with the work spread across the threads.
+ *
+ * @tparam G          The graph type.
+ * @tparam Seeds      The range type of seed vertex ids.
+ * @tparam LevelRange The level range type. Its values must be integral and usable with atomic_ref.
+ *
+ * @param g           The graph.
+ * @param seeds       The vertex ids to start from; their level is 0.
+ * @param level       [out] level[uid] is the number of edges on a shortest path from a seed to uid, or
+ *                    numeric_limits<range_value_t<LevelRange>>::max() if uid isn't reachable. The caller
+ *                    must assure size(level) >= size(vertices(g)).
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ */
+template <adjacency_list G, ranges::input_range Seeds, ranges::random_access_range LevelRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         convertible_to<ranges::range_value_t<Seeds>, vertex_id_t<G>> && integral<ranges::range_value_t<LevelRange>>
+void breadth_first_search_levels(G&& g, const Seeds& seeds, LevelRange& level, size_t num_threads = 0) {
+  _detail::bfs_levels<false>(g, g, seeds, level, num_threads);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Parallel, direction-optimizing breadth-first search that evaluates the level of all vertices
+ * reachable from a set of seed vertices.
+ *
+ * Small frontiers are expanded top-down: the edges of the vertices in the frontier are scanned for
+ * unreached vertices. When the edges of the frontier exceed a fraction of the unexplored edges, steps
+ * are made bottom-up instead: each unreached vertex scans its incoming edges for a vertex in the frontier,
+ * which is kept as a bitmap, and stops at the first one found. This avoids most of the edge checks of the
+ * large middle levels of low-diameter graphs (e.g. social networks). Top-down steps resume when the
+ * frontier becomes small again. Both kinds of steps run in parallel.
+ *
+ * Complexity: O(|V| + |E|), with the work spread across the threads.
+ *
+ * @tparam G          The graph type.
+ * @tparam GT         The transpose graph type.
+ * @tparam Seeds      The range type of seed vertex ids.
+ * @tparam LevelRange The level range type. Its values must be integral and usable with atomic_ref.
+ *
+ * @param g           The graph.
+ * @param gt          The transpose of g, with an edge (v,u) for each edge (u,v) in g, which gives the
+ *                    incoming edges for bottom-up steps. Pass g for undirected (symmetric) graphs.
+ * @param seeds       The vertex ids to start from; their level is 0.
+ * @param level       [out] level[uid] is the number of edges on a shortest path from a seed to uid, or
+ *                    numeric_limits<range_value_t<LevelRange>>::max() if uid isn't reachable. The caller
+ *                    must assure size(level) >= size(vertices(g)).
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ */
+template <adjacency_list G, adjacency_list GT, ranges::input_range Seeds, ranges::random_access_range LevelRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         ranges::random_access_range<vertex_range_t<GT>> && integral<vertex_id_t<GT>> &&
+         convertible_to<ranges::range_value_t<Seeds>, vertex_id_t<G>> && integral<ranges::range_value_t<LevelRange>>
+void breadth_first_search_levels(G&& g, GT&& gt, const Seeds& seeds, LevelRange& level, size_t num_threads = 0) {
+  assert(ranges::size(vertices(gt)) == ranges::size(vertices(g)));
+  _detail::bfs_levels<true>(g, gt, seeds, level, num_threads);
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_BFS_LEVELS_HPP
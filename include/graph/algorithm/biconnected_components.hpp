@@ -0,0 +1,170 @@
+/**
+ * @file biconnected_components.hpp
+ *
+ * @brief Biconnected components and articulation points of undirected graphs, using an iterative form of
+ * the Hopcroft-Tarjan algorithm.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/views/depth_first_search.hpp"
+#include <vector>
+#include <algorithm>
+
+#ifndef GRAPH_BICONNECTED_COMPONENTS_HPP
+#  define GRAPH_BICONNECTED_COMPONENTS_HPP
+
+namespace std::graph {
+
+namespace _detail {
+  // Hopcroft-Tarjan. disc[uid] is the discovery order of uid (from 1; 0 if not visited) and low[uid] is the
+  // smallest discovery order reachable from the DFS subtree of uid with one back edge. When the search
+  // returns from a child v to u and low[v] >= disc[u], u separates the subtree of v from the rest of the
+  // graph: the vertices of the subtree still on the vertex stack, plus u, are a biconnected component.
+  //
+  // component(first, last, uid) is called for each component, where [first,last) are the vertices of the
+  // subtree and uid is the separating vertex; or with first == last for an isolated vertex uid.
+  // cut(uid) is called for each articulation point, possibly more than once. The vertex stack is only kept
+  // when Components is true.
+  template <bool Components, adjacency_list G, class ComponentFn, class CutFn>
+  void hopcroft_tarjan(G&& g, ComponentFn&& component, CutFn&& cut) {
+    using vertex_id_type = vertex_id_t<G>;
+
+    const size_t           V = ranges::size(vertices(g));
+    vector<vertex_id_type> disc(V, 0);
+    vector<vertex_id_type> low(V, 0);
+    vector<dfs_element<G>> dfs;     // the path from the seed
+    vector<vertex_id_type> pending; // visited vertices that aren't in a component yet
+    vertex_id_type         time = 0;
+
+    auto visit = [&](vertex_id_type uid) {
+      disc[uid] = low[uid] = ++time;
+      dfs.push_back({uid, ranges::begin(edges(g, uid))});
+      if constexpr (Components)
+        pending.push_back(uid);
+    };
+
+    for (size_t seed = 0; seed < V; ++seed) {
+      if (disc[seed] != 0)
+        continue;
+      visit(static_cast<vertex_id_type>(seed));
+      size_t seed_children = 0;
+      while (!dfs.empty()) {
+        auto& [uid, uv] = dfs.back();
+        if (uv != ranges::end(edges(g, uid))) {
+          const vertex_id_type vid = static_cast<vertex_id_type>(target_id(g, *uv));
+          ++uv;
+          if (disc[vid] == 0)
+            visit(vid); // invalidates uid & uv
+          else if (dfs.size() < 2 || vid != dfs[dfs.size() - 2].u_id) // not the edge back to the parent
+            low[uid] = min(low[uid], disc[vid]);
+          continue;
+        }
+
+        const vertex_id_type u = uid;
+        dfs.pop_back();
+        if (dfs.empty()) { // the seed
+          if constexpr (Components) {
+            pending.pop_back();
+            if (seed_children == 0)
+              component(pending.end(), pending.end(), u);
+          }
+          break;
+        }
+
+        const vertex_id_type p = dfs.back().u_id;
+        low[p]                 = min(low[p], low[u]);
+        if (low[u] >= disc[p]) {
+          if (dfs.size() > 1 || ++seed_children == 2)
+            cut(p); // the seed is an articulation point when it has more than one child
+          if constexpr (Components) {
+            auto first = prev(find(pending.rbegin(), pending.rend(), u).base()); // u and its subtree
+            component(first, pending.end(), p);
+            pending.erase(first, pending.end());
+          }
+        }
+      }
+    }
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the biconnected components of an undirected graph.
+ *
+ * A biconnected component is a maximal set of vertices that stays connected when any one of its vertices
+ * is removed. The components partition the edges; a vertex is in more than one component when it is an
+ * articulation point. An isolated vertex is a component by itself.
+ *
+ * This is the Hopcroft-Tarjan algorithm with the depth-first search kept in an explicit stack of
+ * dfs_element (vertex id and edge iterator) rather than by recursion, so the depth of the search is only
+ * limited by memory. The discovery order and low point of the vertices are kept in two arrays of vertex
+ * ids, and the vertices of the open components on a stack of vertex ids, which holds at most |V| vertices
+ * where a stack of edges can hold |E| edges.
+ *
+ * Complexity: O(|V| + |E|)
+ *
+ * @tparam G              The graph type.
+ * @tparam OuterContainer The container type of the components, such as vector<vector<vertex_id_t<G>>>.
+ *                        Its values are containers of vertex ids that can be constructed from an iterator
+ *                        range and have push_back().
+ *
+ * @param g          The graph. It must be undirected: each edge is stored in both directions.
+ * @param components [out] The vertex ids of each component are appended, as a container per component.
+ *                   The order of the components and of the vertices in a component is unspecified.
+ */
+template <adjacency_list G, class OuterContainer>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         convertible_to<vertex_id_t<G>, ranges::range_value_t<ranges::range_value_t<OuterContainer>>>
+void biconnected_components(G&& g, OuterContainer& components) {
+  using inner_type = ranges::range_value_t<OuterContainer>;
+  _detail::hopcroft_tarjan<true>(
+        g,
+        [&components](auto first, auto last, vertex_id_t<G> uid) {
+          inner_type& component = components.emplace_back(first, last);
+          component.push_back(uid);
+        },
+        [](vertex_id_t<G>) {});
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the articulation points (cut vertices) of an undirected graph.
+ *
+ * An articulation point is a vertex whose removal increases the number of connected components. They are
+ * found with the same iterative Hopcroft-Tarjan search as biconnected_components(), without keeping the
+ * vertices of the components.
+ *
+ * Complexity: O(|V| + |E|)
+ *
+ * @tparam G       The graph type.
+ * @tparam OutIter The output iterator type that receives vertex ids.
+ *
+ * @param g            The graph. It must be undirected: each edge is stored in both directions.
+ * @param cut_vertices The output iterator that receives the id of each articulation point once, in
+ *                     increasing order.
+ */
+template <adjacency_list G, class OutIter>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         output_iterator<OutIter, vertex_id_t<G>>
+void articulation_points(G&& g, OutIter cut_vertices) {
+  using vertex_id_type = vertex_id_t<G>;
+  const size_t V       = ranges::size(vertices(g));
+  vector<bool> is_cut(V);
+  _detail::hopcroft_tarjan<false>(
+        g, [](auto, auto, vertex_id_type) {}, [&is_cut](vertex_id_type uid) { is_cut[uid] = true; });
+  for (size_t uid = 0; uid < V; ++uid)
+    if (is_cut[uid])
+      *cut_vertices++ = static_cast<vertex_id_type>(uid);
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_BICONNECTED_COMPONENTS_HPP
@@ -0,0 +1,291 @@
+/**
+ * @file connected_components.hpp
+ *
+ * @brief Parallel connected components with a lock-free union-find, including the Afforest variant
+ * that samples the edges to find the largest component first.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/detail/parallel.hpp"
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <random>
+#include <cassert>
+
+#ifndef GRAPH_CONNECTED_COMPONENTS_HPP
+#  define GRAPH_CONNECTED_COMPONENTS_HPP
+
+namespace std::graph {
+
+namespace _detail {
+  // The union-find is kept in the component range itself: component[x] is the parent of x, and x is a
+  // root when component[x] == x. A root is only linked to a smaller root, so the root of each set is its
+  // smallest id and the result doesn't depend on the order of the links. All accesses are atomic, so any
+  // number of threads can link concurrently.
+
+  // The root of x, halving the path to it: each vertex on the path is pointed to its grandparent
+  template <class T>
+  T uf_find(T* parent, T x) noexcept {
+    for (;;) {
+      T p  = atomic_ref<T>(parent[x]).load(memory_order_relaxed);
+      T gp = atomic_ref<T>(parent[p]).load(memory_order_relaxed);
+      if (p == gp)
+        return p;
+      atomic_ref<T>(parent[x]).compare_exchange_weak(p, gp, memory_order_relaxed);
+      x = gp;
+    }
+  }
+
+  // Merge the sets of x and y by linking the larger root to the smaller one
+  template <class T>
+  void uf_link(T* parent, T x, T y) noexcept {
+    for (;;) {
+      T rx = uf_find(parent, x);
+      T ry = uf_find(parent, y);
+      if (rx == ry)
+        return;
+      if (rx < ry)
+        swap(rx, ry);
+      T expected = rx; // rx may no longer be a root
+      if (atomic_ref<T>(parent[rx]).compare_exchange_strong(expected, ry, memory_order_relaxed))
+        return;
+      x = rx, y = ry;
+    }
+  }
+
+  // Point every vertex directly at its root and return the number of roots (components)
+  template <class T>
+  size_t uf_compress(T* parent, size_t n, thread_team& team) {
+    struct alignas(64) thread_count {
+      size_t n = 0;
+    };
+    vector<thread_count> roots(team.size());
+    team.for_each_chunk(n, 4096, [&](size_t tid, size_t first, size_t last) {
+      for (size_t x = first; x < last; ++x) {
+        const T root = uf_find(parent, static_cast<T>(x));
+        atomic_ref<T>(parent[x]).store(root, memory_order_relaxed);
+        roots[tid].n += (static_cast<size_t>(root) == x);
+      }
+    });
+    size_t count = 0;
+    for (auto&& r : roots)
+      count += r.n;
+    return count;
+  }
+
+  template <class T>
+  void uf_init(T* parent, size_t n, thread_team& team) {
+    team.for_each_chunk(n, 4096, [&](size_t, size_t first, size_t last) {
+      for (size_t x = first; x < last; ++x)
+        parent[x] = static_cast<T>(x);
+    });
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the connected components of a graph.
+ *
+ * The edges of the vertices are spread across the threads, and each edge merges the sets of its
+ * endpoints in a lock-free union-find (compare-and-swap on the parent ids, with path halving). Each
+ * set is then flattened, so component[uid] is the smallest vertex id in the component of uid.
+ *
+ * Every edge is used in the direction it's stored, so the components of a directed graph are its
+ * weakly connected components. afforest_connected_components() does less work on undirected graphs
+ * with a large component.
+ *
+ * Complexity: O(|V| + |E| α(|V|)) in practice, with the work spread across the threads.
+ *
+ * @tparam G              The graph type.
+ * @tparam ComponentRange The component range type. Its values must be integral, large enough for the
+ *                        vertex ids and usable with atomic_ref.
+ *
+ * @param g           The graph.
+ * @param component   [out] component[uid] is the smallest vertex id in the component of uid. The caller
+ *                    must assure size(component) >= size(vertices(g)).
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of components.
+ */
+template <adjacency_list G, ranges::contiguous_range ComponentRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         integral<ranges::range_value_t<ComponentRange>>
+size_t connected_components(G&& g, ComponentRange& component, size_t num_threads = 0) {
+  using vertex_id_type = vertex_id_t<G>;
+  using comp_type      = ranges::range_value_t<ComponentRange>;
+  const size_t V       = ranges::size(vertices(g));
+  assert(static_cast<size_t>(ranges::size(component)) >= V);
+  comp_type* parent = ranges::data(component);
+
+  _detail::thread_team team(num_threads);
+  _detail::uf_init(parent, V, team);
+  team.for_each_chunk(V, 1024, [&](size_t, size_t first, size_t last) {
+    for (size_t uid = first; uid < last; ++uid)
+      for (auto&& uv : edges(g, static_cast<vertex_id_type>(uid)))
+        _detail::uf_link(parent, static_cast<comp_type>(uid), static_cast<comp_type>(target_id(g, uv)));
+  });
+  return _detail::uf_compress(parent, V, team);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the connected components of an undirected graph with the Afforest algorithm
+ * (Sutton, Ben-Nun & Barak).
+ *
+ * The same union-find as connected_components() first links a few edges of each vertex, which is
+ * usually enough to connect most of the largest component. The largest component is then identified
+ * from a random sample of the vertices, and the remaining edges are only linked for the vertices
+ * outside of it, which skips most of the edges of graphs with a giant component (e.g. social networks
+ * and web graphs). An edge from the largest component to another vertex is still linked from the other
+ * end, which is why the graph must be undirected.
+ *
+ * Complexity: O(|V| + |E| α(|V|)) in the worst case, with the work spread across the threads.
+ *
+ * @tparam G              The graph type.
+ * @tparam ComponentRange The component range type. Its values must be integral, large enough for the
+ *                        vertex ids and usable with atomic_ref.
+ *
+ * @param g               The graph. It must be undirected: each edge is stored in both directions.
+ * @param component       [out] component[uid] is the smallest vertex id in the component of uid. The
+ *                        caller must assure size(component) >= size(vertices(g)).
+ * @param neighbor_rounds The number of edges of each vertex linked before the largest component is
+ *                        sampled.
+ * @param num_threads     The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of components.
+ */
+template <adjacency_list G, ranges::contiguous_range ComponentRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         integral<ranges::range_value_t<ComponentRange>>
+size_t afforest_connected_components(G&&             g,
+                                     ComponentRange& component,
+                                     size_t          neighbor_rounds = 2,
+                                     size_t          num_threads     = 0) {
+  using vertex_id_type     = vertex_id_t<G>;
+  using comp_type          = ranges::range_value_t<ComponentRange>;
+  constexpr size_t samples = 1024; // vertices sampled to find the largest component
+  const size_t     V       = ranges::size(vertices(g));
+  assert(static_cast<size_t>(ranges::size(component)) >= V);
+  comp_type* parent = ranges::data(component);
+
+  _detail::thread_team team(num_threads);
+  _detail::uf_init(parent, V, team);
+
+  // link the r'th edge of each vertex, flattening the sets after each round
+  for (size_t r = 0; r < neighbor_rounds; ++r) {
+    team.for_each_chunk(V, 1024, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid) {
+        auto&& rng = edges(g, static_cast<vertex_id_type>(uid));
+        auto   it  = ranges::next(ranges::begin(rng), static_cast<ptrdiff_t>(r), ranges::end(rng));
+        if (it != ranges::end(rng))
+          _detail::uf_link(parent, static_cast<comp_type>(uid), static_cast<comp_type>(target_id(g, *it)));
+      }
+    });
+    _detail::uf_compress(parent, V, team);
+  }
+  if (V == 0)
+    return 0;
+
+  // the most frequent component in a sample of the vertices
+  vector<comp_type>                sample(samples);
+  minstd_rand                      rng(42);
+  uniform_int_distribution<size_t> vid_dist(0, V - 1);
+  for (auto& c : sample)
+    c = parent[vid_dist(rng)];
+  ranges::sort(sample);
+  comp_type largest = sample[0];
+  size_t    most    = 0;
+  for (size_t i = 0, j = 0; i < samples; i = j) {
+    for (j = i + 1; j < samples && sample[j] == sample[i]; ++j)
+      ;
+    if (j - i > most) {
+      most    = j - i;
+      largest = sample[i];
+    }
+  }
+
+  // link the remaining edges of the vertices outside of the largest component
+  team.for_each_chunk(V, 1024, [&](size_t, size_t first, size_t last) {
+    for (size_t uid = first; uid < last; ++uid) {
+      if (atomic_ref<comp_type>(parent[uid]).load(memory_order_relaxed) == largest)
+        continue;
+      auto&& out_edges = edges(g, static_cast<vertex_id_type>(uid));
+      auto   it        = ranges::next(ranges::begin(out_edges), static_cast<ptrdiff_t>(neighbor_rounds),
+                                      ranges::end(out_edges));
+      for (; it != ranges::end(out_edges); ++it)
+        _detail::uf_link(parent, static_cast<comp_type>(uid), static_cast<comp_type>(target_id(g, *it)));
+    }
+  });
+  return _detail::uf_compress(parent, V, team);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the connected components of the graph given by a range of edges, such as
+ * a vector of copyable_edge_t<VId,EV>.
+ *
+ * Each edge merges the sets of its endpoints in the union-find used by connected_components(g, ...).
+ * The edges are spread across the threads when erng is a sized random_access_range; otherwise they're
+ * read once on the calling thread.
+ *
+ * Complexity: O(|V| + |E| α(|V|)) in practice.
+ *
+ * @tparam ERng           The edge range type.
+ * @tparam ComponentRange The component range type. Its values must be integral, large enough for the
+ *                        vertex ids and usable with atomic_ref.
+ * @tparam EProj          The edge projection type.
+ *
+ * @param erng        The edges. The number of vertices is size(component); the ids of the endpoints
+ *                    must be less than it.
+ * @param component   [out] component[uid] is the smallest vertex id in the component of uid.
+ * @param eprojection A function that returns a value with source_id and target_id members for an
+ *                    element of erng.
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of components.
+ */
+template <ranges::forward_range ERng, ranges::contiguous_range ComponentRange, class EProj = identity>
+requires(!adjacency_list<ERng>) && integral<ranges::range_value_t<ComponentRange>> &&
+        requires(EProj eproj, ranges::range_reference_t<ERng> e) {
+          eproj(e).source_id;
+          eproj(e).target_id;
+        }
+size_t connected_components(const ERng&     erng,
+                            ComponentRange& component,
+                            EProj           eprojection = {},
+                            size_t          num_threads = 0) {
+  using comp_type         = ranges::range_value_t<ComponentRange>;
+  constexpr bool parallel = ranges::random_access_range<ERng> && ranges::sized_range<ERng>;
+  const size_t   V        = static_cast<size_t>(ranges::size(component));
+  comp_type*     parent   = ranges::data(component);
+
+  auto link = [&](auto&& edge_data) {
+    auto&& uv = eprojection(edge_data);
+    assert(static_cast<size_t>(uv.source_id) < V && static_cast<size_t>(uv.target_id) < V);
+    _detail::uf_link(parent, static_cast<comp_type>(uv.source_id), static_cast<comp_type>(uv.target_id));
+  };
+
+  _detail::thread_team team(parallel ? num_threads : 1);
+  _detail::uf_init(parent, V, team);
+  if constexpr (parallel) {
+    auto first = ranges::begin(erng);
+    team.for_each_chunk(static_cast<size_t>(ranges::size(erng)), 16 * 1024, [&](size_t, size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i)
+        link(first[static_cast<ptrdiff_t>(i)]);
+    });
+  } else {
+    for (auto&& edge_data : erng)
+      link(edge_data);
+  }
+  return _detail::uf_compress(parent, V, team);
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_CONNECTED_COMPONENTS_HPP
@@ -0,0 +1,278 @@
+/**
+ * @file label_propagation.hpp
+ *
+ * @brief Parallel community detection by label propagation.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/detail/parallel.hpp"
+#include <vector>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+
+#ifndef GRAPH_LABEL_PROPAGATION_HPP
+#  define GRAPH_LABEL_PROPAGATION_HPP
+
+namespace std::graph {
+
+/**
+ * @ingroup graph_algorithms
+ * @brief How label_propagation() updates the labels in a sweep over the vertices.
+ *
+ * asynchronous: a new label is visible to the vertices that are visited after it in the same sweep. This
+ *               usually converges in fewer sweeps. The result depends on the order in which the threads
+ *               visit the vertices, so it's only repeatable with one thread.
+ * synchronous:  the new labels are found from the labels of the previous sweep, so the result doesn't depend
+ *               on the number of threads. It takes a copy of the labels for each sweep. Neighbors can swap
+ *               labels back and forth, such as the two vertices of an edge that outweighs their other
+ *               edges, so it may only stop at max_iterations.
+ */
+enum struct label_propagation_sweep : int8_t { asynchronous, synchronous };
+
+namespace _detail {
+  // The total weight of each label on the edges of one vertex, in an open addressing hash table with linear
+  // probing. The table is sized for the degree of the vertex, to at least twice the number of edges so it's
+  // never more than half full, and only the slots that were used are cleared for the next vertex.
+  template <integral L, class W>
+  class label_histogram {
+  public:
+    static constexpr L empty = numeric_limits<L>::max();
+
+    // Prepare for a vertex with degree edges
+    void reset(size_t degree) {
+      const size_t slots = bit_ceil(max(2 * degree, size_t(2)));
+      if (keys_.size() < slots) {
+        keys_.resize(slots, empty);
+        weights_.resize(slots);
+      }
+      mask_  = slots - 1;
+      shift_ = 64 - countr_zero(slots);
+    }
+
+    void add(L label, W weight) {
+      size_t i = static_cast<size_t>((static_cast<uint64_t>(label) * 0x9e3779b97f4a7c15ull) >> shift_);
+      for (; keys_[i] != label; i = (i + 1) & mask_) {
+        if (keys_[i] == empty) {
+          keys_[i]    = label;
+          weights_[i] = W();
+          used_.push_back(i);
+          break;
+        }
+      }
+      weights_[i] += weight;
+    }
+
+    // The label with the largest weight, or current when there are no labels. Ties keep current if it's
+    // one of them, so the labels don't oscillate between equal choices, or else take the label with the
+    // smallest hash of salt and the label, which acts as a random choice. Clears the table.
+    L best(L current, uint64_t salt) {
+      L        best_label  = current;
+      W        best_weight = W();
+      uint64_t best_rank   = 0;
+      for (size_t n = 0; n < used_.size(); ++n) {
+        const size_t i = used_[n];
+        const L      k = keys_[i];
+        const W      w = weights_[i];
+        keys_[i]       = empty;
+        if (n == 0 || w > best_weight) {
+          best_label  = k;
+          best_weight = w;
+          best_rank   = mix(salt ^ static_cast<uint64_t>(k));
+        } else if (w == best_weight && best_label != current) {
+          const uint64_t rank = mix(salt ^ static_cast<uint64_t>(k));
+          if (k == current || rank < best_rank) {
+            best_label = k;
+            best_rank  = rank;
+          }
+        }
+      }
+      used_.clear();
+      return best_label;
+    }
+
+    // The splitmix64 finalizer
+    static constexpr uint64_t mix(uint64_t x) noexcept {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+      return x ^ (x >> 31);
+    }
+
+  private:
+    vector<L>      keys_;
+    vector<W>      weights_;
+    vector<size_t> used_; // slots with a label
+    size_t         mask_  = 0;
+    int            shift_ = 64;
+  };
+
+  template <adjacency_list G, ranges::random_access_range LabelRange, class EVF>
+  size_t label_propagation(G&&                     g,
+                           LabelRange&             labels,
+                           EVF&                    weight_fn,
+                           size_t                  max_iterations,
+                           double                  tolerance,
+                           label_propagation_sweep sweep,
+                           size_t                  num_threads) {
+    using vertex_id_type = vertex_id_t<G>;
+    using label_type     = ranges::range_value_t<LabelRange>;
+    using weight_type    = remove_cvref_t<invoke_result_t<EVF, edge_reference_t<G>>>;
+    constexpr size_t grain = 1024; // vertices per chunk of work
+
+    const size_t V = ranges::size(vertices(g));
+    assert(static_cast<size_t>(ranges::size(labels)) >= V);
+    assert(V < static_cast<size_t>(label_histogram<label_type, weight_type>::empty));
+    const bool synchronous = sweep == label_propagation_sweep::synchronous;
+
+    // The histogram and the number of labels changed by each thread, on separate cache lines
+    struct alignas(64) thread_state {
+      label_histogram<label_type, weight_type> histogram;
+      size_t                                   changed = 0;
+    };
+    thread_team          team(num_threads);
+    vector<thread_state> state(team.size());
+    vector<label_type>   previous(synchronous ? V : 0); // the labels of the last sweep
+
+    team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid)
+        labels[uid] = static_cast<label_type>(uid);
+    });
+
+    // A label is read by other threads while it's written in an asynchronous sweep
+    auto label_of = [&](size_t uid) {
+      return synchronous ? previous[uid] : atomic_ref<label_type>(labels[uid]).load(memory_order_relaxed);
+    };
+
+    size_t iteration = 0;
+    while (iteration < max_iterations) {
+      ++iteration;
+      if (synchronous) {
+        team.for_each_chunk(V, 16 * grain, [&](size_t, size_t first, size_t last) {
+          for (size_t uid = first; uid < last; ++uid)
+            previous[uid] = labels[uid];
+        });
+      }
+
+      // each vertex takes the label with the largest weight on its edges
+      team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+        auto& histogram = state[tid].histogram;
+        for (size_t uid = first; uid < last; ++uid) {
+          auto&& out_edges = edges(g, static_cast<vertex_id_type>(uid));
+          histogram.reset(static_cast<size_t>(ranges::distance(out_edges)));
+          for (auto&& uv : out_edges)
+            histogram.add(label_of(static_cast<size_t>(target_id(g, uv))), weight_fn(uv));
+
+          const label_type current = label_of(uid);
+          const uint64_t   salt    = histogram.mix((uid << 16) ^ iteration);
+          const label_type label   = histogram.best(current, salt);
+          if (label != current) {
+            atomic_ref<label_type>(labels[uid]).store(label, memory_order_relaxed);
+            ++state[tid].changed;
+          }
+        }
+      });
+
+      size_t changed = 0;
+      for (auto&& s : state)
+        changed += exchange(s.changed, size_t(0));
+      if (static_cast<double>(changed) <= tolerance * static_cast<double>(V))
+        break;
+    }
+    return iteration;
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the communities of an undirected graph by label propagation, with each edge having one
+ * vote.
+ *
+ * This is label_propagation(g, labels, weight_fn, ...) with a weight of 1 for each edge.
+ *
+ * @tparam G          The graph type.
+ * @tparam LabelRange The label range type. Its values must be integral and usable with atomic_ref.
+ *
+ * @param g              The graph. It must be undirected: each edge is stored in both directions.
+ * @param labels         [out] labels[uid] is the label of the community of uid, which is the id of one of
+ *                       its vertices. The caller must assure size(labels) >= size(vertices(g)).
+ * @param max_iterations The largest number of sweeps over the vertices.
+ * @param tolerance      The sweeps stop when the fraction of the vertices whose label changed is no more
+ *                       than this.
+ * @param sweep          Whether the labels are updated asynchronously or synchronously.
+ * @param num_threads    The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of sweeps done.
+ */
+template <adjacency_list G, ranges::random_access_range LabelRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         integral<ranges::range_value_t<LabelRange>>
+size_t label_propagation(G&&                     g,
+                         LabelRange&             labels,
+                         size_t                  max_iterations = 100,
+                         double                  tolerance      = 1e-4,
+                         label_propagation_sweep sweep          = label_propagation_sweep::asynchronous,
+                         size_t                  num_threads    = 0) {
+  auto weight_fn = [](edge_reference_t<G>) { return size_t(1); };
+  return _detail::label_propagation(g, labels, weight_fn, max_iterations, tolerance, sweep, num_threads);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the communities of an undirected graph by label propagation, with the votes of the edges
+ * weighted.
+ *
+ * Each vertex starts with its own id as its label. In each sweep, every vertex takes the label with the
+ * largest total weight on its edges (Raghavan, Albert & Kumara, 2007). A tie keeps the current label if
+ * it's one of the largest, or else is broken by a hash of the vertex id, the sweep and the label, which
+ * acts as the random choice of the original algorithm without making the result depend on a seed. The
+ * sweeps stop when few enough labels change, and the vertices with the same label at the end are a
+ * community. Each sweep is a single pass over the edges, which makes it practical for very large graphs.
+ *
+ * The vertices are spread across the threads. The total weight of each label is counted in a hash table
+ * per thread that is sized for the degree of each vertex and cleared by the slots it used, so no memory is
+ * allocated per vertex once a thread's table has grown to the largest degree it sees.
+ *
+ * Complexity: O(|V| + |E|) per sweep, with the work spread across the threads.
+ *
+ * @tparam G          The graph type.
+ * @tparam LabelRange The label range type. Its values must be integral and usable with atomic_ref.
+ * @tparam EVF        The edge value function that returns the weight of the vote of an edge.
+ *
+ * @param g              The graph. It must be undirected: each edge is stored in both directions.
+ * @param labels         [out] labels[uid] is the label of the community of uid, which is the id of one of
+ *                       its vertices. The caller must assure size(labels) >= size(vertices(g)).
+ * @param weight_fn      The weight function object, weight_fn(uv). Return values must be non-negative. It
+ *                       is called concurrently by multiple threads.
+ * @param max_iterations The largest number of sweeps over the vertices.
+ * @param tolerance      The sweeps stop when the fraction of the vertices whose label changed is no more
+ *                       than this.
+ * @param sweep          Whether the labels are updated asynchronously or synchronously.
+ * @param num_threads    The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of sweeps done.
+ */
+template <adjacency_list G, ranges::random_access_range LabelRange, class EVF>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         integral<ranges::range_value_t<LabelRange>> && copy_constructible<EVF> &&
+         is_arithmetic_v<remove_cvref_t<invoke_result_t<EVF, edge_reference_t<G>>>>
+size_t label_propagation(G&&                     g,
+                         LabelRange&             labels,
+                         EVF                     weight_fn,
+                         size_t                  max_iterations = 100,
+                         double                  tolerance      = 1e-4,
+                         label_propagation_sweep sweep          = label_propagation_sweep::asynchronous,
+                         size_t                  num_threads    = 0) {
+  return _detail::label_propagation(g, labels, weight_fn, max_iterations, tolerance, sweep, num_threads);
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_LABEL_PROPAGATION_HPP
@@ -15,6 +15,7 @@
 
 #include "graph/graph.hpp"
 #include "graph/views/incidence.hpp"
+#include "graph/views/vertexlist.hpp"
 
 #ifndef GRAPH_MIS_HPP
 #  define GRAPH_MIS_HPP
@@ -46,7 +47,7 @@ void maximal_independent_set(G&&            g,       // graph
   size_t N(size(vertices(g)));
   assert(seed < N && seed >= 0);
 
-  std::vector<bool> removed_vertices(g.size());
+  std::vector<bool> removed_vertices(N);
   *mis++                 = seed;
   removed_vertices[seed] = true;
   for (auto&& [vid, v] : views::incidence(g, seed)) {
@@ -0,0 +1,426 @@
+/**
+ * @file mst.hpp
+ *
+ * @brief Minimum spanning tree (forest) algorithms: Kruskal's and Prim's.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/algorithm/shortest_paths.hpp"
+#include "graph/detail/parallel.hpp"
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+#include <limits>
+#include <functional>
+#include <cassert>
+
+#ifndef GRAPH_MST_HPP
+#  define GRAPH_MST_HPP
+
+namespace std::graph {
+
+namespace _detail {
+  // A union-find with union by rank and path compression, for one thread
+  template <integral T>
+  class disjoint_sets {
+  public:
+    explicit disjoint_sets(size_t n) : parent_(n), rank_(n, 0) {
+      for (size_t x = 0; x < n; ++x)
+        parent_[x] = static_cast<T>(x);
+    }
+
+    // The root of x, pointing every vertex on the path to it
+    T find(T x) noexcept {
+      T root = find_root(x);
+      while (parent_[x] != root)
+        x = exchange(parent_[x], root);
+      return root;
+    }
+
+    // The root of x without changing the sets, so any number of threads can call it while there are no
+    // unions. Union by rank keeps the paths shorter than log2(n) + 1.
+    T find_root(T x) const noexcept {
+      while (parent_[x] != x)
+        x = parent_[x];
+      return x;
+    }
+
+    // Merge the sets of x and y. Returns false if they're already in the same set.
+    bool unite(T x, T y) noexcept {
+      x = find(x);
+      y = find(y);
+      if (x == y)
+        return false;
+      if (rank_[x] < rank_[y])
+        swap(x, y);
+      parent_[y] = x;
+      rank_[x] += (rank_[x] == rank_[y]);
+      return true;
+    }
+
+  private:
+    vector<T>       parent_;
+    vector<uint8_t> rank_;
+  };
+
+  // An edge to sort by (weight, source_id, target_id), with source_id < target_id
+  template <class VId, class W>
+  struct mst_edge {
+    W   weight;
+    VId source_id;
+    VId target_id;
+
+    constexpr auto operator<=>(const mst_edge&) const noexcept = default;
+  };
+
+  // Filter-Kruskal (Osipov, Sanders & Singler, "The filter-Kruskal minimum spanning tree algorithm", 2009)
+  // on edges[first,last). Calls tree(e) for each edge of the minimum spanning forest in increasing order.
+  template <class VId, class W, class Tree>
+  class filter_kruskal {
+  public:
+    using edge_type = mst_edge<VId, W>;
+    using iterator  = typename vector<edge_type>::iterator;
+
+    filter_kruskal(size_t vertex_count, thread_team& team, Tree& tree)
+          : sets_(vertex_count)
+          , team_(team)
+          , tree_(tree)
+          , base_size_(max(vertex_count, size_t(16 * 1024)))
+          , remaining_(vertex_count > 0 ? vertex_count - 1 : 0) {}
+
+    // Partition the edges by a pivot weight, find the forest of the light edges, then remove the heavy
+    // edges inside a tree before finding the forest of the rest. The depth of the recursion is expected to
+    // be O(log(|E| / |V|)).
+    void operator()(iterator first, iterator last) {
+      const size_t n = static_cast<size_t>(last - first);
+      if (remaining_ == 0 || n == 0)
+        return;
+      if (n <= base_size_) {
+        kruskal(first, last);
+        return;
+      }
+
+      const W        pivot = sample_median(first, n);
+      const iterator mid   = partition(first, last, [pivot](const edge_type& e) { return e.weight <= pivot; });
+      if (mid == last) { // ties with the pivot
+        kruskal(first, last);
+        return;
+      }
+      (*this)(first, mid);
+      if (remaining_ > 0)
+        (*this)(mid, filter(mid, last));
+    }
+
+  private:
+    void kruskal(iterator first, iterator last) {
+      parallel_sort(team_, first, last);
+      for (; first != last && remaining_ > 0; ++first) {
+        if (sets_.unite(first->source_id, first->target_id)) {
+          tree_(*first);
+          --remaining_;
+        }
+      }
+    }
+
+    W sample_median(iterator first, size_t n) {
+      constexpr size_t                 samples = 255;
+      array<W, samples>                weights;
+      uniform_int_distribution<size_t> pick(0, n - 1);
+      for (auto& w : weights)
+        w = first[static_cast<ptrdiff_t>(pick(rng_))].weight;
+      ranges::nth_element(weights, weights.begin() + samples / 2);
+      return weights[samples / 2];
+    }
+
+    // Remove the edges whose endpoints are in the same tree, keeping the order of the rest. Each thread
+    // compacts its chunks in place, then the chunks are moved together.
+    iterator filter(iterator first, iterator last) {
+      constexpr size_t grain  = 64 * 1024;
+      const size_t     n      = static_cast<size_t>(last - first);
+      const size_t     chunks = (n + grain - 1) / grain;
+      vector<size_t>   kept(chunks);
+      team_.for_each_chunk(n, grain, [&](size_t, size_t lo, size_t hi) {
+        auto chunk_end = remove_if(first + static_cast<ptrdiff_t>(lo), first + static_cast<ptrdiff_t>(hi),
+                                   [this](const edge_type& e) {
+                                     return sets_.find_root(e.source_id) == sets_.find_root(e.target_id);
+                                   });
+        kept[lo / grain] = static_cast<size_t>(chunk_end - (first + static_cast<ptrdiff_t>(lo)));
+      });
+      iterator out = first;
+      for (size_t c = 0; c < chunks; ++c) {
+        auto chunk = first + static_cast<ptrdiff_t>(c * grain);
+        out        = move(chunk, chunk + static_cast<ptrdiff_t>(kept[c]), out);
+      }
+      return out;
+    }
+
+  private:
+    disjoint_sets<VId> sets_;
+    thread_team&       team_;
+    Tree&              tree_;
+    size_t             base_size_; // edges to sort rather than partition
+    size_t             remaining_; // edges left to add before the forest is a spanning tree
+    minstd_rand        rng_{42};
+  };
+
+  // The minimum spanning forest of the edges, which are reordered. Returns the total weight.
+  template <class VId, class W, class OutIter>
+  W kruskal_minimum_spanning_tree(vector<mst_edge<VId, W>>& edges,
+                                  size_t                    vertex_count,
+                                  OutIter&                  tree,
+                                  thread_team&              team) {
+    W    total = W();
+    auto add   = [&](const mst_edge<VId, W>& e) {
+      *tree++ = copyable_edge_t<VId, W>{e.source_id, e.target_id, e.weight};
+      total += e.weight;
+    };
+    filter_kruskal<VId, W, decltype(add)> solve(vertex_count, team, add);
+    solve(edges.begin(), edges.end());
+    return total;
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find a minimum spanning tree of an undirected graph with Kruskal's algorithm, or a minimum
+ * spanning forest when the graph isn't connected.
+ *
+ * The edges are copied as (weight, source_id, target_id) triples with source_id < target_id, so the two
+ * directions of an undirected edge are the same triple, and self-loops are dropped. The filter-Kruskal
+ * variant is used: the edges are partitioned by a pivot weight, the forest of the lighter edges is found
+ * first, and the heavier edges with both endpoints in the same tree are removed before they're sorted.
+ * Small partitions are sorted across the threads and their edges added in order using a union-find with
+ * union by rank and path compression. The search stops once a spanning tree is complete.
+ *
+ * Ties in weight are broken by the vertex ids, so the result doesn't depend on the number of threads.
+ *
+ * Complexity: O(|E| log |E|) in the worst case, and O(|E| + |V| log |V| log(|E| / |V|)) expected for
+ * random weights.
+ *
+ * @tparam G       The graph type.
+ * @tparam WF      The edge weight function type.
+ * @tparam OutIter The output iterator type that receives copyable_edge_t<vertex_id_t<G>, W> values, where
+ *                 W is the weight type without const or reference.
+ *
+ * @param g           The graph. It's treated as undirected: an edge stored in either direction connects
+ *                    its vertices.
+ * @param weight_fn   The weight function object, weight_fn(uv) for an edge reference uv.
+ * @param tree        The output iterator that receives an edge {source_id, target_id, weight} for each edge
+ *                    of the tree, in increasing order of weight, with source_id < target_id.
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The total weight of the tree.
+ */
+template <adjacency_list G, class WF, class OutIter>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> && copy_constructible<WF> &&
+         is_arithmetic_v<remove_cvref_t<invoke_result_t<WF, edge_reference_t<G>>>> &&
+         output_iterator<OutIter,
+                         copyable_edge_t<vertex_id_t<G>, remove_cvref_t<invoke_result_t<WF, edge_reference_t<G>>>>>
+auto kruskal_minimum_spanning_tree(G&& g, WF weight_fn, OutIter tree, size_t num_threads = 0) {
+  using vertex_id_type = vertex_id_t<G>;
+  using weight_type    = remove_cvref_t<invoke_result_t<WF, edge_reference_t<G>>>;
+  using edge_type      = _detail::mst_edge<vertex_id_type, weight_type>;
+  constexpr size_t grain = 1024; // vertices per chunk of work
+
+  const size_t         V = ranges::size(vertices(g));
+  _detail::thread_team team(num_threads);
+
+  // offset[uid] is the position of the first edge of uid, without self-loops
+  vector<size_t> offset(V + 1, 0);
+  team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+    for (size_t uid = first; uid < last; ++uid)
+      for (auto&& uv : edges(g, static_cast<vertex_id_type>(uid)))
+        offset[uid + 1] += (static_cast<size_t>(target_id(g, uv)) != uid);
+  });
+  for (size_t uid = 0; uid < V; ++uid)
+    offset[uid + 1] += offset[uid];
+
+  vector<edge_type> mst_edges(offset[V]);
+  team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+    for (size_t uid = first; uid < last; ++uid) {
+      size_t i = offset[uid];
+      for (auto&& uv : edges(g, static_cast<vertex_id_type>(uid))) {
+        const auto u = static_cast<vertex_id_type>(uid);
+        const auto v = static_cast<vertex_id_type>(target_id(g, uv));
+        if (u != v)
+          mst_edges[i++] = {static_cast<weight_type>(weight_fn(uv)), min(u, v), max(u, v)};
+      }
+    }
+  });
+  return _detail::kruskal_minimum_spanning_tree(mst_edges, V, tree, team);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find a minimum spanning forest of the graph given by a range of edges, such as views::edgelist(g)
+ * or a vector of copyable_edge_t<VId,EV>, with Kruskal's algorithm.
+ *
+ * This is kruskal_minimum_spanning_tree(g, ...) for an edge range. The number of vertices is one more
+ * than the largest vertex id. The edges are copied across the threads when erng is a sized
+ * random_access_range; otherwise they're read once on the calling thread.
+ *
+ * Complexity: O(|E| log |E|) in the worst case, and O(|E| + |V| log |V| log(|E| / |V|)) expected for
+ * random weights.
+ *
+ * @tparam ERng    The edge range type.
+ * @tparam WF      The edge weight function type.
+ * @tparam OutIter The output iterator type that receives copyable_edge_t<VId, W> values, where VId is the
+ *                 type of the vertex ids of the edges and W is the weight type.
+ * @tparam EProj   The edge projection type.
+ *
+ * @param erng        The edges. Each connects its vertices in both directions.
+ * @param weight_fn   The weight function object, weight_fn(e) for an element e of erng.
+ * @param tree        The output iterator that receives an edge {source_id, target_id, weight} for each edge
+ *                    of the forest, in increasing order of weight, with source_id < target_id.
+ * @param eprojection A function that returns a value with source_id and target_id members for an element
+ *                    of erng.
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The total weight of the forest.
+ */
+template <ranges::forward_range ERng, class WF, class OutIter, class EProj = identity>
+requires(!adjacency_list<ERng>) && requires(EProj eproj, WF weight_fn, ranges::range_reference_t<ERng> e) {
+  eproj(e).source_id;
+  eproj(e).target_id;
+  requires is_arithmetic_v<remove_cvref_t<invoke_result_t<WF, ranges::range_reference_t<ERng>>>>;
+}
+auto kruskal_minimum_spanning_tree(
+      const ERng& erng, WF weight_fn, OutIter tree, EProj eprojection = {}, size_t num_threads = 0) {
+  using vertex_id_type = remove_cvref_t<decltype(eprojection(*ranges::begin(erng)).source_id)>;
+  using weight_type    = remove_cvref_t<invoke_result_t<WF, ranges::range_reference_t<ERng>>>;
+  using edge_type      = _detail::mst_edge<vertex_id_type, weight_type>;
+  constexpr bool parallel = ranges::random_access_range<ERng> && ranges::sized_range<ERng>;
+
+  // the edge with the smaller vertex id first
+  auto to_mst_edge = [&](auto&& edge_data) {
+    auto&&     uv = eprojection(edge_data);
+    const auto u  = static_cast<vertex_id_type>(uv.source_id);
+    const auto v  = static_cast<vertex_id_type>(uv.target_id);
+    return edge_type{static_cast<weight_type>(weight_fn(edge_data)), min(u, v), max(u, v)};
+  };
+
+  _detail::thread_team team(parallel ? num_threads : 1);
+  vector<edge_type>    mst_edges;
+  size_t               V = 0;
+  if constexpr (parallel) {
+    struct alignas(64) thread_max {
+      size_t id = 0;
+    };
+    vector<thread_max> max_id(team.size());
+    auto               first = ranges::begin(erng);
+    mst_edges.resize(static_cast<size_t>(ranges::size(erng)));
+    team.for_each_chunk(mst_edges.size(), 16 * 1024, [&](size_t tid, size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        mst_edges[i]   = to_mst_edge(first[static_cast<ptrdiff_t>(i)]);
+        max_id[tid].id = max(max_id[tid].id, static_cast<size_t>(mst_edges[i].target_id) + 1);
+      }
+    });
+    V = ranges::max(max_id, {}, &thread_max::id).id;
+  } else {
+    for (auto&& edge_data : erng) {
+      mst_edges.push_back(to_mst_edge(edge_data));
+      V = max(V, static_cast<size_t>(mst_edges.back().target_id) + 1);
+    }
+  }
+  erase_if(mst_edges, [](const edge_type& e) { return e.source_id == e.target_id; });
+  return _detail::kruskal_minimum_spanning_tree(mst_edges, V, tree, team);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find a minimum spanning tree of an undirected graph with Prim's algorithm, or a minimum spanning
+ * forest when the graph isn't connected.
+ *
+ * A tree is grown from the vertex with the lowest id that isn't in a tree yet, adding the vertex that is
+ * nearest to the tree each time, until the vertices it reaches are exhausted. The next tree is grown from
+ * the next vertex that isn't reached, so there is one seed per connected component.
+ *
+ * The queue is used as in dijkstra_shortest_paths(), with the weight of the lightest edge to the tree in
+ * place of the distance from the seed. The default indexed_dary_heap updates the weight of a queued vertex
+ * in place (decrease-key), so it holds at most |V| vertices. Queues that push duplicate entries, such as
+ * std::priority_queue with greater<>, can also be used.
+ *
+ * Complexity: O(|E| log |V|) with the default queue
+ *
+ * @tparam G                The graph type.
+ * @tparam PredecessorRange The predecessor range type.
+ * @tparam WeightRange      The weight range type.
+ * @tparam EVF              The edge value function that returns the weight of an edge.
+ * @tparam Q                The priority queue type.
+ *
+ * @param g           The graph. It must be undirected: each edge is stored in both directions.
+ * @param predecessor [out] The predecessor[uid] of vertex_id uid in its tree; predecessor[seed] == seed for
+ *                    the seed of each tree. The caller must assure size(predecessor) >= size(vertices(g)).
+ * @param weight      [out] The weight[uid] of the edge from predecessor[uid] to uid; weight[seed] == 0 for
+ *                    the seed of each tree. The caller must assure size(weight) >= size(vertices(g)).
+ * @param weight_fn   The weight function object used to determine the weight of an edge. The default
+ *                    return value is 1.
+ * @param q           The priority queue used internally by prim_minimum_spanning_tree.
+ */
+template <adjacency_list              G,
+          ranges::random_access_range PredecessorRange,
+          ranges::random_access_range WeightRange,
+          class EVF   = std::function<ranges::range_value_t<WeightRange>(edge_reference_t<G>)>,
+          queueable Q = container::indexed_dary_heap<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>>>
+requires ranges::random_access_range<vertex_range_t<G>> &&      //
+         integral<vertex_id_t<G>> &&                            //
+         is_arithmetic_v<ranges::range_value_t<WeightRange>> && //
+         convertible_to<vertex_id_t<G>, ranges::range_value_t<PredecessorRange>> && //
+         edge_weight_function<G, EVF>
+void prim_minimum_spanning_tree(
+      G&&               g,
+      PredecessorRange& predecessor,
+      WeightRange&      weight,
+      EVF               weight_fn = [](edge_reference_t<G>) { return ranges::range_value_t<WeightRange>(1); },
+      Q                 q         = Q()) {
+  using vertex_id_type = vertex_id_t<G>;
+  using weight_type    = ranges::range_value_t<WeightRange>;
+
+  const size_t V = ranges::size(vertices(g));
+  assert(size(predecessor) >= V);
+  assert(size(weight) >= V);
+
+  // weight[uid] is the weight of the lightest edge from the tree to uid until uid is added to the tree
+  ranges::fill(ranges::begin(weight), ranges::begin(weight) + static_cast<ptrdiff_t>(V),
+               numeric_limits<weight_type>::max());
+  vector<bool> in_tree(V);
+
+  // reserve room for all vertices when the queue supports it (e.g. indexed_dary_heap)
+  if constexpr (requires { q.reserve(V); })
+    q.reserve(V);
+
+  for (size_t seed = 0; seed < V; ++seed) {
+    if (in_tree[seed])
+      continue;
+    weight[seed]      = weight_type();
+    predecessor[seed] = static_cast<vertex_id_type>(seed);
+    q.push({static_cast<vertex_id_type>(seed), weight[seed]});
+    while (!q.empty()) {
+      const vertex_id_type uid = q.top().vertex_id;
+      q.pop();
+      if (in_tree[uid])
+        continue; // stale entry: uid was already added with a lighter edge
+      in_tree[uid] = true;
+
+      for (auto&& [vid, uv, w] : views::incidence(g, uid, weight_fn)) {
+        if (!in_tree[vid] && static_cast<weight_type>(w) < weight[vid]) {
+          weight[vid]      = static_cast<weight_type>(w);
+          predecessor[vid] = uid;
+          q.push({vid, weight[vid]});
+        }
+      }
+    }
+  }
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_MST_HPP
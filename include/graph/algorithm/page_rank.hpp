@@ -0,0 +1,191 @@
+/**
+ * @file page_rank.hpp
+ *
+ * @brief Parallel PageRank that pulls the rank of each vertex from its incoming edges.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/detail/parallel.hpp"
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+#ifndef GRAPH_PAGE_RANK_HPP
+#  define GRAPH_PAGE_RANK_HPP
+
+namespace std::graph {
+
+namespace _detail {
+  template <adjacency_list G, adjacency_list GT, ranges::random_access_range RankRange>
+  size_t page_rank(G&&        g,
+                   GT&&       gt,
+                   RankRange& ranks,
+                   double     damping,
+                   double     tolerance,
+                   size_t     max_iterations,
+                   size_t     num_threads) {
+    using vertex_id_type = vertex_id_t<G>;
+    using rank_type      = ranges::range_value_t<RankRange>;
+    constexpr size_t grain = 1024; // vertices per chunk of work
+
+    const size_t V = ranges::size(vertices(g));
+    assert(static_cast<size_t>(ranges::size(ranks)) >= V);
+    if (V == 0)
+      return 0;
+
+    // The partial sums of each thread, on separate cache lines
+    struct alignas(64) thread_sum {
+      double sum = 0;
+    };
+    thread_team        team(num_threads);
+    vector<thread_sum> partial(team.size());
+    auto               reduce = [&partial]() {
+      double sum = 0;
+      for (auto&& p : partial)
+        sum += exchange(p.sum, 0.0);
+      return sum;
+    };
+
+    // inv_degree[u] = 1 / out-degree of u, or 0 for dangling vertices. contrib[u] = ranks[u] * inv_degree[u]
+    // is the rank sent along each outgoing edge of u, which is what the pull step reads.
+    vector<rank_type> inv_degree(V);
+    vector<rank_type> contrib(V);
+    team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid) {
+        const auto degree = ranges::distance(edges(g, static_cast<vertex_id_type>(uid)));
+        inv_degree[uid]   = degree > 0 ? rank_type(1) / static_cast<rank_type>(degree) : rank_type(0);
+        ranks[uid]        = rank_type(1) / static_cast<rank_type>(V);
+      }
+    });
+
+    size_t iteration = 0;
+    while (iteration < max_iterations) {
+      ++iteration;
+
+      // scatter the rank of each vertex over its outgoing edges; dangling vertices give theirs to all vertices
+      team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+        double dangling = 0;
+        for (size_t uid = first; uid < last; ++uid) {
+          contrib[uid] = ranks[uid] * inv_degree[uid];
+          if (inv_degree[uid] == rank_type(0))
+            dangling += static_cast<double>(ranks[uid]);
+        }
+        partial[tid].sum += dangling;
+      });
+      const auto base = static_cast<rank_type>((1.0 - damping + damping * reduce()) / static_cast<double>(V));
+      const auto d    = static_cast<rank_type>(damping);
+
+      // pull the contributions of the incoming edges; each vertex is written by one thread only
+      team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+        double error = 0;
+        for (size_t uid = first; uid < last; ++uid) {
+          rank_type sum = 0;
+          for (auto&& vu : edges(gt, static_cast<vertex_id_t<GT>>(uid)))
+            sum += contrib[static_cast<size_t>(target_id(gt, vu))];
+          const rank_type rank = base + d * sum;
+          error += static_cast<double>(abs(rank - ranks[uid]));
+          ranks[uid] = rank;
+        }
+        partial[tid].sum += error;
+      });
+      if (reduce() < tolerance)
+        break;
+    }
+    return iteration;
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Evaluate the PageRank of the vertices of an undirected graph.
+ *
+ * This is page_rank(g, gt, ...) with g as its own transpose, which holds when each edge is stored in
+ * both directions. Use the overload with a transpose graph for directed graphs.
+ *
+ * @tparam G         The graph type.
+ * @tparam RankRange The rank range type. Its values must be floating point.
+ *
+ * @param g              The graph. It must be undirected: each edge is stored in both directions.
+ * @param ranks          [out] ranks[uid] is the PageRank of uid. The ranks sum to 1. The caller must
+ *                       assure size(ranks) >= size(vertices(g)).
+ * @param damping        The probability of following an edge rather than jumping to a random vertex.
+ * @param tolerance      The iterations stop when the sum of the absolute changes of the ranks is less
+ *                       than this.
+ * @param max_iterations The largest number of iterations.
+ * @param num_threads    The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of iterations done.
+ */
+template <adjacency_list G, ranges::random_access_range RankRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         floating_point<ranges::range_value_t<RankRange>>
+size_t page_rank(G&&        g,
+                 RankRange& ranks,
+                 double     damping        = 0.85,
+                 double     tolerance      = 1e-4,
+                 size_t     max_iterations = 100,
+                 size_t     num_threads    = 0) {
+  assert(damping >= 0 && damping <= 1);
+  return _detail::page_rank(g, g, ranks, damping, tolerance, max_iterations, num_threads);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Evaluate the PageRank of the vertices of a graph.
+ *
+ * The rank of each vertex is found by the power iteration
+ *
+ *     rank'[u] = (1 - damping) / |V| + damping * (dangling / |V| + sum of rank[v] / out_degree(v) for v->u)
+ *
+ * where dangling is the sum of the ranks of the vertices without outgoing edges, which are treated as
+ * linking to every vertex. Each iteration pulls rank[v] / out_degree(v) from the incoming edges of u in
+ * the transpose graph, so each rank is written by one thread without atomic updates. The out-degrees are
+ * evaluated once, and the contributions of the vertices are kept in a contiguous array in the rank type,
+ * so an iteration reads |V| + |E| values sequentially besides the contributions of the neighbors. The
+ * vertices are spread across the threads; the sums of the dangling ranks and of the changes are reduced
+ * from per-thread partial sums in double precision.
+ *
+ * Complexity: O(|V| + |E|) per iteration, with the work spread across the threads.
+ *
+ * @tparam G         The graph type.
+ * @tparam GT        The transpose graph type.
+ * @tparam RankRange The rank range type. Its values must be floating point.
+ *
+ * @param g              The graph, which gives the out-degree of each vertex.
+ * @param gt             The transpose of g, with an edge (v,u) for each edge (u,v) in g, which gives the
+ *                       incoming edges. Pass g for undirected (symmetric) graphs.
+ * @param ranks          [out] ranks[uid] is the PageRank of uid. The ranks sum to 1. The caller must
+ *                       assure size(ranks) >= size(vertices(g)).
+ * @param damping        The probability of following an edge rather than jumping to a random vertex.
+ * @param tolerance      The iterations stop when the sum of the absolute changes of the ranks is less
+ *                       than this.
+ * @param max_iterations The largest number of iterations.
+ * @param num_threads    The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of iterations done.
+ */
+template <adjacency_list G, adjacency_list GT, ranges::random_access_range RankRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         ranges::random_access_range<vertex_range_t<GT>> && integral<vertex_id_t<GT>> &&
+         floating_point<ranges::range_value_t<RankRange>>
+size_t page_rank(G&&        g,
+                 GT&&       gt,
+                 RankRange& ranks,
+                 double     damping        = 0.85,
+                 double     tolerance      = 1e-4,
+                 size_t     max_iterations = 100,
+                 size_t     num_threads    = 0) {
+  assert(ranges::size(vertices(gt)) == ranges::size(vertices(g)));
+  assert(damping >= 0 && damping <= 1);
+  return _detail::page_rank(g, gt, ranks, damping, tolerance, max_iterations, num_threads);
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_PAGE_RANK_HPP
@@ -15,8 +15,17 @@
 
 #include <queue>
 #include <vector>
+#include <map>
+#include <compare>
+#include <atomic>
+#include <limits>
 #include <ranges>
+#include <optional>
 #include "../graph.hpp"
+#include "../views/incidence.hpp"
+#include "../views/edgelist.hpp"
+#include "../container/indexed_dary_heap.hpp"
+#include "../detail/parallel.hpp"
 
 #ifndef GRAPH_SHORTEST_PATHS_HPP
 #  define GRAPH_SHORTEST_PATHS_HPP
@@ -75,14 +84,14 @@ struct weighted_vertex {
   vertex_id_t<G> vertex_id = vertex_id_t<G>();
   W              weight    = W();
 
-  constexpr auto operator<=>(const weighted_vertex& rhs) const noexcept {
-    if (vertex_id < rhs.vertex_id)
-      return -1;
-    else if (vertex_id > rhs.vertex_id)
-      return +1;
-    else
-      return 0;
+  // Ordered by weight so greater<weighted_vertex> gives a min-queue on distance. The vertex_id breaks ties
+  // to give a deterministic order.
+  constexpr compare_three_way_result_t<W> operator<=>(const weighted_vertex& rhs) const noexcept {
+    if (auto cmp = weight <=> rhs.weight; cmp != 0)
+      return cmp;
+    return vertex_id <=> rhs.vertex_id;
   }
+  constexpr bool operator==(const weighted_vertex& rhs) const noexcept = default;
 };
 
 /**
@@ -123,15 +132,16 @@ auto dijkstra_invalid_distance() {
  *                    distance[uid] != dijkstra_invalid_distance().
  * @param weight_fn   The weight function object used to determine the distance between
  *                    vertices on an edge. Return values must be non-negative. The default return value is 1.
- * @param q           The priority queue used internally by dijkstra_shortest_paths.
+ * @param q           The priority queue used internally by dijkstra_shortest_paths. The default is an
+ *                    indexed_dary_heap which updates the weight of a queued vertex in place (decrease-key),
+ *                    so a vertex is in the queue at most once. Queues that push duplicate entries, such as
+ *                    std::priority_queue, can also be used.
  */
 template <adjacency_list              G,
           ranges::random_access_range DistanceRange,
           ranges::random_access_range PredecessorRange,
           class EVF   = std::function<ranges::range_value_t<DistanceRange>(edge_reference_t<G>)>,
-          queueable Q = priority_queue<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>,
-                                       vector<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>>,
-                                       greater<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>>>>
+          queueable Q = container::indexed_dary_heap<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>>>
 requires ranges::random_access_range<vertex_range_t<G>> &&        //
          integral<vertex_id_t<G>> &&                              //
          is_arithmetic_v<ranges::range_value_t<DistanceRange>> && //
@@ -154,11 +164,17 @@ constexpr void dijkstra_shortest_paths(
   if constexpr (!is_same_v<PredecessorRange, _null_predecessor_range_type>)
     predecessor[seed] = seed;
 
+  // reserve room for all vertices when the queue supports it (e.g. indexed_dary_heap)
+  if constexpr (requires { q.reserve(ranges::size(vertices(g))); })
+    q.reserve(ranges::size(vertices(g)));
+
   // Remark(Andrew): CLRS puts all vertices in the queue to start but standard practice seems to be to enqueue source
   q.push({seed, distance[seed]});
   while (!q.empty()) {
-    auto uid = q.top().vertex_id;
+    auto [uid, uid_distance] = q.top();
     q.pop();
+    if (uid_distance > distance[uid])
+      continue; // stale entry: uid was already settled with a shorter distance
 
     for (auto&& [vid, uv, w] : views::incidence(g, uid, weight_fn)) {
       if (distance[uid] + w < distance[vid]) {
@@ -195,9 +211,7 @@ constexpr void dijkstra_shortest_paths(
 template <adjacency_list              G,
           ranges::random_access_range DistanceRange,
           class EVF   = std::function<ranges::range_value_t<DistanceRange>(edge_reference_t<G>)>,
-          queueable Q = priority_queue<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>,
-                                       vector<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>>,
-                                       greater<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>>>>
+          queueable Q = container::indexed_dary_heap<weighted_vertex<G, invoke_result_t<EVF, edge_reference_t<G>>>>>
 requires ranges::random_access_range<vertex_range_t<G>> &&        //
          integral<vertex_id_t<G>> &&                              //
          is_arithmetic_v<ranges::range_value_t<DistanceRange>> && //
@@ -215,6 +229,528 @@ constexpr void dijkstra_shortest_distances(
 }
 
 
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the shortest paths and distances to vertices reachable from a single seed vertex for
+ * non-negative weights using the parallel delta-stepping algorithm of Meyer & Sanders.
+ * 
+ * Vertices are kept in buckets of width delta based on their tentative distance. The lowest non-empty
+ * bucket is processed in phases; the light edges (weight <= delta) of the vertices in the bucket are
+ * relaxed in parallel until the bucket stays empty, followed by a single parallel relaxation of the
+ * heavy edges (weight > delta) of all the vertices that were removed from the bucket. The predecessors
+ * are assigned after the distances are final by a parallel search of the edges on shortest paths.
+ * 
+ * Each thread keeps the buckets near the current one in a ring, and the non-empty buckets beyond it in a
+ * map, so the memory used doesn't depend on the number of buckets spanned by the distances and the empty
+ * buckets between them are skipped.
+ * 
+ * A delta near the largest edge weight divided by the average out-degree is usually a good choice. A
+ * small delta approaches Dijkstra's algorithm, with little parallelism; a large delta approaches
+ * Bellman-Ford, with more redundant relaxations.
+ * 
+ * Complexity: O(|V| + |E|) relaxations, plus a log factor for the vertices added to buckets beyond the
+ * ring, with the work of each phase spread across the threads.
+ * 
+ * @tparam G                The graph type.
+ * @tparam DistanceRange    The distance range type. Its values must be usable with atomic_ref.
+ * @tparam PredecessorRange The predecessor range type.
+ * @tparam EVF              The edge value function that returns the weight of an edge.
+ * 
+ * @param g           The graph.
+ * @param seed        The single source vertex to start the search.
+ * @param distance    [inout] The distance[uid] of vertex_id uid from seed. distance[seed] == 0. The caller
+ *                    must assure size(distance) >= size(vertices(g)) and set the values to be 
+ *                    dijkstra_invalid_distance().
+ * @param predecessor [inout] The predecessor[uid] of vertex_id uid in path. predecessor[seed] == seed. The
+ *                    caller must assure size(predecessor) >= size(vertices(g)). It is only valid when
+ *                    distance[uid] != dijkstra_invalid_distance().
+ * @param weight_fn   The weight function object used to determine the distance between vertices on an
+ *                    edge. Return values must be non-negative. It is called concurrently by multiple threads.
+ * @param delta       The width of a bucket. It must be greater than zero.
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ */
+template <adjacency_list              G,
+          ranges::random_access_range DistanceRange,
+          ranges::random_access_range PredecessorRange,
+          class EVF = std::function<ranges::range_value_t<DistanceRange>(edge_reference_t<G>)>>
+requires ranges::random_access_range<vertex_range_t<G>> &&        //
+         integral<vertex_id_t<G>> &&                              //
+         is_arithmetic_v<ranges::range_value_t<DistanceRange>> && //
+         edge_weight_function<G, EVF>
+void delta_stepping_shortest_paths(
+      G&&                                  g,
+      vertex_id_t<G>                       seed,
+      DistanceRange&                       distance,
+      PredecessorRange&                    predecessor,
+      EVF                                  weight_fn   = [](edge_reference_t<G> uv) { return ranges::range_value_t<DistanceRange>(1); },
+      ranges::range_value_t<DistanceRange> delta       = ranges::range_value_t<DistanceRange>(1),
+      size_t                               num_threads = 0) {
+  using id_type       = vertex_id_t<G>;
+  using distance_type = ranges::range_value_t<DistanceRange>;
+  using id_list       = vector<id_type>;
+
+  const size_t V = ranges::size(vertices(g));
+  assert(size(distance) >= V);
+  assert(seed >= 0 && static_cast<size_t>(seed) < V);
+  assert(delta > distance_type());
+  const size_t     grain  = 256; // vertices per chunk of work
+  constexpr size_t window = 64;  // buckets in the ring of each thread
+
+  _detail::thread_team team(num_threads);
+  const size_t         T = team.size();
+
+  auto load_distance = [&distance](id_type uid) {
+    return atomic_ref<distance_type>(distance[uid]).load(memory_order_relaxed);
+  };
+  auto bucket_of = [delta](distance_type d) { return static_cast<size_t>(d / delta); };
+
+  // The vertices added to bucket b (b == distance/delta) by a thread
+  struct thread_buckets {
+    vector<id_list>      ring; // ring[b % window] for b in [curr, curr + window)
+    map<size_t, id_list> far;  // the non-empty buckets b >= curr + window
+  };
+  vector<thread_buckets> bins(T);          // bins[tid]: the buckets of thread tid
+  size_t                 curr = 0;         // the current bucket
+  vector<id_list>        removed(T);       // removed[tid]: vertices removed from the current bucket by thread tid
+  vector<uint8_t>        is_removed(V, 0); // is_removed[uid]: uid is in removed for the current bucket
+  id_list                frontier;         // vertices in the current bucket
+  id_list                settled;          // vertices removed from the current bucket
+
+  // relax the edges of uid where is_phase_edge(w) is true and add improved vertices to the thread's buckets
+  auto relax = [&](size_t tid, id_type uid, distance_type du, auto&& is_phase_edge) {
+    for (auto&& [vid, uv, w] : views::incidence(g, uid, weight_fn)) {
+      if (!is_phase_edge(w))
+        continue;
+      const distance_type dv = static_cast<distance_type>(du + w);
+      if (_detail::atomic_min(distance[vid], dv)) {
+        const size_t b = bucket_of(dv);
+        if (b < curr + window)
+          bins[tid].ring[b % window].push_back(vid);
+        else
+          bins[tid].far[b].push_back(vid);
+      }
+    }
+  };
+  auto is_light = [delta](const auto& w) { return w <= delta; };
+  auto is_heavy = [delta](const auto& w) { return w > delta; };
+
+  for (auto&& tb : bins)
+    tb.ring.resize(window);
+  distance[seed] = distance_type();
+  frontier.push_back(seed);
+  for (;;) {
+    // light phases: repeat until no vertex is added back to the current bucket
+    while (!frontier.empty()) {
+      team.for_each_chunk(frontier.size(), grain, [&](size_t tid, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          const id_type       uid = frontier[i];
+          const distance_type du  = load_distance(uid);
+          if (bucket_of(du) != curr)
+            continue; // stale: uid was moved to a lower bucket and has already been removed
+          if (!atomic_ref<uint8_t>(is_removed[uid]).exchange(1, memory_order_relaxed))
+            removed[tid].push_back(uid);
+          relax(tid, uid, du, is_light);
+        }
+      });
+      _detail::gather(team, frontier, [&](size_t tid) -> id_list& { return bins[tid].ring[curr % window]; });
+    }
+
+    // heavy phase: the distances of the removed vertices are final
+    _detail::gather(team, settled, [&](size_t tid) -> id_list& { return removed[tid]; });
+    team.for_each_chunk(settled.size(), grain, [&](size_t tid, size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        const id_type uid = settled[i];
+        is_removed[uid]   = 0;
+        relax(tid, uid, load_distance(uid), is_heavy);
+      }
+    });
+
+    // advance to the lowest non-empty bucket, in the rings or else in the maps
+    size_t next = numeric_limits<size_t>::max();
+    for (auto&& tb : bins)
+      for (size_t b = curr + 1; b < min(curr + window, next); ++b)
+        if (!tb.ring[b % window].empty()) {
+          next = b;
+          break;
+        }
+    if (next == numeric_limits<size_t>::max())
+      for (auto&& tb : bins)
+        if (!tb.far.empty())
+          next = min(next, tb.far.begin()->first);
+    if (next == numeric_limits<size_t>::max())
+      break;
+
+    // the ring slots of the buckets before next are empty and are reused for the buckets after the old ring
+    curr = next;
+    for (auto&& tb : bins)
+      for (auto it = tb.far.begin(); it != tb.far.end() && it->first < curr + window; it = tb.far.erase(it))
+        tb.ring[it->first % window].swap(it->second);
+    _detail::gather(team, frontier, [&](size_t tid) -> id_list& { return bins[tid].ring[curr % window]; });
+  }
+
+  // predecessors: search from seed along edges where distance[uid] + w == distance[vid]
+  if constexpr (!is_same_v<PredecessorRange, _null_predecessor_range_type>) {
+    vector<uint8_t>& visited = is_removed; // all zero again
+    vector<id_list>& found   = removed;
+    visited[seed]            = 1;
+    predecessor[seed]        = seed;
+    frontier.assign(1, seed);
+    while (!frontier.empty()) {
+      team.for_each_chunk(frontier.size(), grain, [&](size_t tid, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          const id_type       uid = frontier[i];
+          const distance_type du  = distance[uid];
+          for (auto&& [vid, uv, w] : views::incidence(g, uid, weight_fn)) {
+            if (static_cast<distance_type>(du + w) == distance[vid] &&
+                !atomic_ref<uint8_t>(visited[vid]).exchange(1, memory_order_relaxed)) {
+              predecessor[vid] = uid;
+              found[tid].push_back(vid);
+            }
+          }
+        }
+      });
+      _detail::gather(team, frontier, [&](size_t tid) -> id_list& { return found[tid]; });
+    }
+  }
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the shortest distances to vertices reachable from a single seed vertex for non-negative
+ * weights using the parallel delta-stepping algorithm.
+ * 
+ * @tparam G             The graph type.
+ * @tparam DistanceRange The distance range type. Its values must be usable with atomic_ref.
+ * @tparam EVF           The edge value function that returns the weight of an edge.
+ * 
+ * @param g           The graph.
+ * @param seed        The single source vertex to start the search.
+ * @param distance    [inout] The distance[uid] of vertex_id uid from seed. distance[seed] == 0. The caller
+ *                    must assure size(distance) >= size(vertices(g)) and set the values to be 
+ *                    dijkstra_invalid_distance().
+ * @param weight_fn   The weight function object used to determine the distance between vertices on an
+ *                    edge. Return values must be non-negative. It is called concurrently by multiple threads.
+ * @param delta       The width of a bucket. It must be greater than zero.
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ */
+template <adjacency_list              G,
+          ranges::random_access_range DistanceRange,
+          class EVF = std::function<ranges::range_value_t<DistanceRange>(edge_reference_t<G>)>>
+requires ranges::random_access_range<vertex_range_t<G>> &&        //
+         integral<vertex_id_t<G>> &&                              //
+         is_arithmetic_v<ranges::range_value_t<DistanceRange>> && //
+         edge_weight_function<G, EVF>
+void delta_stepping_shortest_distances(
+      G&&                                  g,
+      vertex_id_t<G>                       seed,
+      DistanceRange&                       distance,
+      EVF                                  weight_fn   = [](edge_reference_t<G> uv) { return ranges::range_value_t<DistanceRange>(1); },
+      ranges::range_value_t<DistanceRange> delta       = ranges::range_value_t<DistanceRange>(1),
+      size_t                               num_threads = 0) {
+  _null_predecessor_range_type predecessor; // don't evaluate predecessor
+  delta_stepping_shortest_paths(g, seed, distance, predecessor, weight_fn, delta, num_threads);
+}
+
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the shortest paths and distances to vertices reachable from a single seed vertex when
+ * edge weights can be negative, using the queue-based Bellman-Ford algorithm (SPFA).
+ * 
+ * Only vertices whose distance changed are queued to have their edges relaxed, so the search ends as soon
+ * as a pass makes no change rather than always doing |V|-1 passes over all edges. The number of edges on
+ * the path to each vertex is tracked; a path with |V| or more edges means a negative weight cycle is
+ * reachable from seed, as does any decrease of seed's own distance. The search then stops and returns a
+ * vertex id on the cycle, which can be passed to find_negative_cycle() with the predecessors to get the
+ * vertices on the cycle.
+ * 
+ * Complexity: O(|V||E|) worst case, and usually much less.
+ * 
+ * @tparam G                The graph type.
+ * @tparam DistanceRange    The distance range type.
+ * @tparam PredecessorRange The predecessor range type.
+ * @tparam EVF              The edge value function that returns the weight of an edge.
+ * 
+ * @param g           The graph.
+ * @param seed        The single source vertex to start the search.
+ * @param distance    [inout] The distance[uid] of vertex_id uid from seed. distance[seed] == 0. The caller
+ *                    must assure size(distance) >= size(vertices(g)) and set the values to be 
+ *                    dijkstra_invalid_distance().
+ * @param predecessor [inout] The predecessor[uid] of vertex_id uid in path. predecessor[seed] == seed. The
+ *                    caller must assure size(predecessor) >= size(vertices(g)). It is only valid when
+ *                    distance[uid] != dijkstra_invalid_distance().
+ * @param weight_fn   The weight function object used to determine the distance between vertices on an
+ *                    edge. Return values may be negative. The default return value is 1.
+ * 
+ * @return The id of a vertex on a negative weight cycle reachable from seed, or an empty optional if there
+ *         isn't one. The distances and predecessors aren't meaningful when a cycle is returned.
+ */
+template <adjacency_list              G,
+          ranges::random_access_range DistanceRange,
+          ranges::random_access_range PredecessorRange,
+          class EVF = std::function<ranges::range_value_t<DistanceRange>(edge_reference_t<G>)>>
+requires ranges::random_access_range<vertex_range_t<G>> &&        //
+         integral<vertex_id_t<G>> &&                              //
+         is_arithmetic_v<ranges::range_value_t<DistanceRange>> && //
+         edge_weight_function<G, EVF>
+[[nodiscard]] optional<vertex_id_t<G>> bellman_ford_shortest_paths(
+      G&&               g,
+      vertex_id_t<G>    seed,
+      DistanceRange&    distance,
+      PredecessorRange& predecessor,
+      EVF               weight_fn = [](edge_reference_t<G> uv) { return ranges::range_value_t<DistanceRange>(1); }) {
+  using id_type       = vertex_id_t<G>;
+  using distance_type = ranges::range_value_t<DistanceRange>;
+
+  const size_t V = ranges::size(vertices(g));
+  assert(size(distance) >= V);
+  assert(seed >= 0 && static_cast<size_t>(seed) < V);
+
+  // predecessors are needed to find a vertex on a negative cycle, even when the caller doesn't want them
+  constexpr bool  has_predecessor = !is_same_v<PredecessorRange, _null_predecessor_range_type>;
+  vector<id_type> internal_predecessor(has_predecessor ? 0 : V);
+  auto            pred = [&](id_type uid) -> id_type& {
+    if constexpr (has_predecessor)
+      return predecessor[uid];
+    else
+      return internal_predecessor[uid];
+  };
+
+  // Returns a vertex on a cycle in the predecessor graph, if there is one on the path from uid to seed.
+  // Any such cycle has negative weight.
+  auto cycle_vertex = [&](id_type uid) -> optional<id_type> {
+    for (size_t i = 0; i < V; ++i) // after |V| steps we're on a cycle, or have reached seed
+      uid = pred(uid);
+    if (uid == seed && pred(seed) == seed)
+      return nullopt;
+    return uid;
+  };
+
+  vector<size_t>  path_edges(V, 0); // number of edges on the current path to uid
+  vector<uint8_t> queued(V, 0);
+  queue<id_type>  q;
+
+  distance[seed] = distance_type();
+  pred(seed)     = seed;
+  q.push(seed);
+  queued[seed] = 1;
+  while (!q.empty()) { // empty when a pass makes no changes
+    const id_type uid = q.front();
+    q.pop();
+    queued[uid] = 0;
+
+    for (auto&& [vid, uv, w] : views::incidence(g, uid, weight_fn)) {
+      const distance_type dv = static_cast<distance_type>(distance[uid] + w);
+      if (dv < distance[vid]) {
+        distance[vid]   = dv;
+        pred(vid)       = uid;
+        path_edges[vid] = path_edges[uid] + 1;
+        if (vid == seed) // a shorter path back to seed is a negative cycle through it, e.g. a self-loop
+          return seed;
+        if (path_edges[vid] >= V) {
+          if (optional<id_type> cycle_id = cycle_vertex(vid); cycle_id.has_value())
+            return cycle_id;
+        }
+        if (!queued[vid]) {
+          q.push(vid);
+          queued[vid] = 1;
+        }
+      }
+    }
+  }
+  return nullopt;
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the shortest distances to vertices reachable from a single seed vertex when edge weights can
+ * be negative, using the queue-based Bellman-Ford algorithm (SPFA).
+ * 
+ * @tparam G             The graph type.
+ * @tparam DistanceRange The distance range type.
+ * @tparam EVF           The edge value function that returns the weight of an edge.
+ * 
+ * @param g           The graph.
+ * @param seed        The single source vertex to start the search.
+ * @param distance    [inout] The distance[uid] of vertex_id uid from seed. distance[seed] == 0. The caller
+ *                    must assure size(distance) >= size(vertices(g)) and set the values to be 
+ *                    dijkstra_invalid_distance().
+ * @param weight_fn   The weight function object used to determine the distance between vertices on an
+ *                    edge. Return values may be negative. The default return value is 1.
+ * 
+ * @return The id of a vertex on a negative weight cycle reachable from seed, or an empty optional if there
+ *         isn't one.
+ */
+template <adjacency_list              G,
+          ranges::random_access_range DistanceRange,
+          class EVF = std::function<ranges::range_value_t<DistanceRange>(edge_reference_t<G>)>>
+requires ranges::random_access_range<vertex_range_t<G>> &&        //
+         integral<vertex_id_t<G>> &&                              //
+         is_arithmetic_v<ranges::range_value_t<DistanceRange>> && //
+         edge_weight_function<G, EVF>
+[[nodiscard]] optional<vertex_id_t<G>> bellman_ford_shortest_distances(
+      G&&            g,
+      vertex_id_t<G> seed,
+      DistanceRange& distance,
+      EVF            weight_fn = [](edge_reference_t<G> uv) { return ranges::range_value_t<DistanceRange>(1); }) {
+  _null_predecessor_range_type predecessor; // don't evaluate predecessor
+  return bellman_ford_shortest_paths(g, seed, distance, predecessor, weight_fn);
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the shortest paths and distances to vertices reachable from a single seed vertex when
+ * edge weights can be negative, relaxing all edges of the graph in parallel in each pass.
+ * 
+ * The edges from views::edgelist are copied once to a flat array of {source_id, target_id, weight} so
+ * each pass is a linear, parallel scan of the array. Passes end early when one makes no change. If the
+ * |V|'th pass still makes a change there is a negative weight cycle. The sequential
+ * bellman_ford_shortest_paths() is then run to identify a vertex on the cycle.
+ * 
+ * The predecessors are assigned after the distances are final by a parallel search of the edges on
+ * shortest paths.
+ * 
+ * Complexity: O(|V||E|) worst case, with the work spread across the threads.
+ * 
+ * @tparam G                The graph type.
+ * @tparam DistanceRange    The distance range type. Its values must be usable with atomic_ref.
+ * @tparam PredecessorRange The predecessor range type.
+ * @tparam EVF              The edge value function that returns the weight of an edge.
+ * 
+ * @param g           The graph.
+ * @param seed        The single source vertex to start the search.
+ * @param distance    [inout] The distance[uid] of vertex_id uid from seed. distance[seed] == 0. The caller
+ *                    must assure size(distance) >= size(vertices(g)) and set the values to be 
+ *                    dijkstra_invalid_distance().
+ * @param predecessor [inout] The predecessor[uid] of vertex_id uid in path. predecessor[seed] == seed. The
+ *                    caller must assure size(predecessor) >= size(vertices(g)). It is only valid when
+ *                    distance[uid] != dijkstra_invalid_distance().
+ * @param weight_fn   The weight function object used to determine the distance between vertices on an
+ *                    edge. Return values may be negative.
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * 
+ * @return The id of a vertex on a negative weight cycle reachable from seed, or an empty optional if there
+ *         isn't one. The distances and predecessors aren't meaningful when a cycle is returned.
+ */
+template <adjacency_list              G,
+          ranges::random_access_range DistanceRange,
+          ranges::random_access_range PredecessorRange,
+          class EVF = std::function<ranges::range_value_t<DistanceRange>(edge_reference_t<G>)>>
+requires ranges::random_access_range<vertex_range_t<G>> &&        //
+         integral<vertex_id_t<G>> &&                              //
+         is_arithmetic_v<ranges::range_value_t<DistanceRange>> && //
+         edge_weight_function<G, EVF>
+[[nodiscard]] optional<vertex_id_t<G>> parallel_bellman_ford_shortest_paths(
+      G&&               g,
+      vertex_id_t<G>    seed,
+      DistanceRange&    distance,
+      PredecessorRange& predecessor,
+      EVF               weight_fn   = [](edge_reference_t<G> uv) { return ranges::range_value_t<DistanceRange>(1); },
+      size_t            num_threads = 0) {
+  using id_type       = vertex_id_t<G>;
+  using distance_type = ranges::range_value_t<DistanceRange>;
+  using weight_type   = remove_cvref_t<invoke_result_t<EVF, edge_reference_t<G>>>;
+  using edge_type     = copyable_edge_t<id_type, weight_type>;
+
+  const size_t V = ranges::size(vertices(g));
+  assert(size(distance) >= V);
+  assert(seed >= 0 && static_cast<size_t>(seed) < V);
+  const size_t         grain   = 4096; // edges per chunk of work
+  const distance_type  invalid = numeric_limits<distance_type>::max();
+  _detail::thread_team team(num_threads);
+
+  vector<edge_type> edge_list;
+  for (auto&& [uid, vid, uv, w] : views::edgelist(g, weight_fn))
+    edge_list.push_back({uid, vid, w});
+
+  distance[seed] = distance_type();
+  bool changed   = true;
+  for (size_t pass = 0; pass < V && changed; ++pass) {
+    atomic<bool> pass_changed = false;
+    team.for_each_chunk(edge_list.size(), grain, [&](size_t, size_t first, size_t last) {
+      bool chunk_changed = false;
+      for (size_t i = first; i < last; ++i) {
+        const edge_type&    e  = edge_list[i];
+        const distance_type du = atomic_ref<distance_type>(distance[e.source_id]).load(memory_order_relaxed);
+        if (du == invalid)
+          continue;
+        if (_detail::atomic_min(distance[e.target_id], static_cast<distance_type>(du + e.value)))
+          chunk_changed = true;
+      }
+      if (chunk_changed)
+        pass_changed.store(true, memory_order_relaxed);
+    });
+    changed = pass_changed.load();
+  }
+
+  if (changed) { // changed in the |V|'th pass: find a vertex on the cycle
+    ranges::fill(distance, invalid);
+    return bellman_ford_shortest_paths(g, seed, distance, predecessor, weight_fn);
+  }
+
+  // predecessors: search from seed along edges where distance[uid] + w == distance[vid]
+  if constexpr (!is_same_v<PredecessorRange, _null_predecessor_range_type>) {
+    using id_list = vector<id_type>;
+    vector<uint8_t> visited(V, 0);
+    vector<id_list> found(team.size());
+    id_list         frontier(1, seed);
+    visited[seed]     = 1;
+    predecessor[seed] = seed;
+    while (!frontier.empty()) {
+      team.for_each_chunk(frontier.size(), 256, [&](size_t tid, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          const id_type uid = frontier[i];
+          for (auto&& [vid, uv, w] : views::incidence(g, uid, weight_fn)) {
+            if (static_cast<distance_type>(distance[uid] + w) == distance[vid] &&
+                !atomic_ref<uint8_t>(visited[vid]).exchange(1, memory_order_relaxed)) {
+              predecessor[vid] = uid;
+              found[tid].push_back(vid);
+            }
+          }
+        }
+      });
+      _detail::gather(team, frontier, [&](size_t tid) -> id_list& { return found[tid]; });
+    }
+  }
+  return nullopt;
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Get the vertex ids on a negative weight cycle found by bellman_ford_shortest_paths().
+ * 
+ * The ids are written in the order of the edges on the cycle: there is an edge from each id to the next,
+ * and from the last id to the first.
+ * 
+ * @tparam G                The graph type.
+ * @tparam PredecessorRange The predecessor range type.
+ * @tparam OutputIterator   The output iterator type for vertex ids.
+ * 
+ * @param g               The graph.
+ * @param predecessor     The predecessors assigned by bellman_ford_shortest_paths().
+ * @param cycle_vertex_id The value returned by bellman_ford_shortest_paths(). Nothing is written if it's empty.
+ * @param out_cycle       The output iterator that receives the vertex ids on the cycle.
+ * 
+ * @return The output iterator after the last id written.
+ */
+template <adjacency_list G, ranges::random_access_range PredecessorRange, output_iterator<vertex_id_t<G>> OutputIterator>
+requires integral<vertex_id_t<G>> && convertible_to<ranges::range_value_t<PredecessorRange>, vertex_id_t<G>>
+OutputIterator find_negative_cycle(G&&                              g,
+                                   const PredecessorRange&          predecessor,
+                                   const optional<vertex_id_t<G>>& cycle_vertex_id,
+                                   OutputIterator                   out_cycle) {
+  if (!cycle_vertex_id.has_value())
+    return out_cycle;
+  vector<vertex_id_t<G>> cycle; // in reverse edge order
+  vertex_id_t<G>         uid = *cycle_vertex_id;
+  do {
+    cycle.push_back(uid);
+    uid = static_cast<vertex_id_t<G>>(predecessor[uid]);
+  } while (uid != *cycle_vertex_id && cycle.size() <= ranges::size(vertices(g)));
+  return ranges::copy(cycle.rbegin(), cycle.rend(), out_cycle).out;
+}
+
+
 } // namespace std::graph
 
 #endif //GRAPH_SHORTEST_PATHS_HPP
@@ -0,0 +1,432 @@
+/**
+ * @file strongly_connected_components.hpp
+ *
+ * @brief Strongly connected components: Pearce's iterative variant of Tarjan's algorithm, and a parallel
+ * forward-backward search with coloring for graphs with a transpose.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/views/depth_first_search.hpp"
+#include "graph/detail/parallel.hpp"
+#include <vector>
+#include <atomic>
+#include <limits>
+#include <cassert>
+
+#ifndef GRAPH_STRONGLY_CONNECTED_COMPONENTS_HPP
+#  define GRAPH_STRONGLY_CONNECTED_COMPONENTS_HPP
+
+namespace std::graph {
+
+namespace _detail {
+  // Pearce's algorithm over the vertices that aren't skipped. index[uid] is left as the id of the component
+  // of uid, counting down from V-1 in the order the components are completed, for the vertices that aren't
+  // skipped; the index of a skipped vertex isn't used. Returns the number of components.
+  template <adjacency_list G, ranges::random_access_range IndexRange, class Skip>
+  size_t pearce_scc(G&& g, IndexRange& index, Skip&& skip) {
+    using vertex_id_type = vertex_id_t<G>;
+    using index_type     = ranges::range_value_t<IndexRange>;
+
+    const size_t V = ranges::size(vertices(g));
+
+    // index[uid] is 0 until uid is visited, then its index (from 1) while it's searched, then its
+    // component's id
+    vector<bool>           root(V);
+    vector<dfs_element<G>> dfs;     // the path from the seed
+    vector<vertex_id_type> pending; // visited vertices that aren't roots, with their component incomplete
+    size_t                 next = 1;
+    size_t                 c    = V - 1;
+    for (size_t uid = 0; uid < V; ++uid)
+      index[uid] = 0;
+
+    auto visit = [&](vertex_id_type uid) {
+      index[uid] = static_cast<index_type>(next++);
+      root[uid]  = true;
+      dfs.push_back({uid, ranges::begin(edges(g, uid))});
+    };
+    // u has an edge to v, or v is a child of u in the search
+    auto reach = [&](vertex_id_type uid, vertex_id_type vid) {
+      if (index[vid] < index[uid]) {
+        index[uid] = index[vid];
+        root[uid]  = false;
+      }
+    };
+
+    for (size_t seed = 0; seed < V; ++seed) {
+      if (index[seed] != 0 || skip(seed))
+        continue;
+      visit(static_cast<vertex_id_type>(seed));
+      while (!dfs.empty()) {
+        auto& [uid, uv] = dfs.back();
+        if (uv != ranges::end(edges(g, uid))) {
+          const vertex_id_type vid = static_cast<vertex_id_type>(target_id(g, *uv));
+          ++uv;
+          if (skip(static_cast<size_t>(vid)))
+            continue;
+          if (index[vid] == 0)
+            visit(vid); // invalidates uid & uv
+          else
+            reach(uid, vid);
+          continue;
+        }
+
+        const vertex_id_type u = uid;
+        dfs.pop_back();
+        if (root[u]) {
+          // u and the pending vertices found after it are its component
+          --next;
+          while (!pending.empty() && index[u] <= index[pending.back()]) {
+            index[pending.back()] = static_cast<index_type>(c);
+            pending.pop_back();
+            --next;
+          }
+          index[u] = static_cast<index_type>(c--);
+        } else {
+          pending.push_back(u);
+        }
+        if (!dfs.empty())
+          reach(dfs.back().u_id, u);
+      }
+    }
+    return V - 1 - c;
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the strongly connected components of a graph.
+ *
+ * This is Pearce's space-efficient variant of Tarjan's algorithm ("A space-efficient algorithm for
+ * finding strongly connected components", 2016). Tarjan's separate discovery index, low-link and
+ * on-stack arrays are replaced by a single index array, which is the component range itself, and a bit
+ * per vertex that tells if the vertex is the root of its component. Indexes are reused once a component
+ * is complete and the vertices of a completed component are given ids that count down from |V|-1, so
+ * they never compare less than the index of a vertex still being searched.
+ *
+ * The depth-first search keeps a dfs_element (vertex id and edge iterator) for each vertex on the path
+ * from the seed in an explicit stack rather than recursing, so the depth of the search is only limited
+ * by memory.
+ *
+ * Component ids are assigned as components are completed, which is a reverse topological order of the
+ * condensed graph: for each edge (u,v), component[u] >= component[v].
+ *
+ * Complexity: O(|V| + |E|)
+ *
+ * @tparam G              The graph type.
+ * @tparam ComponentRange The component range type. Its values must be integral and able to hold
+ *                        size(vertices(g)).
+ *
+ * @param g         The graph.
+ * @param component [out] component[uid] is the component id of uid, in [0, number of components). The
+ *                  caller must assure size(component) >= size(vertices(g)).
+ * @return The number of components.
+ */
+template <adjacency_list G, ranges::random_access_range ComponentRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         integral<ranges::range_value_t<ComponentRange>>
+size_t strongly_connected_components(G&& g, ComponentRange& component) {
+  using comp_type = ranges::range_value_t<ComponentRange>;
+
+  const size_t V = ranges::size(vertices(g));
+  assert(static_cast<size_t>(ranges::size(component)) >= V);
+  const size_t count = _detail::pearce_scc(g, component, [](size_t) { return false; });
+
+  // number the components from 0 in the order they were completed
+  for (size_t uid = 0; uid < V; ++uid)
+    component[uid] = static_cast<comp_type>(V - 1 - static_cast<size_t>(component[uid]));
+  return count;
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Find the strongly connected components of a graph in parallel, given its transpose.
+ *
+ * The components are removed from the graph in three ways, with the work of each spread across the
+ * threads:
+ *   1. Trimming: a vertex without incoming or outgoing edges to the remaining vertices is a component
+ *      by itself. This is repeated while it removes a significant part of the vertices.
+ *   2. Forward-backward: the vertices reachable from a pivot in g that can also reach it (reachable in
+ *      gt) are a component. This is done once, from the vertex with the largest product of in- and
+ *      out-degree, to remove the largest component of most graphs in a single pair of breadth-first
+ *      searches.
+ *   3. Coloring: each remaining vertex takes the smallest id of the vertices that reach it, by
+ *      propagating ids along the edges until nothing changes. Each vertex whose color is its own id is
+ *      a root, and the vertices of its color that reach it (a search in gt) are its component. The
+ *      searches of the roots are spread across the threads. This is repeated, with trimming, while it
+ *      completes a significant part of the remaining vertices.
+ *   4. The components of the vertices that remain, if any, are found by Pearce's algorithm on one
+ *      thread. This bounds the time for graphs that coloring handles poorly, such as long chains of
+ *      small components, where each round only completes the components at the head of a chain.
+ *
+ * Use strongly_connected_components(g, component) for a reverse topological order of the components.
+ *
+ * Complexity: O((|V| + |E|) * r) where r is the number of coloring rounds and propagation steps, which
+ * is bounded, with the work of the first three steps spread across the threads.
+ *
+ * @tparam G              The graph type.
+ * @tparam GT             The transpose graph type.
+ * @tparam ComponentRange The component range type. Its values must be integral, able to hold
+ *                        size(vertices(g)) and usable with atomic_ref.
+ *
+ * @param g           The graph.
+ * @param gt          The transpose of g, with an edge (v,u) for each edge (u,v) in g.
+ * @param component   [out] component[uid] is the smallest vertex id in the component of uid. The caller
+ *                    must assure size(component) >= size(vertices(g)).
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of components.
+ */
+template <adjacency_list G, adjacency_list GT, ranges::contiguous_range ComponentRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         ranges::random_access_range<vertex_range_t<GT>> && integral<vertex_id_t<GT>> &&
+         integral<ranges::range_value_t<ComponentRange>>
+size_t strongly_connected_components(G&& g, GT&& gt, ComponentRange& component, size_t num_threads = 0) {
+  using vertex_id_type = vertex_id_t<G>;
+  using comp_type      = ranges::range_value_t<ComponentRange>;
+  using id_list        = vector<vertex_id_type>;
+  constexpr comp_type none      = numeric_limits<comp_type>::max(); // not in a component yet
+  constexpr size_t    grain     = 1024;                             // vertices per chunk of work
+  constexpr size_t    max_steps = 64;                               // propagation steps in a coloring round
+
+  const size_t V = ranges::size(vertices(g));
+  assert(ranges::size(vertices(gt)) == V);
+  assert(static_cast<size_t>(ranges::size(component)) >= V);
+  assert(V < static_cast<size_t>(none));
+  if (V == 0)
+    return 0;
+
+  comp_type* comp   = ranges::data(component);
+  auto       load   = [](comp_type& x) { return atomic_ref<comp_type>(x).load(memory_order_relaxed); };
+  auto       active = [&](size_t uid) { return load(comp[uid]) == none; };
+
+  struct alignas(64) thread_count {
+    size_t n = 0;
+  };
+  _detail::thread_team team(num_threads);
+  vector<thread_count> counts(team.size());
+  vector<id_list>      next(team.size());
+  auto                 sum_counts = [&counts]() {
+    size_t n = 0;
+    for (auto&& c : counts)
+      n += exchange(c.n, size_t(0));
+    return n;
+  };
+
+  team.for_each_chunk(V, grain * 16, [&](size_t, size_t first, size_t last) {
+    for (size_t uid = first; uid < last; ++uid)
+      comp[uid] = none;
+  });
+  size_t remaining = V;
+
+  // 1. Trimming. Other threads may trim the neighbors of a vertex while it's checked, which only trims
+  //    more of the vertices in the same pass.
+  auto has_active = [&](auto&& gx, size_t uid) {
+    for (auto&& uv : edges(gx, static_cast<vertex_id_t<decltype(gx)>>(uid))) {
+      const size_t vid = static_cast<size_t>(target_id(gx, uv));
+      if (vid != uid && active(vid))
+        return true;
+    }
+    return false;
+  };
+  auto trim = [&]() {
+    for (;;) {
+      team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+        size_t n = 0;
+        for (size_t uid = first; uid < last; ++uid) {
+          if (active(uid) && (!has_active(g, uid) || !has_active(gt, uid))) {
+            atomic_ref<comp_type>(comp[uid]).store(static_cast<comp_type>(uid), memory_order_relaxed);
+            ++n;
+          }
+        }
+        counts[tid].n += n;
+      });
+      const size_t trimmed = sum_counts();
+      remaining -= trimmed;
+      if (trimmed == 0 || trimmed < remaining / 16)
+        return;
+    }
+  };
+  trim();
+
+  // 2. Forward-backward search from the pivot. mark[uid] is 1 when uid is reached from the pivot and 2
+  //    when it also reaches the pivot.
+  if (remaining > 0) {
+    struct alignas(64) thread_pivot {
+      size_t score = 0;
+      size_t uid   = 0;
+    };
+    vector<thread_pivot> pivots(team.size());
+    team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid) {
+        if (!active(uid))
+          continue;
+        const size_t score = static_cast<size_t>(ranges::distance(edges(g, static_cast<vertex_id_type>(uid)))) *
+                             static_cast<size_t>(ranges::distance(edges(gt, static_cast<vertex_id_t<GT>>(uid))));
+        if (score >= pivots[tid].score)
+          pivots[tid] = {score + 1, uid};
+      }
+    });
+    const size_t pivot = ranges::max(pivots, {}, &thread_pivot::score).uid;
+
+    vector<uint8_t> mark(V, 0);
+    id_list         frontier;
+    auto            search = [&](auto&& gx, uint8_t from, uint8_t to) {
+      mark[pivot] = to;
+      frontier.assign(1, static_cast<vertex_id_type>(pivot));
+      size_t reached = 1;
+      while (!frontier.empty()) {
+        const bool inline_step = frontier.size() <= 64; // expanded by the calling thread only
+        team.for_each_chunk(frontier.size(), 64, [&](size_t tid, size_t first, size_t last) {
+          for (size_t i = first; i < last; ++i) {
+            for (auto&& uv : edges(gx, static_cast<vertex_id_t<decltype(gx)>>(frontier[i]))) {
+              const size_t vid  = static_cast<size_t>(target_id(gx, uv));
+              uint8_t      seen = from;
+              if (atomic_ref<uint8_t>(mark[vid]).load(memory_order_relaxed) == from && active(vid) &&
+                  atomic_ref<uint8_t>(mark[vid]).compare_exchange_strong(seen, to, memory_order_relaxed))
+                next[tid].push_back(static_cast<vertex_id_type>(vid));
+            }
+          }
+        });
+        if (inline_step) {
+          frontier.swap(next[0]);
+          next[0].clear();
+        } else {
+          _detail::gather(team, frontier, [&](size_t tid) -> id_list& { return next[tid]; });
+        }
+        reached += frontier.size();
+      }
+      return reached;
+    };
+    search(g, 0, 1);
+    remaining -= search(gt, 1, 2);
+
+    // the component is labelled with its smallest vertex id
+    struct alignas(64) thread_min {
+      size_t uid = numeric_limits<size_t>::max();
+    };
+    vector<thread_min> mins(team.size());
+    team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid)
+        if (mark[uid] == 2) {
+          mins[tid].uid = min(mins[tid].uid, uid);
+          break;
+        }
+    });
+    const auto label = static_cast<comp_type>(ranges::min(mins, {}, &thread_min::uid).uid);
+    team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid)
+        if (mark[uid] == 2)
+          comp[uid] = label;
+    });
+  }
+
+  // 3. Coloring. color[uid] is the smallest id of the remaining vertices that reach uid, or none.
+  vector<comp_type> color(V);
+  id_list           roots;
+  vector<id_list>   stacks(team.size());
+  while (remaining > 0) {
+    trim();
+    if (remaining == 0)
+      break;
+    const size_t before = remaining;
+
+    team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid)
+        color[uid] = active(uid) ? static_cast<comp_type>(uid) : none;
+    });
+
+    // pull the smallest color of the incoming edges; each color is written by one thread only, and the
+    // colors read from other chunks may already be from this step, which only converges sooner
+    size_t changed, steps = 0;
+    do {
+      team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+        size_t n = 0;
+        for (size_t vid = first; vid < last; ++vid) {
+          comp_type c = color[vid];
+          if (c == none)
+            continue;
+          for (auto&& vu : edges(gt, static_cast<vertex_id_t<GT>>(vid)))
+            c = min(c, load(color[static_cast<size_t>(target_id(gt, vu))]));
+          if (c < color[vid]) {
+            atomic_ref<comp_type>(color[vid]).store(c, memory_order_relaxed);
+            ++n;
+          }
+        }
+        counts[tid].n += n;
+      });
+      changed = sum_counts();
+    } while (changed > 0 && ++steps < max_steps);
+    if (changed > 0)
+      break;
+
+    team.for_each_chunk(V, grain, [&](size_t tid, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid)
+        if (color[uid] == static_cast<comp_type>(uid))
+          next[tid].push_back(static_cast<vertex_id_type>(uid));
+    });
+    _detail::gather(team, roots, [&](size_t tid) -> id_list& { return next[tid]; });
+
+    // the component of each root is the vertices of its color that reach it. Only the search for a root
+    // visits the vertices of its color, so the searches don't interfere.
+    team.for_each_chunk(roots.size(), 1, [&](size_t tid, size_t first, size_t last) {
+      id_list& stack = stacks[tid];
+      size_t   n     = 0;
+      for (size_t i = first; i < last; ++i) {
+        const comp_type r = static_cast<comp_type>(roots[i]);
+        atomic_ref<comp_type>(comp[roots[i]]).store(r, memory_order_relaxed);
+        stack.assign(1, roots[i]);
+        ++n;
+        while (!stack.empty()) {
+          const vertex_id_type uid = stack.back();
+          stack.pop_back();
+          for (auto&& uv : edges(gt, static_cast<vertex_id_t<GT>>(uid))) {
+            const size_t vid = static_cast<size_t>(target_id(gt, uv));
+            if (color[vid] == r && load(comp[vid]) == none) {
+              atomic_ref<comp_type>(comp[vid]).store(r, memory_order_relaxed);
+              stack.push_back(static_cast<vertex_id_type>(vid));
+              ++n;
+            }
+          }
+        }
+      }
+      counts[tid].n += n;
+    });
+    remaining -= sum_counts();
+    if (before - remaining < before / 16)
+      break;
+  }
+
+  // 4. Pearce's algorithm on the remaining vertices, when coloring stops making progress. The components
+  //    are labelled with their first vertex in id order.
+  if (remaining > 0) {
+    vector<comp_type> index(V);
+    auto              skip = [comp](size_t uid) { return comp[uid] != none; };
+    _detail::pearce_scc(g, index, skip);
+    ranges::fill(color, none);
+    for (size_t uid = 0; uid < V; ++uid)
+      if (!skip(uid) && color[static_cast<size_t>(index[uid])] == none)
+        color[static_cast<size_t>(index[uid])] = static_cast<comp_type>(uid);
+    for (size_t uid = 0; uid < V; ++uid)
+      if (!skip(uid))
+        comp[uid] = color[static_cast<size_t>(index[uid])];
+  }
+
+  team.for_each_chunk(V, grain * 16, [&](size_t tid, size_t first, size_t last) {
+    size_t n = 0;
+    for (size_t uid = first; uid < last; ++uid)
+      n += (static_cast<size_t>(comp[uid]) == uid);
+    counts[tid].n += n;
+  });
+  return sum_counts();
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_STRONGLY_CONNECTED_COMPONENTS_HPP
@@ -3,7 +3,13 @@
 #include "graph/graph.hpp"
 #include "graph/views/vertexlist.hpp"
 #include "graph/views/incidence.hpp"
+#include "graph/algorithm/strongly_connected_components.hpp"
 #include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 
 namespace std::graph {
 
@@ -20,7 +26,23 @@ struct reaches {
  * 
  * Transitive closure returns all vertices that can be reached from a source vertex,
  * for all source vertices. This algorithm specializes on a dense graph using
- * Warshall's algorithm. Complexity is O(n^3).
+ * Warshall's algorithm. Complexity is O(n^3/w) for a word size of w=64.
+ * 
+ * The reachability matrix is stored as rows of 64-bit words, so the innermost loop is a
+ * word-level row union (if u reaches k then row u |= row k) that compilers vectorize.
+ * The k's are processed in blocks of 64 so the block's rows stay in cache while all other
+ * rows are updated, and each row update is applied in column tiles.
+ * 
+ * A vertex only reaches itself if it's on a cycle or has a self-loop.
+ * 
+ * @tparam G       The graph type.
+ * @tparam OutIter The output iterator type that receives reaches<G> values.
+ * @tparam Alloc   The allocator type. It's rebound to allocate the words of the matrix.
+ * 
+ * @param g           The graph.
+ * @param result_iter The output iterator that receives a reaches<G>{from,to} for each pair
+ *                    of vertices where to is reachable from from, ordered by from then to.
+ * @param alloc       The allocator to use for the reachability matrix.
  */
 // clang-format off
 template <adjacency_list G, typename OutIter, typename Alloc = allocator<bool>>
@@ -32,25 +54,204 @@ template <adjacency_list G, typename OutIter, typename Alloc = allocator<bool>>
 constexpr void warshall_transitive_closure(G& g, OutIter result_iter, Alloc alloc = Alloc()) {
   using views::vertexlist;
   using views::incidence;
-  const size_t      V = ranges::size(g);
-  std::vector<bool> reach(V * V, alloc); // adjacency matrix bitmap
+  using word_type       = uint64_t;
+  using word_alloc_type = typename allocator_traits<Alloc>::template rebind_alloc<word_type>;
+  constexpr size_t bits       = numeric_limits<word_type>::digits; // bits/word & vertices in a block of k's
+  constexpr size_t tile_words = 256;                               // words in a column tile of a row update
+
+  const size_t V = ranges::size(vertices(g));
+  const size_t W = (V + bits - 1) / bits; // words per row
+  vector<word_type, word_alloc_type> reach(V * W, word_type(0), word_alloc_type(alloc)); // adjacency matrix bitmap
+
+  auto row     = [&reach, W](size_t uid) { return reach.data() + uid * W; };
+  auto has_bit = [](const word_type* r, size_t vid) { return (r[vid / bits] >> (vid % bits)) & 1u; };
 
   // transform edges into adjacency matrix bitmap
-  for (auto&& [uid, u] : vertexlist(g))
+  for (auto&& [uid, u] : vertexlist(g)) {
+    word_type* ru = row(static_cast<size_t>(uid));
     for (auto&& [vid, uv] : incidence(g, uid))
-      reach[uid * V + vid] = true;
+      ru[static_cast<size_t>(vid) / bits] |= word_type(1) << (static_cast<size_t>(vid) % bits);
+  }
+
+  // evaluate transitive closure, one block of 64 k's (word kw of each row) at a time
+  for (size_t kb = 0; kb < V; kb += bits) {
+    const size_t kw = kb / bits;
+    const size_t ke = min(kb + bits, V);
 
-  // evaluate transitive closure
-  for (auto&& [kid, k] : vertexlist(g))
-    for (auto&& [uid, u] : vertexlist(g))
-      for (auto&& [vid, v] : vertexlist(g))
-        reach[uid * V] = reach[uid * V + vid] || (reach[uid * V + kid] && reach[kid * V + vid]);
+    // rows in the block, in k order
+    for (size_t kid = kb; kid < ke; ++kid) {
+      const word_type* rk = row(kid);
+      for (size_t uid = kb; uid < ke; ++uid) {
+        if (has_bit(row(uid), kid)) {
+          word_type* ru = row(uid);
+          for (size_t w = 0; w < W; ++w)
+            ru[w] |= rk[w];
+        }
+      }
+    }
+
+    // all other rows. The k's used for row u only depend on word kw, so they're found first
+    // and then the rows for them are or'd into row u one tile at a time.
+    for (size_t uid = 0; uid < V; ++uid) {
+      if (uid == kb) {
+        uid = ke - 1;
+        continue;
+      }
+      word_type* ru   = row(uid);
+      word_type  mask = ru[kw];
+      word_type  used = 0;
+      for (size_t kid = kb; kid < ke; ++kid) {
+        const word_type kbit = word_type(1) << (kid - kb);
+        if (mask & kbit) {
+          used |= kbit;
+          mask |= row(kid)[kw];
+        }
+      }
+      for (size_t w0 = 0; used && w0 < W; w0 += tile_words) {
+        const size_t w1 = min(w0 + tile_words, W);
+        for (word_type ks = used; ks; ks &= ks - 1) {
+          const word_type* rk = row(kb + static_cast<size_t>(countr_zero(ks)));
+          for (size_t w = w0; w < w1; ++w)
+            ru[w] |= rk[w];
+        }
+      }
+    }
+  }
 
   // output results
-  for (auto&& [uid, u] : vertexlist(g))
-    for (auto&& [vid, v] : vertexlist(g))
-      if (reach[uid * V + vid])
-        *result_iter = {uid, vid};
+  for (size_t uid = 0; uid < V; ++uid) {
+    const word_type* ru = row(uid);
+    for (size_t w = 0; w < W; ++w)
+      for (word_type ws = ru[w]; ws; ws &= ws - 1)
+        *result_iter++ = reaches<G>{static_cast<vertex_id_t<G>>(uid),
+                                    static_cast<vertex_id_t<G>>(w * bits + static_cast<size_t>(countr_zero(ws)))};
+  }
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Transitive closure of a graph using the condensation of its strongly connected components,
+ *        for sparse graphs.
+ * 
+ * All vertices in a strongly connected component (SCC) reach the same vertices, so the closure is
+ * evaluated on the condensed graph of components. The components are found with Pearce's variant of
+ * Tarjan's algorithm, which also gives them a reverse topological order. The set of components reachable
+ * from each component is the union of the sets of its successors, which is evaluated as a bitset union in
+ * that order. The (from,to) pairs are then streamed for the vertices of each pair of components.
+ * 
+ * The bitsets only cover a window of target components at a time so the memory used is bounded for
+ * large graphs; a window covers all components when they fit in the memory limit.
+ * 
+ * A vertex only reaches itself if it's on a cycle or has a self-loop.
+ * 
+ * Complexity: O(|V| + |E| + C*E'/w + R) where C is the number of components, E' is the number of edges
+ * between components, w=64 is the word size and R is the number of results.
+ * 
+ * @tparam G       The graph type.
+ * @tparam OutIter The output iterator type that receives reaches<G> values.
+ * @tparam Alloc   The allocator type. It's rebound to allocate the words of the bitsets.
+ * 
+ * @param g           The graph.
+ * @param result_iter The output iterator that receives a reaches<G>{from,to} for each pair of vertices
+ *                    where to is reachable from from. The order of the pairs is unspecified.
+ * @param alloc       The allocator to use for the bitsets.
+ */
+// clang-format off
+template <adjacency_list G, typename OutIter, typename Alloc = allocator<bool>>
+  requires ranges::random_access_range<vertex_range_t<G>> && 
+           integral<vertex_id_t<G>> && 
+           output_iterator<OutIter, reaches<G>>
+// clang-format on
+void dfs_transitive_closure(G& g, OutIter result_iter, Alloc alloc = Alloc()) {
+  using vertex_id_type  = vertex_id_t<G>;
+  using word_type       = uint64_t;
+  using word_alloc_type = typename allocator_traits<Alloc>::template rebind_alloc<word_type>;
+  constexpr size_t bits         = numeric_limits<word_type>::digits;
+  constexpr size_t memory_limit = size_t(64) << 20; // bytes used by bitsets for a window
+
+  const size_t V = ranges::size(vertices(g));
+  if (V == 0)
+    return;
+
+  // strongly connected components, in reverse topological order
+  vector<size_t> component(V);
+  const size_t   C = strongly_connected_components(g, component);
+
+  // vertices of each component: members[member_first[c] .. member_first[c+1])
+  vector<size_t>         member_first(C + 1, 0);
+  vector<vertex_id_type> members(V);
+  for (size_t uid = 0; uid < V; ++uid)
+    ++member_first[component[uid] + 1];
+  for (size_t c = 0; c < C; ++c)
+    member_first[c + 1] += member_first[c];
+  {
+    vector<size_t> pos(member_first.begin(), member_first.end() - 1);
+    for (size_t uid = 0; uid < V; ++uid)
+      members[pos[component[uid]]++] = static_cast<vertex_id_type>(uid);
+  }
+
+  // condensed graph: successors[succ_first[c] .. succ_first[c+1]) and whether a component has a cycle
+  vector<uint8_t> cyclic(C, 0);
+  vector<size_t>  succ_first(C + 1, 0);
+  vector<size_t>  successors;
+  for (size_t c = 0; c < C; ++c) {
+    cyclic[c] = (member_first[c + 1] - member_first[c]) > 1;
+    for (size_t m = member_first[c]; m < member_first[c + 1]; ++m) {
+      const vertex_id_type uid = members[m];
+      for (auto&& uv : edges(g, uid)) {
+        const size_t vc = component[static_cast<size_t>(target_id(g, uv))];
+        if (vc != c)
+          successors.push_back(vc);
+        else if (static_cast<vertex_id_type>(target_id(g, uv)) == uid)
+          cyclic[c] = 1; // self-loop
+      }
+    }
+    auto first = successors.begin() + static_cast<ptrdiff_t>(succ_first[c]);
+    ranges::sort(first, successors.end());
+    successors.erase(ranges::unique(first, successors.end()).begin(), successors.end());
+    succ_first[c + 1] = successors.size();
+  }
+
+  // reachable components, for a window [lo,hi) of target components at a time
+  const size_t total_words  = (C + bits - 1) / bits;
+  const size_t window_words = clamp(memory_limit / (sizeof(word_type) * C), size_t(1), total_words);
+  vector<word_type, word_alloc_type> reach{word_alloc_type(alloc)};
+  for (size_t w0 = 0; w0 < total_words; w0 += window_words) {
+    const size_t nw = min(window_words, total_words - w0);
+    const size_t lo = w0 * bits;
+    const size_t hi = min(lo + nw * bits, C);
+
+    // only components >= lo can reach the window, since successors have lower ids
+    reach.assign((C - lo) * nw, word_type(0));
+    auto row     = [&reach, lo, nw](size_t c) { return reach.data() + (c - lo) * nw; };
+    auto set_bit = [lo](word_type* r, size_t c) { r[(c - lo) / bits] |= word_type(1) << ((c - lo) % bits); };
+
+    for (size_t c = lo; c < C; ++c) {
+      word_type* rc = row(c);
+      if (cyclic[c] && c < hi)
+        set_bit(rc, c);
+      for (size_t s = succ_first[c]; s < succ_first[c + 1]; ++s) {
+        const size_t sc = successors[s];
+        if (sc < lo)
+          continue;
+        const word_type* rs = row(sc);
+        for (size_t w = 0; w < nw; ++w)
+          rc[w] |= rs[w];
+        if (sc < hi)
+          set_bit(rc, sc);
+      }
+
+      // output results for the vertices in c and the reachable components in the window
+      for (size_t w = 0; w < nw; ++w) {
+        for (word_type ws = rc[w]; ws; ws &= ws - 1) {
+          const size_t tc = lo + w * bits + static_cast<size_t>(countr_zero(ws));
+          for (size_t m = member_first[c]; m < member_first[c + 1]; ++m)
+            for (size_t t = member_first[tc]; t < member_first[tc + 1]; ++t)
+              *result_iter++ = reaches<G>{members[m], members[t]};
+        }
+      }
+    }
+  }
 }
 
 } // namespace std::graph
@@ -0,0 +1,313 @@
+/**
+ * @file triangle_count.hpp
+ *
+ * @brief Parallel triangle counting, for the whole graph and for each vertex.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/detail/parallel.hpp"
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <numeric>
+#include <bit>
+#include <cstdint>
+#include <cassert>
+
+// The AVX2 intersection is used when compiling for AVX2, or is chosen at run time on x86 with GCC or Clang
+#if defined(__AVX2__) || (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)))
+#  define GRAPH_TRIANGLE_COUNT_AVX2
+#  include <immintrin.h>
+#endif
+
+#ifndef GRAPH_TRIANGLE_COUNT_HPP
+#  define GRAPH_TRIANGLE_COUNT_HPP
+
+namespace std::graph {
+
+namespace _detail {
+  // A vertex is oriented towards its neighbors with a larger (degree, id); the lists of a
+  // degree-oriented graph are sorted by id, without duplicates or self-loops.
+  template <class VId>
+  struct oriented_graph {
+    vector<size_t> first; // first[u], last[u] bound the out-neighbors of u in targets
+    vector<size_t> last;
+    vector<VId>    targets;
+  };
+
+  template <adjacency_list G>
+  auto orient_by_degree(G&& g, thread_team& team) {
+    using vertex_id_type = vertex_id_t<G>;
+    constexpr size_t grain = 256; // vertices per chunk of work
+
+    const size_t                   V = ranges::size(vertices(g));
+    oriented_graph<vertex_id_type> dag;
+    vector<size_t>                 degree(V);
+    dag.first.assign(V + 1, 0);
+    dag.last.resize(V);
+
+    team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid)
+        degree[uid] = static_cast<size_t>(ranges::distance(edges(g, static_cast<vertex_id_type>(uid))));
+    });
+    auto before = [&degree](size_t uid, size_t vid) {
+      return degree[uid] < degree[vid] || (degree[uid] == degree[vid] && uid < vid);
+    };
+
+    // count, place and sort the out-neighbors of each vertex
+    team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid) {
+        size_t n = 0;
+        for (auto&& uv : edges(g, static_cast<vertex_id_type>(uid)))
+          n += before(uid, static_cast<size_t>(target_id(g, uv)));
+        dag.first[uid + 1] = n;
+      }
+    });
+    inclusive_scan(dag.first.begin(), dag.first.end(), dag.first.begin());
+    dag.targets.resize(dag.first[V]);
+    team.for_each_chunk(V, grain, [&](size_t, size_t first, size_t last) {
+      for (size_t uid = first; uid < last; ++uid) {
+        auto out = dag.targets.begin() + static_cast<ptrdiff_t>(dag.first[uid]);
+        auto end = out;
+        for (auto&& uv : edges(g, static_cast<vertex_id_type>(uid))) {
+          const auto vid = static_cast<vertex_id_type>(target_id(g, uv));
+          if (before(uid, static_cast<size_t>(vid)))
+            *end++ = vid;
+        }
+        if (!is_sorted(out, end)) // rows of a csr_graph after sort_rows() already are
+          sort(out, end);
+        dag.last[uid] = dag.first[uid] + static_cast<size_t>(unique(out, end) - out);
+      }
+    });
+    return dag;
+  }
+
+  // Skewed lists are intersected by galloping when the larger one has this many times more elements
+  inline constexpr size_t gallop_ratio = 32;
+
+  // Intersect sorted lists by merging them. visit(w) is called for each common value w when Visit is
+  // true. Returns the number of common values.
+  template <bool Visit, class VId, class F>
+  size_t intersect_merge(const VId* a, const VId* a_end, const VId* b, const VId* b_end, F&& visit) {
+    size_t n = 0;
+    while (a != a_end && b != b_end) {
+      if (*a < *b)
+        ++a;
+      else if (*b < *a)
+        ++b;
+      else {
+        if constexpr (Visit)
+          visit(*a);
+        ++n, ++a, ++b;
+      }
+    }
+    return n;
+  }
+
+  // Intersect a short sorted list with a much longer one by searching for each value of the short
+  // list with an exponential search from the last position found in the long list.
+  template <bool Visit, class VId, class F>
+  size_t intersect_gallop(const VId* a, const VId* a_end, const VId* b, const VId* b_end, F&& visit) {
+    size_t n = 0;
+    for (; a != a_end && b != b_end; ++a) {
+      size_t step = 1;
+      while (step < static_cast<size_t>(b_end - b) && b[step] < *a)
+        step *= 2;
+      b = lower_bound(b + step / 2, b + min(step + 1, static_cast<size_t>(b_end - b)), *a);
+      if (b != b_end && *b == *a) {
+        if constexpr (Visit)
+          visit(*a);
+        ++n, ++b;
+      }
+    }
+    return n;
+  }
+
+#  if defined(GRAPH_TRIANGLE_COUNT_AVX2)
+  // Can intersect_avx2() be called on this CPU?
+  inline bool cpu_has_avx2() noexcept {
+#    if defined(__AVX2__)
+    return true;
+#    else
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+#    endif
+  }
+
+  // Intersect sorted lists of 32-bit values 8x8 at a time: each block of a is compared against the 8
+  // rotations of the block of b, and the block with the smaller last value is replaced. The rest is
+  // merged. With GCC and Clang it's compiled for AVX2 whatever the target, and must only be called when
+  // cpu_has_avx2().
+  template <bool Visit, class VId, class F>
+  requires(sizeof(VId) == 4)
+#    if defined(__GNUC__)
+  [[gnu::target("avx2")]]
+#    endif
+  size_t intersect_avx2(const VId* a, const VId* a_end, const VId* b, const VId* b_end, F&& visit) {
+    const __m256i rotate[7] = {
+          _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0), _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1),
+          _mm256_setr_epi32(3, 4, 5, 6, 7, 0, 1, 2), _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3),
+          _mm256_setr_epi32(5, 6, 7, 0, 1, 2, 3, 4), _mm256_setr_epi32(6, 7, 0, 1, 2, 3, 4, 5),
+          _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6)};
+    size_t n = 0;
+    while (a_end - a >= 8 && b_end - b >= 8) {
+      const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+      const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+      __m256i       eq = _mm256_cmpeq_epi32(va, vb);
+      for (const __m256i& r : rotate)
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, r)));
+      unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq))); // bit i: a[i] found
+      n += static_cast<size_t>(popcount(mask));
+      if constexpr (Visit)
+        for (; mask; mask &= mask - 1)
+          visit(a[countr_zero(mask)]);
+      const VId a_max = a[7], b_max = b[7];
+      if (a_max <= b_max)
+        a += 8;
+      if (b_max <= a_max)
+        b += 8;
+    }
+    return n + intersect_merge<Visit>(a, a_end, b, b_end, visit);
+  }
+#  endif
+
+  // Intersect sorted lists without duplicates with the kernel that suits their sizes
+  template <bool Visit, class VId, class F>
+  size_t intersect_sorted(const VId* a, const VId* a_end, const VId* b, const VId* b_end, F&& visit) {
+    const size_t na = static_cast<size_t>(a_end - a);
+    const size_t nb = static_cast<size_t>(b_end - b);
+    if (na == 0 || nb == 0)
+      return 0;
+    if (na * gallop_ratio < nb)
+      return intersect_gallop<Visit>(a, a_end, b, b_end, visit);
+    if (nb * gallop_ratio < na)
+      return intersect_gallop<Visit>(b, b_end, a, a_end, visit);
+#  if defined(GRAPH_TRIANGLE_COUNT_AVX2)
+    if constexpr (sizeof(VId) == 4)
+      if (cpu_has_avx2())
+        return intersect_avx2<Visit>(a, a_end, b, b_end, visit);
+#  endif
+    return intersect_merge<Visit>(a, a_end, b, b_end, visit);
+  }
+
+  // Find each triangle {u,v,w} once, as u->v, u->w, v->w in the degree-oriented graph, calling
+  // found(u,v,w) when Visit is true. Returns the number of triangles.
+  template <bool Visit, class VId, class F>
+  size_t for_each_triangle(const oriented_graph<VId>& dag, thread_team& team, F&& found) {
+    struct alignas(64) thread_count {
+      size_t n = 0;
+    };
+    vector<thread_count> counts(team.size());
+    team.for_each_chunk(dag.last.size(), 64, [&](size_t tid, size_t first, size_t last) {
+      size_t n = 0;
+      for (size_t uid = first; uid < last; ++uid) {
+        const VId* u_first = dag.targets.data() + dag.first[uid];
+        const VId* u_last  = dag.targets.data() + dag.last[uid];
+        for (const VId* v = u_first; v != u_last; ++v) {
+          const VId* v_first = dag.targets.data() + dag.first[static_cast<size_t>(*v)];
+          const VId* v_last  = dag.targets.data() + dag.last[static_cast<size_t>(*v)];
+          n += intersect_sorted<Visit>(u_first, u_last, v_first, v_last,
+                                       [&](VId w) { found(static_cast<VId>(uid), *v, w); });
+        }
+      }
+      counts[tid].n += n;
+    });
+    size_t total = 0;
+    for (auto&& c : counts)
+      total += c.n;
+    return total;
+  }
+} // namespace _detail
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Count the triangles in an undirected graph.
+ *
+ * Each edge is oriented from the endpoint with the smaller degree (then id) to the other, and the
+ * triangles are found by intersecting the sorted out-neighbors of the endpoints of each oriented edge.
+ * Each triangle is found once, and the out-degree of every vertex is O(sqrt(|E|)), so high-degree
+ * vertices don't dominate the work. The intersection merges lists of similar lengths, using AVX2 block
+ * compares when the vertex id is 32 bits and the CPU has AVX2 (checked at run time with GCC and Clang on
+ * x86; other compilers need e.g. /arch:AVX2), and searches a long list with galloping when the lengths
+ * are skewed.
+ *
+ * The work is spread across the threads with dynamic scheduling of the vertices. The oriented graph is
+ * built first, which holds |E|/2 vertex ids; its lists don't need to be sorted when the edges of each
+ * vertex are already ordered by target_id (e.g. after csr_graph::sort_rows()).
+ *
+ * Duplicate edges and self-loops are ignored.
+ *
+ * Complexity: O(|E|^1.5) in the worst case, with the work spread across the threads.
+ *
+ * @tparam G          The graph type.
+ *
+ * @param g           The graph. It must be undirected: each edge is stored in both directions.
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of triangles.
+ */
+template <adjacency_list G>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
+size_t triangle_count(G&& g, size_t num_threads = 0) {
+  using vertex_id_type = vertex_id_t<G>;
+  _detail::thread_team team(num_threads);
+  auto                 dag = _detail::orient_by_degree(g, team);
+  return _detail::for_each_triangle<false>(dag, team, [](vertex_id_type, vertex_id_type, vertex_id_type) {});
+}
+
+/**
+ * @ingroup graph_algorithms
+ * @brief Count the triangles that each vertex of an undirected graph is part of.
+ *
+ * This uses the same algorithm as triangle_count(g) and adds each triangle {u,v,w} found to the counts
+ * of u, v and w. The local clustering coefficient of a vertex u with degree d > 1 is then
+ * 2 * count[u] / (d * (d - 1)).
+ *
+ * Complexity: O(|E|^1.5) in the worst case, with the work spread across the threads.
+ *
+ * @tparam G          The graph type.
+ * @tparam CountRange The count range type. Its values must be integral and usable with atomic_ref.
+ *
+ * @param g           The graph. It must be undirected: each edge is stored in both directions.
+ * @param count       [out] count[uid] is the number of triangles that include uid. The caller must
+ *                    assure size(count) >= size(vertices(g)).
+ * @param num_threads The number of threads to use. If 0, the number of hardware threads is used.
+ * @return The number of triangles in the graph.
+ */
+template <adjacency_list G, ranges::random_access_range CountRange>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         integral<ranges::range_value_t<CountRange>>
+size_t local_triangle_count(G&& g, CountRange& count, size_t num_threads = 0) {
+  using vertex_id_type = vertex_id_t<G>;
+  using count_type     = ranges::range_value_t<CountRange>;
+  const size_t V       = ranges::size(vertices(g));
+  assert(static_cast<size_t>(ranges::size(count)) >= V);
+
+  _detail::thread_team team(num_threads);
+  auto                 dag = _detail::orient_by_degree(g, team);
+  team.for_each_chunk(V, 4096, [&](size_t, size_t first, size_t last) {
+    for (size_t uid = first; uid < last; ++uid)
+      count[uid] = count_type(0);
+  });
+
+  auto add = [&count](vertex_id_type id) {
+    atomic_ref<count_type>(count[static_cast<size_t>(id)]).fetch_add(count_type(1), memory_order_relaxed);
+  };
+  auto found = [&add](vertex_id_type uid, vertex_id_type vid, vertex_id_type wid) {
+    add(uid);
+    add(vid);
+    add(wid);
+  };
+  return _detail::for_each_triangle<true>(dag, team, found);
+}
+
+} // namespace std::graph
+
+#endif //GRAPH_TRIANGLE_COUNT_HPP
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "graph/graph.hpp"
+#include "graph/container/csr_graph.hpp"
+#include <initializer_list>
+#include <utility>
+
+// bidirectional_csr_graph: a csr_graph and its transpose, for in_edges(g,u)
+//
+// The outgoing edges are kept in compressed sparse rows (CSR) and the incoming edges in compressed
+// sparse columns (CSC), which is the transpose of the graph built by csr_graph::load_transpose(). The
+// transpose is rebuilt when the edges are loaded or deduplicated.
+//
+// examples: bidirectional_csr_graph<double> g;
+//           g.load_unsorted_edges(edge_list, identity());
+//           for (auto&& uv : in_edges(g, uid)) // target_id(g,uv) is the vertex uv comes from
+//             ...
+//
+//           page_rank(g, g.transpose_graph(), ranks);
+//
+namespace std::graph::container {
+
+/**
+ * @ingroup graph_containers
+ * @brief Compressed sparse row adjacency graph that also keeps the incoming edges of each vertex.
+ *
+ * The graph holds a csr_graph for its outgoing edges and the transpose graph for in_edges(g,u) and
+ * in_edges(g,uid), and has the same graph functions as a csr_graph. target_id(g,uv) of an incoming edge uv
+ * of u is the vertex the edge comes from. edge_value(g,uv) of an incoming edge is a copy of the value of
+ * the outgoing edge, made when the transpose was built, so changing one doesn't change the other. The
+ * transpose uses as much memory as the edges and their values, plus the row index.
+ *
+ * The two graphs are members rather than bases, so the edges can only be changed by the functions here,
+ * which keep the transpose in step. out_graph() gives read-only access to the csr_graph.
+ *
+ * @tparam EV Edge value type
+ * @tparam VV Vertex value type
+ * @tparam GV Graph value type
+ * @tparam VId Vertex Id type. This must be large enough for the count of vertices.
+ * @tparam EIndex Edge Index type. This must be large enough for the count of edges.
+ * @tparam Alloc Allocator type
+*/
+template <class EV        = void,
+          class VV        = void,
+          class GV        = void,
+          integral VId    = uint32_t,
+          integral EIndex = uint32_t,
+          class Alloc     = allocator<uint32_t>>
+class bidirectional_csr_graph {
+public: // Types
+  using graph_type     = bidirectional_csr_graph<EV, VV, GV, VId, EIndex, Alloc>;
+  using base_type      = csr_graph<EV, VV, GV, VId, EIndex, Alloc>;
+  using transpose_type = csr_graph<EV, void, void, VId, EIndex, Alloc>;
+
+  using edge_value_type   = EV;
+  using vertex_value_type = VV;
+  using graph_value_type  = GV;
+
+  using vertex_id_type      = VId;
+  using edge_index_type     = EIndex;
+  using size_type           = typename base_type::size_type;
+  using vertex_type         = typename base_type::vertex_type;
+  using edge_type           = typename base_type::edge_type;
+  using vertices_type       = typename base_type::vertices_type;
+  using const_vertices_type = typename base_type::const_vertices_type;
+  using const_iterator      = typename base_type::const_iterator;
+  using edges_type          = typename base_type::edges_type;
+  using const_edges_type    = typename base_type::const_edges_type;
+  using in_edges_type       = typename transpose_type::edges_type;
+  using const_in_edges_type = typename transpose_type::const_edges_type;
+
+public: // Construction/Destruction
+  constexpr bidirectional_csr_graph()                               = default;
+  constexpr bidirectional_csr_graph(const bidirectional_csr_graph&) = default;
+  constexpr bidirectional_csr_graph(bidirectional_csr_graph&&)      = default;
+  constexpr ~bidirectional_csr_graph()                              = default;
+
+  constexpr bidirectional_csr_graph& operator=(const bidirectional_csr_graph&) = default;
+  constexpr bidirectional_csr_graph& operator=(bidirectional_csr_graph&&)      = default;
+
+  /// <summary>
+  /// Add the incoming edges to a csr_graph.
+  /// </summary>
+  /// <param name="g">The graph, which is moved into this one.</param>
+  /// <param name="num_threads">The number of threads used to build the transpose. If 0, the number of
+  ///   hardware threads is used.</param>
+  explicit bidirectional_csr_graph(base_type&& g, size_t num_threads = 0) : out_(std::move(g)) {
+    build_transpose(num_threads);
+  }
+
+  bidirectional_csr_graph(const initializer_list<copyable_edge_t<VId, EV>>& ilist) : out_(ilist) {
+    build_transpose(0);
+  }
+
+public: // Operations
+  // The functions of csr_graph that change the edges, followed by rebuilding the transpose
+
+  template <class ERng, class EProj = identity>
+  void load_edges(ERng&& erng, EProj eprojection = {}, size_t vertex_count = 0, size_t edge_count = 0) {
+    out_.load_edges(std::forward<ERng>(erng), eprojection, vertex_count, edge_count);
+    build_transpose(0);
+  }
+
+  template <ranges::forward_range ERng, class EProj = identity>
+  void load_unsorted_edges(const ERng& erng, EProj eprojection = {}, size_t vertex_count = 0, size_t num_threads = 0) {
+    out_.load_unsorted_edges(erng, eprojection, vertex_count, num_threads);
+    build_transpose(num_threads);
+  }
+
+  template <ranges::forward_range ERng, ranges::forward_range VRng, class EProj = identity, class VProj = identity>
+  void load(const ERng& erng, const VRng& vrng, EProj eprojection = {}, VProj vprojection = {}) {
+    out_.load(erng, vrng, eprojection, vprojection);
+    build_transpose(0);
+  }
+
+  /// <summary>
+  /// Order the outgoing edges of each vertex by target id and the incoming edges by source id. See
+  /// csr_graph::sort_rows().
+  /// </summary>
+  void sort_rows(size_t num_threads = 0) {
+    out_.sort_rows(num_threads);
+    transpose_.sort_rows(num_threads);
+  }
+
+  void dedup_rows(size_t num_threads = 0) {
+    out_.dedup_rows(num_threads);
+    build_transpose(num_threads);
+  }
+
+  template <class Reduce>
+  requires is_void_v<EV> || regular_invocable<Reduce&, const EV&, const EV&>
+  void dedup_rows(Reduce reduce, size_t num_threads = 0) {
+    out_.dedup_rows(reduce, num_threads);
+    build_transpose(num_threads);
+  }
+
+  // The functions of csr_graph that don't change the edges
+
+  template <class VRng, class VProj = identity>
+  constexpr void load_vertices(VRng&& vrng, VProj vprojection = {}, size_type vertex_count = 0) {
+    out_.load_vertices(std::forward<VRng>(vrng), vprojection, vertex_count);
+  }
+
+  void index_edges(size_type hub_degree = 256) { out_.index_edges(hub_degree); }
+  void clear_edge_index() noexcept { out_.clear_edge_index(); }
+
+  void save(const filesystem::path& path) const { out_.save(path); }
+
+public: // Properties
+  [[nodiscard]] constexpr auto find_vertex(vertex_id_type id) noexcept { return out_.find_vertex(id); }
+  [[nodiscard]] constexpr auto find_vertex(vertex_id_type id) const noexcept { return out_.find_vertex(id); }
+
+  [[nodiscard]] constexpr edge_index_type index_of(const vertex_type& u) const noexcept { return out_.index_of(u); }
+  [[nodiscard]] constexpr bool            sorted_rows() const noexcept { return out_.sorted_rows(); }
+
+  /// <summary>
+  /// The csr_graph that holds the outgoing edges.
+  /// </summary>
+  [[nodiscard]] constexpr const base_type& out_graph() const noexcept { return out_; }
+
+  /// <summary>
+  /// The transpose graph that holds the incoming edges, with the same vertex ids, for algorithms that
+  /// take a transpose graph (e.g. breadth_first_search_levels and page_rank).
+  /// </summary>
+  [[nodiscard]] constexpr const transpose_type& transpose_graph() const noexcept { return transpose_; }
+
+public: // Operators
+  constexpr vertex_type&       operator[](vertex_id_type id) noexcept { return out_[id]; }
+  constexpr const vertex_type& operator[](vertex_id_type id) const noexcept { return out_[id]; }
+
+private:
+  void build_transpose(size_t num_threads) {
+    transpose_ = transpose_type();
+    transpose_.load_transpose(out_, num_threads);
+  }
+
+private: // Member variables
+  base_type      out_;       // the outgoing edges
+  transpose_type transpose_; // the incoming edges
+
+private: // tag_invoke properties
+  // The outgoing edges and the values are those of out_. target_id(g,uv) and target(g,uv) are the same for
+  // the edges of the transpose, which have the same vertex ids.
+  friend constexpr vertices_type tag_invoke(::std::graph::tag_invoke::vertices_fn_t, graph_type& g) {
+    return vertices(g.out_);
+  }
+  friend constexpr const_vertices_type tag_invoke(::std::graph::tag_invoke::vertices_fn_t, const graph_type& g) {
+    return vertices(g.out_);
+  }
+  friend vertex_id_type tag_invoke(::std::graph::tag_invoke::vertex_id_fn_t, const graph_type& g, const_iterator ui) {
+    return vertex_id(g.out_, ui);
+  }
+
+  friend constexpr edges_type tag_invoke(::std::graph::tag_invoke::edges_fn_t, graph_type& g, vertex_type& u) {
+    return edges(g.out_, u);
+  }
+  friend constexpr const_edges_type
+  tag_invoke(::std::graph::tag_invoke::edges_fn_t, const graph_type& g, const vertex_type& u) {
+    return edges(g.out_, u);
+  }
+  friend constexpr edges_type
+  tag_invoke(::std::graph::tag_invoke::edges_fn_t, graph_type& g, const vertex_id_type uid) {
+    return edges(g.out_, uid);
+  }
+  friend constexpr const_edges_type
+  tag_invoke(::std::graph::tag_invoke::edges_fn_t, const graph_type& g, const vertex_id_type uid) {
+    return edges(g.out_, uid);
+  }
+
+  friend constexpr vertex_id_type
+  tag_invoke(::std::graph::tag_invoke::target_id_fn_t, const graph_type& g, const edge_type& uv) noexcept {
+    return target_id(g.out_, uv);
+  }
+  friend constexpr vertex_type&
+  tag_invoke(::std::graph::tag_invoke::target_fn_t, graph_type& g, edge_type& uv) noexcept {
+    return target(g.out_, uv);
+  }
+  friend constexpr const vertex_type&
+  tag_invoke(::std::graph::tag_invoke::target_fn_t, const graph_type& g, const edge_type& uv) noexcept {
+    return target(g.out_, uv);
+  }
+
+  friend constexpr ranges::iterator_t<edges_type>
+  tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t, graph_type& g, vertex_type& u, vertex_id_type vid) {
+    return find_vertex_edge(g.out_, u, vid);
+  }
+  friend constexpr ranges::iterator_t<const_edges_type> tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t,
+                                                                   const graph_type&  g,
+                                                                   const vertex_type& u,
+                                                                   vertex_id_type     vid) {
+    return find_vertex_edge(g.out_, u, vid);
+  }
+  friend constexpr ranges::iterator_t<edges_type> tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t,
+                                                             graph_type&    g,
+                                                             vertex_id_type uid,
+                                                             vertex_id_type vid) {
+    return find_vertex_edge(g.out_, uid, vid);
+  }
+  friend constexpr ranges::iterator_t<const_edges_type> tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t,
+                                                                   const graph_type& g,
+                                                                   vertex_id_type    uid,
+                                                                   vertex_id_type    vid) {
+    return find_vertex_edge(g.out_, uid, vid);
+  }
+  friend constexpr bool tag_invoke(::std::graph::tag_invoke::contains_edge_fn_t,
+                                   const graph_type& g,
+                                   vertex_id_type    uid,
+                                   vertex_id_type    vid) {
+    return contains_edge(g.out_, uid, vid);
+  }
+
+  friend constexpr decltype(auto)
+  tag_invoke(::std::graph::tag_invoke::vertex_value_fn_t, graph_type& g, vertex_type& u) requires(!is_void_v<VV>) {
+    return vertex_value(g.out_, u);
+  }
+  friend constexpr decltype(auto) tag_invoke(::std::graph::tag_invoke::vertex_value_fn_t,
+                                             const graph_type&  g,
+                                             const vertex_type& u) requires(!is_void_v<VV>) {
+    return vertex_value(g.out_, u);
+  }
+
+  friend constexpr decltype(auto) tag_invoke(::std::graph::tag_invoke::graph_value_fn_t, graph_type& g)
+  requires(!is_void_v<GV>) {
+    return graph_value(g.out_);
+  }
+  friend constexpr decltype(auto) tag_invoke(::std::graph::tag_invoke::graph_value_fn_t, const graph_type& g)
+  requires(!is_void_v<GV>) {
+    return graph_value(g.out_);
+  }
+
+  // in_edges(g,u), in_edges(g,uid)
+  friend constexpr in_edges_type tag_invoke(::std::graph::tag_invoke::in_edges_fn_t, graph_type& g, vertex_type& u) {
+    return edges(g.transpose_, static_cast<vertex_id_type>(g.index_of(u)));
+  }
+  friend constexpr const_in_edges_type
+  tag_invoke(::std::graph::tag_invoke::in_edges_fn_t, const graph_type& g, const vertex_type& u) {
+    return edges(g.transpose_, static_cast<vertex_id_type>(g.index_of(u)));
+  }
+  friend constexpr in_edges_type
+  tag_invoke(::std::graph::tag_invoke::in_edges_fn_t, graph_type& g, const vertex_id_type uid) {
+    return edges(g.transpose_, uid);
+  }
+  friend constexpr const_in_edges_type
+  tag_invoke(::std::graph::tag_invoke::in_edges_fn_t, const graph_type& g, const vertex_id_type uid) {
+    return edges(g.transpose_, uid);
+  }
+
+  // edge_value(g,uv), for outgoing and incoming edges
+  friend constexpr decltype(auto)
+  tag_invoke(::std::graph::tag_invoke::edge_value_fn_t, graph_type& g, edge_type& uv) requires(!is_void_v<EV>) {
+    if (g.transpose_.owns_edge(uv))
+      return edge_value(g.transpose_, uv);
+    return edge_value(g.out_, uv);
+  }
+  friend constexpr decltype(auto) tag_invoke(::std::graph::tag_invoke::edge_value_fn_t,
+                                             const graph_type& g,
+                                             const edge_type&  uv) requires(!is_void_v<EV>) {
+    if (g.transpose_.owns_edge(uv))
+      return edge_value(g.transpose_, uv);
+    return edge_value(g.out_, uv);
+  }
+};
+
+} // namespace std::graph::container
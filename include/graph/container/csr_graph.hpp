@@ -6,7 +6,15 @@
 #include <functional>
 #include <ranges>
 #include <cstdint>
+#include <atomic>
+#include <numeric>
+#include <limits>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
 #include "graph/graph.hpp"
+#include "graph/views/views_utility.hpp"
+#include "graph/detail/parallel.hpp"
 
 // NOTES
 //  have public load_edges(...), load_vertices(...), and load()
@@ -16,7 +24,12 @@
 
 // load_vertices(vrng, vproj) <- [uid,vval]
 // load_edges(erng, eproj) <- [uid, vid, eval]
+// load_unsorted_edges(erng, eproj) <- [uid, vid, eval], in any order
 // load(erng, eproj, vrng, vproj): load_edges(erng,eproj), load_vertices(vrng,vproj)
+// save(path) -> binary file for mapped_csr_graph (mapped_csr_graph.hpp)
+// index_edges(hub_degree): O(1)/O(log d) find_vertex_edge(g,u,vid) & contains_edge(g,uid,vid)
+// sort_rows(), dedup_rows([reduce]): order the edges of each row by target_id, removing duplicates
+// load_transpose(g), transpose(): the edges of each vertex are its incoming edges in g
 //
 // csr_graph(initializer_list<[uid,vid,eval]>) : load_edges(erng,eproj)
 // csr_graph(erng, eproj) : load_edges(erng,eproj)
@@ -79,6 +92,47 @@ struct csr_col {
   vertex_id_type index = 0;
 };
 
+/// <summary>
+/// Header of the binary file written by csr_graph::save(path) and read by mapped_csr_graph.
+///
+/// The header is followed by these sections, each starting at the offset in the header, which is
+/// a multiple of alignment from the start of the file:
+///   row_index     vertex_count+1 csr_row<EIndex> (the last is the terminating row)
+///   col_index     edge_count csr_col<VId>
+///   vertex values vertex_count VV, when vertex_value_size > 0
+///   edge values   edge_count EV, when edge_value_size > 0
+/// Values are written in the byte order of the machine that wrote the file, which byte_order identifies.
+/// </summary>
+struct csr_file_header {
+  static constexpr char     magic_value[8]  = {'G', 'R', 'A', 'P', 'H', 'C', 'S', 'R'};
+  static constexpr uint32_t current_version = 1;
+  static constexpr uint32_t byte_order_mark = 0x01020304;
+  static constexpr uint64_t alignment       = 64;
+
+  char     magic[8]             = {};
+  uint32_t version              = 0;
+  uint32_t byte_order           = 0;
+  uint32_t vertex_id_size       = 0; // sizeof(VId)
+  uint32_t edge_index_size      = 0; // sizeof(EIndex)
+  uint32_t vertex_value_size    = 0; // sizeof(VV), or 0 if there are no vertex values
+  uint32_t edge_value_size      = 0; // sizeof(EV), or 0 if there are no edge values
+  uint64_t vertex_count         = 0;
+  uint64_t edge_count           = 0;
+  uint64_t row_index_offset     = 0;
+  uint64_t col_index_offset     = 0;
+  uint64_t vertex_values_offset = 0; // 0 if there are no vertex values
+  uint64_t edge_values_offset   = 0; // 0 if there are no edge values
+};
+
+template <class T>
+concept csr_file_value = is_void_v<T> || (is_trivially_copyable_v<T> && !is_pointer_v<T>);
+
+// The size of a value in a csr file, or 0 for void
+template <class T>
+inline constexpr uint32_t csr_file_value_size = static_cast<uint32_t>(sizeof(T));
+template <>
+inline constexpr uint32_t csr_file_value_size<void> = 0;
+
 
 /// <summary>
 /// Class to hold vertex values in a vector that is the same size as row_index_.
@@ -281,7 +335,7 @@ public: // Operations
   constexpr void push_back(const value_type& value) { v_.push_back(value); }
   constexpr void emplace_back(value_type&& value) { v_.emplace_back(forward<value_type>(value)); }
 
-  constexpr void swap(csr_col_values& other) noexcept { swap(v_, other.v_); }
+  constexpr void swap(csr_col_values& other) noexcept { v_.swap(other.v_); }
 
 public:
   constexpr reference       operator[](size_type pos) { return v_[pos]; }
@@ -354,6 +408,9 @@ class csr_graph_base
   using col_allocator_type = typename allocator_traits<Alloc>::template rebind_alloc<col_type>;
   using col_index_vector   = vector<col_type, col_allocator_type>;
 
+  using edge_hash_allocator_type = typename allocator_traits<Alloc>::template rebind_alloc<EIndex>;
+  using edge_hash_vector         = vector<EIndex, edge_hash_allocator_type>; // index into col_index_, or empty
+
 public: // Types
   using graph_type = csr_graph_base<EV, VV, GV, VId, EIndex, Alloc>;
 
@@ -384,7 +441,7 @@ public: // Construction/Destruction
   constexpr csr_graph_base& operator=(csr_graph_base&&)      = default;
 
   constexpr csr_graph_base(const Alloc& alloc)
-        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc) {}
+        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc), edge_hash_(alloc) {}
 
   /// <summary>
   /// Constructor that takes a edge range to create the CSR graph.
@@ -397,7 +454,7 @@ public: // Construction/Destruction
   template <ranges::forward_range ERng, class EProj = identity>
   requires copyable_edge<invoke_result<EProj, ranges::range_value_t<ERng>>, VId, EV>
   constexpr csr_graph_base(const ERng& erng, EProj eprojection = {}, const Alloc& alloc = Alloc())
-        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc) {
+        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc), edge_hash_(alloc) {
 
     load_edges(erng, eprojection);
   }
@@ -422,7 +479,7 @@ public: // Construction/Destruction
                            EProj        eprojection = {}, // eproj(eval) -> {source_id,target_id [,value]}
                            VProj        vprojection = {}, // vproj(vval) -> {target_id [,value]}
                            const Alloc& alloc       = Alloc())
-        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc) {
+        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc), edge_hash_(alloc) {
 
     load(erng, vrng, eprojection, vprojection);
   }
@@ -434,7 +491,7 @@ public: // Construction/Destruction
   /// <param name="ilist">Initializer list of copyable_edge_t<VId,EV> -> [source_id, target_id, value]</param>
   /// <param name="alloc">Allocator to use for internal containers</param>
   constexpr csr_graph_base(const initializer_list<copyable_edge_t<VId, EV>>& ilist, const Alloc& alloc = Alloc())
-        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc) {
+        : row_values_base(alloc), col_values_base(alloc), row_index_(alloc), col_index_(alloc), edge_hash_(alloc) {
     load_edges(ilist, identity());
   }
 
@@ -547,12 +604,12 @@ public: // Operations
     // Add edges
     vertex_id_type last_uid = 0, max_vid = 0;
     for (auto&& edge_data : erng) {
-      auto&& edge = eprojection(edge_data); // csr_graph requires EV!=void
+      auto&& edge = eprojection(edge_data);
       assert(edge.source_id >= last_uid);   // ordered by uid? (requirement)
       row_index_.resize(static_cast<size_t>(edge.source_id) + 1,
-                        vertex_type{static_cast<vertex_id_type>(static_cast<col_values_base&>(*this).size())});
+                        vertex_type{static_cast<edge_index_type>(col_index_.size())});
       col_index_.push_back(edge_type{edge.target_id});
-      if (!is_void_v<EV>)
+      if constexpr (!is_void_v<EV>)
         static_cast<col_values_base&>(*this).emplace_back(std::move(edge.value));
       last_uid = edge.source_id;
       max_vid  = max(max_vid, edge.target_id);
@@ -562,8 +619,7 @@ public: // Operations
     vertex_count = max(vertex_count, max(row_index_.size(), static_cast<size_type>(max_vid + 1)));
 
     // add any rows that haven't been added yet, and (+1) terminating row
-    row_index_.resize(vertex_count + 1,
-                      vertex_type{static_cast<vertex_id_type>(static_cast<col_values_base&>(*this).size())});
+    row_index_.resize(vertex_count + 1, vertex_type{static_cast<edge_index_type>(col_index_.size())});
 
     // If load_vertices(vrng,vproj) has been called but it doesn't have enough values for all
     // the vertices then we extend the size to remove possibility of out-of-bounds occuring when
@@ -600,10 +656,10 @@ public: // Operations
     // Add edges
     vertex_id_type last_uid = 0, max_vid = 0;
     for (auto&& edge_data : erng) {
-      auto&& edge = eprojection(edge_data); // csr_graph requires EV!=void
+      auto&& edge = eprojection(edge_data);
       assert(edge.source_id >= last_uid);   // ordered by uid? (requirement)
       row_index_.resize(static_cast<size_t>(edge.source_id) + 1,
-                        vertex_type{static_cast<vertex_id_type>(static_cast<col_values_base&>(*this).size())});
+                        vertex_type{static_cast<edge_index_type>(col_index_.size())});
       col_index_.push_back(edge_type{edge.target_id});
       if constexpr (!is_void_v<EV>)
         static_cast<col_values_base&>(*this).push_back(edge.value);
@@ -615,8 +671,7 @@ public: // Operations
     vertex_count = max(vertex_count, max(row_index_.size(), static_cast<size_type>(max_vid + 1)));
 
     // add any rows that haven't been added yet, and (+1) terminating row
-    row_index_.resize(vertex_count + 1,
-                      vertex_type{static_cast<vertex_id_type>(static_cast<col_values_base&>(*this).size())});
+    row_index_.resize(vertex_count + 1, vertex_type{static_cast<edge_index_type>(col_index_.size())});
 
     // If load_vertices(vrng,vproj) has been called but it doesn't have enough values for all
     // the vertices then we extend the size to remove possibility of out-of-bounds occuring when
@@ -625,6 +680,183 @@ public: // Operations
       row_values_base::resize(vertex_count);
   }
 
+  /// <summary>
+  /// Load the edges for the graph from a range that isn't ordered by source_id, without sorting it.
+  /// This can be called either before or after load_vertices(erng,eproj).
+  ///
+  /// The graph is built with passes over erng: the largest vertex id is found, the edges of each
+  /// vertex are counted, the counts are summed into row_index_, and each edge's target_id and value
+  /// are written into the next free position of its row. This is O(|V| + |E|) and reads erng
+  /// sequentially, compared to O(|E| log |E|) to sort erng for load_edges(erng,eproj).
+  ///
+  /// If erng is a sized random_access_range the passes run in parallel. Otherwise they run on the
+  /// calling thread and erng is read three times (e.g. a file reader that creates the edges as it
+  /// parses them), so the edges never need to be held in memory.
+  ///
+  /// When num_threads is 1 or erng isn't random access, the edges of a row are in the same order as
+  /// erng; otherwise their order is unspecified.
+  ///
+  /// The number of vertices is the larger of vertex_count and the largest source_id or target_id + 1.
+  /// </summary>
+  /// <typeparam name="EProj">Edge Projection</typeparam>
+  /// <param name="erng">Input range for edges, in any order.</param>
+  /// <param name="eprojection">Edge projection function that returns a copyable_edge_t<VId,EV> for an element in erng</param>
+  /// <param name="vertex_count">The minimum number of vertices.</param>
+  /// <param name="num_threads">The number of threads to use. If 0, the number of hardware threads is used.</param>
+  template <ranges::forward_range ERng, class EProj = identity>
+  //requires views::copyable_edge<invoke_result<EProj, ranges::range_value_t<ERng>>, VId, EV>
+  void load_unsorted_edges(const ERng& erng,
+                           EProj       eprojection  = {},
+                           size_type   vertex_count = 0,
+                           size_t      num_threads  = 0) {
+    // should only be loading into an empty graph
+    assert(row_index_.empty() && col_index_.empty() && static_cast<col_values_base&>(*this).empty());
+
+    constexpr bool       parallel = ranges::random_access_range<ERng> && ranges::sized_range<ERng>;
+    _detail::thread_team team(parallel ? num_threads : 1);
+    const bool           concurrent = team.size() > 1;
+
+    // call fn(tid, edge) for each edge in erng
+    auto for_each_edge = [&](auto&& fn) {
+      if constexpr (parallel) {
+        constexpr size_t grain = 16 * 1024; // edges per chunk of work
+        auto             first = ranges::begin(erng);
+        team.for_each_chunk(static_cast<size_t>(ranges::size(erng)), grain, [&](size_t tid, size_t lo, size_t hi) {
+          for (size_t i = lo; i < hi; ++i)
+            fn(tid, eprojection(first[static_cast<ptrdiff_t>(i)]));
+        });
+      } else {
+        for (auto&& edge_data : erng)
+          fn(size_t{0}, eprojection(edge_data));
+      }
+    };
+
+    // post-increment a counter shared by the threads
+    auto fetch_inc = [concurrent](edge_index_type& counter) -> size_t {
+      if (concurrent)
+        return static_cast<size_t>(atomic_ref<edge_index_type>(counter).fetch_add(1, memory_order_relaxed));
+      return static_cast<size_t>(counter++);
+    };
+
+    // largest vertex id and number of edges
+    struct alignas(64) edge_scan { // one cache line per thread
+      size_t max_id     = 0;
+      size_t edge_count = 0;
+    };
+    vector<edge_scan> scans(team.size());
+    for_each_edge([&](size_t tid, auto&& edge) {
+      scans[tid].max_id = max(scans[tid].max_id, static_cast<size_t>(max(edge.source_id, edge.target_id)));
+      ++scans[tid].edge_count;
+    });
+    size_t edge_count = 0, max_id = 0;
+    for (auto&& scan : scans) {
+      edge_count += scan.edge_count;
+      max_id = max(max_id, scan.max_id);
+    }
+
+    // Nothing to do?
+    if (edge_count == 0) {
+      return;
+    }
+    assert(edge_count <= static_cast<size_t>(numeric_limits<edge_index_type>::max()));
+
+    vertex_count = max(vertex_count, static_cast<size_type>(max_id + 1)); // +1 for zero-based index
+    assert(vertex_count - 1 <= static_cast<size_t>(numeric_limits<vertex_id_type>::max()));
+
+    // degree of each vertex; row_start[uid+1] is the number of edges for uid
+    vector<edge_index_type> row_start(vertex_count + 1, edge_index_type(0));
+    for_each_edge([&](size_t, auto&& edge) { fetch_inc(row_start[static_cast<size_t>(edge.source_id) + 1]); });
+
+    // row_start[uid] is the index of the first edge for uid, plus the terminating row
+    inclusive_scan(row_start.begin(), row_start.end(), row_start.begin());
+    row_index_.resize(vertex_count + 1);
+    for (size_t uid = 0; uid <= vertex_count; ++uid)
+      row_index_[uid].index = row_start[uid];
+
+    // place each edge at the next free position in its row; row_start[uid] becomes the end of the row
+    col_index_.resize(edge_count);
+    static_cast<col_values_base&>(*this).resize(edge_count);
+    for_each_edge([&](size_t, auto&& edge) {
+      const size_t pos = fetch_inc(row_start[static_cast<size_t>(edge.source_id)]);
+      col_index_[pos]  = edge_type{static_cast<vertex_id_type>(edge.target_id)};
+      if constexpr (!is_void_v<EV>)
+        static_cast<col_values_base&>(*this)[pos] = edge.value;
+    });
+
+    // If load_vertices(vrng,vproj) has been called but it doesn't have enough values for all
+    // the vertices then we extend the size to remove possibility of out-of-bounds occuring when
+    // getting a value for a row.
+    if (row_values_base::size() > 0 && row_values_base::size() < vertex_count)
+      row_values_base::resize(vertex_count);
+  }
+
+  /// <summary>
+  /// Load the transpose of g into this empty graph: an edge (v,u) for each edge (u,v) in g, with the
+  /// value of (u,v), so the edges of each vertex are its incoming edges in g. The vertex values are
+  /// copied when both graphs have the same vertex value type. The graph value isn't copied.
+  ///
+  /// The edges are placed with a parallel counting sort in O(|V| + |E|): the in-degrees are counted,
+  /// summed into the row starts, and each edge is written to the next free position of its target's
+  /// row. When num_threads is 1 the edges of each row are ordered by source id and sorted_rows() is
+  /// true; otherwise their order is unspecified and sort_rows() can be used to order them.
+  /// </summary>
+  /// <param name="g">The graph to transpose. It has the same vertex id, edge index, edge value and
+  ///   allocator types.</param>
+  /// <param name="num_threads">The number of threads to use. If 0, the number of hardware threads is used.</param>
+  template <class VV2, class GV2>
+  void load_transpose(const csr_graph_base<EV, VV2, GV2, VId, EIndex, Alloc>& g, size_t num_threads = 0) {
+    // should only be loading into an empty graph
+    assert(row_index_.empty() && col_index_.empty() && static_cast<col_values_base&>(*this).empty());
+    if (g.row_index_.empty())
+      return;
+    using other_col_values = csr_col_values<EV, VV2, GV2, VId, EIndex, Alloc>;
+    const size_t rows       = g.row_index_.size() - 1;
+    const size_t edge_count = g.col_index_.size();
+
+    _detail::thread_team team(num_threads);
+    const bool           concurrent = team.size() > 1;
+    auto                 fetch_inc  = [concurrent](edge_index_type& counter) -> size_t {
+      if (concurrent)
+        return static_cast<size_t>(atomic_ref<edge_index_type>(counter).fetch_add(1, memory_order_relaxed));
+      return static_cast<size_t>(counter++);
+    };
+
+    // in-degree of each vertex; row_start[vid+1] is the number of edges into vid
+    vector<edge_index_type> row_start(rows + 1, edge_index_type(0));
+    team.for_each_chunk(edge_count, 16 * 1024, [&](size_t, size_t first, size_t last) {
+      for (size_t uv = first; uv < last; ++uv)
+        fetch_inc(row_start[static_cast<size_t>(g.col_index_[uv].index) + 1]);
+    });
+    inclusive_scan(row_start.begin(), row_start.end(), row_start.begin());
+    row_index_.resize(rows + 1);
+    for (size_t vid = 0; vid <= rows; ++vid)
+      row_index_[vid].index = row_start[vid];
+
+    // place the reverse of each edge at the next free position in its row
+    col_index_.resize(edge_count);
+    static_cast<col_values_base&>(*this).resize(edge_count);
+    team.for_each_chunk(rows, row_grain, [&](size_t, size_t first_row, size_t last_row) {
+      for (size_t uid = first_row; uid < last_row; ++uid) {
+        const size_t last = static_cast<size_t>(g.row_index_[uid + 1].index);
+        for (size_t uv = static_cast<size_t>(g.row_index_[uid].index); uv < last; ++uv) {
+          const size_t pos = fetch_inc(row_start[static_cast<size_t>(g.col_index_[uv].index)]);
+          col_index_[pos]  = edge_type{static_cast<vertex_id_type>(uid)};
+          if constexpr (!is_void_v<EV>)
+            col_values_base::operator[](pos) = static_cast<const other_col_values&>(g)[uv];
+        }
+      }
+    });
+
+    if constexpr (!is_void_v<VV> && is_same_v<VV, VV2>) {
+      using other_row_values = csr_row_values<EV, VV2, GV2, VId, EIndex, Alloc>;
+      const auto& values     = static_cast<const other_row_values&>(g);
+      row_values_base::resize(values.size());
+      for (size_t uid = 0; uid < static_cast<size_t>(values.size()); ++uid)
+        row_values_base::operator[](uid) = values[uid];
+    }
+    sorted_rows_ = !concurrent;
+  }
+
   /// <summary>
   /// Load edges and then vertices for the graph. See load_edges() and load_vertices() for more
   /// information.
@@ -643,6 +875,78 @@ public: // Operations
     load_vertices(vrng, vprojection); // load the values
   }
 
+  /// <summary>
+  /// Write the graph to a binary file that can be mapped into memory by mapped_csr_graph, which uses
+  /// it directly without parsing or copying it. See csr_file_header for the layout. The graph value
+  /// isn't saved.
+  ///
+  /// If load_vertices(vrng,vproj) hasn't been called, or had fewer values than vertices, the missing
+  /// vertex values are written as value-initialized values.
+  /// </summary>
+  /// <param name="path">The file to write. It's replaced if it exists.</param>
+  void save(const filesystem::path& path) const
+  requires csr_file_value<EV> && csr_file_value<VV>
+  {
+    const size_t vertex_count = row_index_.empty() ? 0 : row_index_.size() - 1;
+    const size_t edge_count   = col_index_.size();
+
+    auto align = [](uint64_t offset) {
+      return (offset + csr_file_header::alignment - 1) / csr_file_header::alignment * csr_file_header::alignment;
+    };
+
+    csr_file_header header;
+    ranges::copy(csr_file_header::magic_value, header.magic);
+    header.version           = csr_file_header::current_version;
+    header.byte_order        = csr_file_header::byte_order_mark;
+    header.vertex_id_size    = sizeof(vertex_id_type);
+    header.edge_index_size   = sizeof(edge_index_type);
+    header.vertex_value_size = csr_file_value_size<VV>;
+    header.edge_value_size   = csr_file_value_size<EV>;
+    header.vertex_count      = vertex_count;
+    header.edge_count        = edge_count;
+    header.row_index_offset  = align(sizeof(csr_file_header));
+    header.col_index_offset  = align(header.row_index_offset + (vertex_count + 1) * sizeof(row_type));
+    uint64_t end             = header.col_index_offset + edge_count * sizeof(col_type);
+    if (header.vertex_value_size > 0) {
+      header.vertex_values_offset = align(end);
+      end                         = header.vertex_values_offset + vertex_count * header.vertex_value_size;
+    }
+    if (header.edge_value_size > 0)
+      header.edge_values_offset = align(end);
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out)
+      throw runtime_error("unable to create " + path.string());
+
+    // write count values of type T at offset, padding from the current position
+    auto write_section = [&out](uint64_t offset, const auto* values, size_t count) {
+      static const char zeros[csr_file_header::alignment] = {};
+      out.write(zeros, static_cast<streamsize>(offset - static_cast<uint64_t>(out.tellp())));
+      out.write(reinterpret_cast<const char*>(values), static_cast<streamsize>(count * sizeof(*values)));
+    };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const row_type terminating_row{}; // for an empty graph
+    if (row_index_.empty())
+      write_section(header.row_index_offset, &terminating_row, 1);
+    else
+      write_section(header.row_index_offset, row_index_.data(), row_index_.size());
+    write_section(header.col_index_offset, col_index_.data(), edge_count);
+    if constexpr (!is_void_v<VV>) {
+      const size_t value_count = min(vertex_count, static_cast<size_t>(row_values_base::size()));
+      write_section(header.vertex_values_offset, value_count ? &row_values_base::operator[](0) : nullptr,
+                    value_count);
+      const VV default_value{};
+      for (size_t uid = value_count; uid < vertex_count; ++uid)
+        out.write(reinterpret_cast<const char*>(&default_value), sizeof(VV));
+    }
+    if constexpr (!is_void_v<EV>)
+      write_section(header.edge_values_offset, edge_count ? &col_values_base::operator[](0) : nullptr, edge_count);
+
+    if (!out.flush())
+      throw runtime_error("unable to write " + path.string());
+  }
+
 protected:
   template <class ERng, class EProj>
   constexpr vertex_id_type last_erng_id(ERng&& erng, EProj eprojection) const {
@@ -673,6 +977,268 @@ public: // Operations
     return static_cast<vertex_id_type>(&v - col_index_.data());
   }
 
+  /// <summary>
+  /// True if uv refers to an edge of this graph rather than to an edge of another graph, such as the
+  /// transpose kept by bidirectional_csr_graph.
+  /// </summary>
+  constexpr bool owns_edge(const col_type& uv) const noexcept {
+    return less_equal<const col_type*>()(col_index_.data(), &uv) &&
+           less<const col_type*>()(&uv, col_index_.data() + col_index_.size());
+  }
+
+public: // Edge lookup
+  /// <summary>
+  /// Build an index of the edges that's used by find_vertex_edge(g,u,vid) and contains_edge(g,uid,vid),
+  /// and so by any algorithm that looks up an edge by its target. Without it each lookup is a linear
+  /// scan of the edges of the source vertex, which is slow for vertices with a large degree.
+  ///
+  /// With the index, a lookup for a vertex with at least hub_degree edges is a probe into a single
+  /// open-addressing hash table that holds the edges of all such vertices, which is O(1). Otherwise,
+  /// if the targets of every row are in ascending order it's a binary search of the row, O(log degree),
+  /// and if not it's a linear scan of fewer than hub_degree edges. The table uses 2-4 edge indexes for
+  /// each edge of the hub vertices and nothing for the others.
+  ///
+  /// The index is built in O(|V| + |E|). It must be built again if the edges are changed, and is
+  /// cleared by clear_edge_index().
+  /// </summary>
+  /// <param name="hub_degree">The minimum degree of a vertex for its edges to be hashed. Use
+  ///   numeric_limits<size_type>::max() to only use binary search.</param>
+  void index_edges(size_type hub_degree = 256) {
+    assert(hub_degree > 0);
+    clear_edge_index();
+    if (row_index_.empty())
+      return;
+    const size_type vertex_count = row_index_.size() - 1;
+
+    // are the rows sorted, and how many edges do the hubs have?
+    bool      sorted    = true;
+    size_type hub_edges = 0;
+    for (size_type uid = 0; uid < vertex_count; ++uid) {
+      auto first = col_index_.begin() + row_index_[uid].index;
+      auto last  = col_index_.begin() + row_index_[uid + 1].index;
+      if (static_cast<size_type>(last - first) >= hub_degree)
+        hub_edges += static_cast<size_type>(last - first);
+      if (sorted)
+        sorted = ranges::is_sorted(first, last, less<>(), &col_type::index);
+    }
+
+    // hash the edges of the hubs, keeping the first edge of a row with a given target
+    if (hub_edges > 0) {
+      size_type capacity = 16;
+      while (capacity < 2 * hub_edges)
+        capacity *= 2;
+      edge_hash_.assign(capacity, empty_edge_index);
+      edge_hash_shift_ = 64;
+      for (size_type cap = capacity; cap > 1; cap /= 2)
+        --edge_hash_shift_;
+      for (size_type uid = 0; uid < vertex_count; ++uid) {
+        const edge_index_type first = row_index_[uid].index;
+        const edge_index_type last  = row_index_[uid + 1].index;
+        if (static_cast<size_type>(last - first) < hub_degree)
+          continue;
+        for (edge_index_type uv = first; uv < last; ++uv) {
+          const vertex_id_type vid = col_index_[uv].index;
+          for (size_type i = edge_hash(static_cast<vertex_id_type>(uid), vid);; i = (i + 1) & (capacity - 1)) {
+            const edge_index_type e = edge_hash_[i];
+            if (e == empty_edge_index) {
+              edge_hash_[i] = uv;
+              break;
+            }
+            if (e >= first && e < last && col_index_[e].index == vid)
+              break; // duplicate edge; the first one is found
+          }
+        }
+      }
+    }
+    hub_degree_  = hub_degree;
+    sorted_rows_ = sorted;
+  }
+
+  /// <summary>
+  /// Remove the hash table built by index_edges(). Lookups use a binary search if the rows are sorted,
+  /// or a linear scan otherwise.
+  /// </summary>
+  void clear_edge_index() noexcept {
+    edge_hash_.clear();
+    edge_hash_.shrink_to_fit();
+    hub_degree_ = numeric_limits<size_type>::max();
+  }
+
+  /// <summary>
+  /// Are the edges of each row ordered by target_id? This is set by sort_rows() and dedup_rows(), and by
+  /// index_edges() when it finds that the rows were loaded in order; otherwise it's false.
+  /// </summary>
+  [[nodiscard]] constexpr bool sorted_rows() const noexcept { return sorted_rows_; }
+
+  /// <summary>
+  /// Sort the edges of each row by target_id, moving the edge values with them. Edges with the same
+  /// target keep their relative order. Rows that are already sorted aren't changed.
+  ///
+  /// Sorted rows are needed by algorithms that merge the neighbors of two vertices (e.g. triangle
+  /// counting) and let find_vertex_edge(g,u,vid) and contains_edge(g,uid,vid) use a binary search.
+  /// The index built by index_edges() is rebuilt, if there is one.
+  ///
+  /// The rows are sorted in parallel. Complexity: O(|E| log d), where d is the largest degree.
+  /// </summary>
+  /// <param name="num_threads">The number of threads to use. If 0, the number of hardware threads is used.</param>
+  void sort_rows(size_t num_threads = 0) {
+    if (sorted_rows_ || row_index_.empty()) {
+      sorted_rows_ = true;
+      return;
+    }
+    using sort_value  = conditional_t<is_void_v<EV>, vertex_id_type, pair<vertex_id_type, EV>>;
+    const size_t rows = row_index_.size() - 1;
+
+    _detail::thread_team       team(num_threads);
+    vector<vector<sort_value>> scratch(team.size()); // (target_id, value) of a row, for each thread
+    team.for_each_chunk(rows, row_grain, [&](size_t tid, size_t first_row, size_t last_row) {
+      for (size_t uid = first_row; uid < last_row; ++uid) {
+        auto first = col_index_.begin() + row_index_[uid].index;
+        auto last  = col_index_.begin() + row_index_[uid + 1].index;
+        if (ranges::is_sorted(first, last, less<>(), &col_type::index))
+          continue;
+        if constexpr (is_void_v<EV>) {
+          ranges::stable_sort(first, last, less<>(), &col_type::index);
+        } else {
+          auto& row = scratch[tid];
+          row.clear();
+          for (size_t uv = static_cast<size_t>(row_index_[uid].index); first != last; ++first, ++uv)
+            row.emplace_back(first->index, std::move(col_values_base::operator[](uv)));
+          ranges::stable_sort(row, less<>(), &sort_value::first);
+          for (size_t uv = static_cast<size_t>(row_index_[uid].index); auto&& [vid, val] : row) {
+            col_index_[uv].index               = vid;
+            col_values_base::operator[](uv++) = std::move(val);
+          }
+        }
+      }
+    });
+    sorted_rows_ = true;
+    rebuild_edge_index();
+  }
+
+  /// <summary>
+  /// Remove duplicate edges, keeping the first edge from a vertex to a target. The rows are sorted first
+  /// with sort_rows(), so the first edge is the first in the order the edges were loaded.
+  ///
+  /// Rows are deduplicated in parallel and then moved to their new positions. The vertex values aren't
+  /// changed. The index built by index_edges() is rebuilt, if there is one.
+  /// </summary>
+  /// <param name="num_threads">The number of threads to use. If 0, the number of hardware threads is used.</param>
+  void dedup_rows(size_t num_threads = 0) {
+    dedup_rows([](auto&& first, auto&&) { return first; }, num_threads);
+  }
+
+  /// <summary>
+  /// Remove duplicate edges, merging their values with reduce: the value of the edge that's kept is
+  /// reduce(reduce(v1, v2), v3)..., for the values v1, v2, v3... of the edges from a vertex to the same
+  /// target, in the order they were loaded. For instance, plus<>() sums the weights of parallel edges
+  /// and ranges::min's function object keeps the lightest.
+  /// </summary>
+  /// <param name="reduce">A function that merges the values of two edges with the same source and target.
+  ///   It isn't called when EV is void.</param>
+  /// <param name="num_threads">The number of threads to use. If 0, the number of hardware threads is used.</param>
+  template <class Reduce>
+  requires is_void_v<EV> || regular_invocable<Reduce&, const EV&, const EV&>
+  void dedup_rows(Reduce reduce, size_t num_threads = 0) {
+    sort_rows(num_threads);
+    if (row_index_.empty())
+      return;
+    const size_t rows = row_index_.size() - 1;
+
+    // merge the duplicates at the front of each row, counting the edges that are kept
+    _detail::thread_team team(num_threads);
+    vector<edge_index_type> degree(rows + 1, edge_index_type(0));
+    team.for_each_chunk(rows, row_grain, [&](size_t, size_t first_row, size_t last_row) {
+      for (size_t uid = first_row; uid < last_row; ++uid) {
+        const size_t first = static_cast<size_t>(row_index_[uid].index);
+        const size_t last  = static_cast<size_t>(row_index_[uid + 1].index);
+        size_t       kept  = first;
+        for (size_t uv = first; uv < last; ++uv) {
+          if (uv > first && col_index_[uv].index == col_index_[kept - 1].index) {
+            if constexpr (!is_void_v<EV>)
+              col_values_base::operator[](kept - 1) =
+                    invoke(reduce, as_const(col_values_base::operator[](kept - 1)),
+                           as_const(col_values_base::operator[](uv)));
+            continue;
+          }
+          if (uv != kept) {
+            col_index_[kept] = col_index_[uv];
+            if constexpr (!is_void_v<EV>)
+              col_values_base::operator[](kept) = std::move(col_values_base::operator[](uv));
+          }
+          ++kept;
+        }
+        degree[uid] = static_cast<edge_index_type>(kept - first);
+      }
+    });
+
+    // new row starts, then move the kept edges to them
+    exclusive_scan(degree.begin(), degree.end(), degree.begin(), edge_index_type(0));
+    if (static_cast<size_t>(degree[rows]) == col_index_.size())
+      return; // no duplicates
+    col_index_vector new_col_index(static_cast<size_t>(degree[rows]), col_index_.get_allocator());
+    col_values_base  new_col_values{Alloc(col_index_.get_allocator())};
+    new_col_values.resize(static_cast<size_t>(degree[rows]));
+    team.for_each_chunk(rows, row_grain, [&](size_t, size_t first_row, size_t last_row) {
+      for (size_t uid = first_row; uid < last_row; ++uid) {
+        const size_t from = static_cast<size_t>(row_index_[uid].index);
+        const size_t to   = static_cast<size_t>(degree[uid]);
+        const size_t n    = static_cast<size_t>(degree[uid + 1] - degree[uid]);
+        copy_n(col_index_.begin() + static_cast<ptrdiff_t>(from), n,
+               new_col_index.begin() + static_cast<ptrdiff_t>(to));
+        if constexpr (!is_void_v<EV>)
+          for (size_t i = 0; i < n; ++i)
+            new_col_values[to + i] = std::move(col_values_base::operator[](from + i));
+      }
+    });
+    for (size_t uid = 0; uid <= rows; ++uid)
+      row_index_[uid].index = degree[uid];
+    col_index_.swap(new_col_index);
+    static_cast<col_values_base&>(*this).swap(new_col_values);
+    rebuild_edge_index();
+  }
+
+  /// <summary>
+  /// The index in col_index_ of the first edge from uid to vid, or of the end of the row of uid if
+  /// there isn't one. The index built by index_edges() is used if it exists.
+  /// </summary>
+  constexpr edge_index_type find_edge_index(vertex_id_type uid, vertex_id_type vid) const noexcept {
+    assert(static_cast<size_t>(uid + 1) < row_index_.size());
+    const edge_index_type first = row_index_[uid].index;
+    const edge_index_type last  = row_index_[uid + 1].index;
+    if (static_cast<size_type>(last - first) >= hub_degree_) {
+      const size_type mask = edge_hash_.size() - 1;
+      for (size_type i = edge_hash(uid, vid);; i = (i + 1) & mask) {
+        const edge_index_type e = edge_hash_[i];
+        if (e == empty_edge_index)
+          return last;
+        if (e >= first && e < last && col_index_[e].index == vid)
+          return e;
+      }
+    }
+    auto row_first = col_index_.begin() + first;
+    auto row_last  = col_index_.begin() + last;
+    auto it        = sorted_rows_ ? ranges::lower_bound(row_first, row_last, vid, less<>(), &col_type::index)
+                                  : ranges::find(row_first, row_last, vid, &col_type::index);
+    return (it != row_last && it->index == vid) ? static_cast<edge_index_type>(it - col_index_.begin()) : last;
+  }
+
+private:
+  // Slot for edge uid->vid in edge_hash_ (Fibonacci hashing: the high bits of the product)
+  constexpr size_type edge_hash(vertex_id_type uid, vertex_id_type vid) const noexcept {
+    const uint64_t key = (static_cast<uint64_t>(uid) << 32) ^ static_cast<uint64_t>(vid);
+    return static_cast<size_type>((key * 0x9E3779B97F4A7C15ull) >> edge_hash_shift_);
+  }
+
+  // Rebuild the index after the edges have moved, if index_edges() has been called
+  void rebuild_edge_index() {
+    if (hub_degree_ != numeric_limits<size_type>::max())
+      index_edges(hub_degree_);
+  }
+
+  static constexpr edge_index_type empty_edge_index = numeric_limits<edge_index_type>::max();
+  static constexpr size_t          row_grain        = 1024; // rows per chunk of parallel work
+
 public: // Operators
   constexpr vertex_type&       operator[](vertex_id_type id) noexcept { return row_index_[id]; }
   constexpr const vertex_type& operator[](vertex_id_type id) const noexcept { return row_index_[id]; }
@@ -680,6 +1246,12 @@ public: // Operators
 private:                       // Member variables
   row_index_vector row_index_; // starting index into col_index_ and v_; holds +1 extra terminating row
   col_index_vector col_index_; // col_index_[n] holds the column index (aka target)
+
+  // edge index built by index_edges(); hub_degree_ is max() when there isn't one
+  edge_hash_vector edge_hash_;                                          // size is 0 or a power of 2
+  size_type        hub_degree_      = numeric_limits<size_type>::max(); // rows with this many edges are hashed
+  int              edge_hash_shift_ = 64;                               // 64 - log2(edge_hash_.size())
+  bool             sorted_rows_     = false;                            // targets ascending in each row
   //v_vector_type    v_;         // v_[n]         holds the edge value for col_index_[n]
   //row_values_type  row_value_; // row_value_[r] holds the value for row_index_[r], for VV!=void
 
@@ -750,8 +1322,41 @@ private: // tag_invoke properties
     return g.row_index_[uv.index];
   }
 
+  // find_vertex_edge(g,u,vid), find_vertex_edge(g,uid,vid), contains_edge(g,uid,vid); see index_edges()
+  friend constexpr ranges::iterator_t<edges_type>
+  tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t, graph_type& g, vertex_type& u, vertex_id_type vid) {
+    return g.col_index_.begin() + g.find_edge_index(static_cast<vertex_id_type>(g.index_of(u)), vid);
+  }
+  friend constexpr ranges::iterator_t<const_edges_type> tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t,
+                                                                   const graph_type&  g,
+                                                                   const vertex_type& u,
+                                                                   vertex_id_type     vid) {
+    return g.col_index_.begin() + g.find_edge_index(static_cast<vertex_id_type>(g.index_of(u)), vid);
+  }
+  friend constexpr ranges::iterator_t<edges_type> tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t,
+                                                             graph_type&    g,
+                                                             vertex_id_type uid,
+                                                             vertex_id_type vid) {
+    return g.col_index_.begin() + g.find_edge_index(uid, vid);
+  }
+  friend constexpr ranges::iterator_t<const_edges_type> tag_invoke(::std::graph::tag_invoke::find_vertex_edge_fn_t,
+                                                                   const graph_type& g,
+                                                                   vertex_id_type    uid,
+                                                                   vertex_id_type    vid) {
+    return g.col_index_.begin() + g.find_edge_index(uid, vid);
+  }
+  friend constexpr bool tag_invoke(::std::graph::tag_invoke::contains_edge_fn_t,
+                                   const graph_type& g,
+                                   vertex_id_type    uid,
+                                   vertex_id_type    vid) {
+    return g.find_edge_index(uid, vid) != g.row_index_[uid + 1].index;
+  }
+
   friend row_values_base;
   friend col_values_base;
+
+  template <class EV2, class VV2, class GV2, integral VId2, integral EIndex2, class Alloc2>
+  friend class csr_graph_base; // for load_transpose()
 };
 
 
@@ -855,6 +1460,18 @@ public: // Construction/Destruction
   constexpr csr_graph(const initializer_list<copyable_edge_t<VId, EV>>& ilist, const Alloc& alloc = Alloc())
         : base_type(ilist, alloc) {}
 
+public: // Operations
+  /// <summary>
+  /// The transpose of the graph: an edge (v,u) with the value of (u,v) for each edge (u,v). The vertex
+  /// and graph values are copied. See load_transpose().
+  /// </summary>
+  /// <param name="num_threads">The number of threads to use. If 0, the number of hardware threads is used.</param>
+  [[nodiscard]] graph_type transpose(size_t num_threads = 0) const {
+    graph_type gt(value_);
+    gt.load_transpose(*this, num_threads);
+    return gt;
+  }
+
 private: // tag_invoke properties
   friend constexpr value_type& tag_invoke(::std::graph::tag_invoke::graph_value_fn_t, graph_type& g) {
     return g.value_;
@@ -920,7 +1537,18 @@ public: // Construction/Destruction
         : base_type(ilist, alloc) {}
 
 
-public:  // Operations
+public: // Operations
+  /// <summary>
+  /// The transpose of the graph: an edge (v,u) with the value of (u,v) for each edge (u,v). The vertex
+  /// values are copied. See load_transpose().
+  /// </summary>
+  /// <param name="num_threads">The number of threads to use. If 0, the number of hardware threads is used.</param>
+  [[nodiscard]] graph_type transpose(size_t num_threads = 0) const {
+    graph_type gt;
+    gt.load_transpose(*this, num_threads);
+    return gt;
+  }
+
 private: // tag_invoke properties
 };
 
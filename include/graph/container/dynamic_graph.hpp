@@ -5,6 +5,7 @@
 #include <forward_list>
 #include <list>
 #include "graph/graph.hpp"
+#include "graph/views/views_utility.hpp"
 #include "container_utility.hpp"
 
 // load_vertices(vrng, vvalue_fnc) -> [uid,vval]
@@ -0,0 +1,235 @@
+/**
+ * @file indexed_dary_heap.hpp
+ *
+ * @brief An addressable d-ary heap with decrease-key for vertex-keyed priority queues.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <concepts>
+#include <limits>
+#include <cassert>
+
+#ifndef GRAPH_INDEXED_DARY_HEAP_HPP
+#  define GRAPH_INDEXED_DARY_HEAP_HPP
+
+namespace std::graph::container {
+
+/**
+ * @ingroup graph_utilities
+ * @brief A d-ary heap of {vertex_id, weight} elements where the position of each vertex id in the
+ * heap is kept in a vertex-id-indexed array.
+ *
+ * A vertex id can only be in the heap once. When push() is called for a vertex id that is already
+ * in the heap its weight is updated in place (decrease-key) rather than adding a duplicate entry.
+ * This bounds the memory used to O(|V|) and assures a vertex is only popped once when used by
+ * dijkstra_shortest_paths(), which uses it as the default queue.
+ *
+ * It satisfies the queueable concept so it can be used wherever std::priority_queue is used.
+ *
+ * Complexity: push, pop and decrease are O(d log_d(n)); top, contains, empty and size are O(1).
+ *
+ * @tparam T       The element type. It must have an integral vertex_id member and a weight member
+ *                 (e.g. weighted_vertex<G,W>).
+ * @tparam Arity   The number of children of each node (d).
+ * @tparam Compare The comparison for weights. compare(a,b) is true when a should be closer to the top
+ *                 than b. The default of less<> gives a min-heap.
+ * @tparam Alloc   The allocator used for the internal containers.
+*/
+template <class T, size_t Arity = 4, class Compare = less<>, class Alloc = allocator<T>>
+requires(Arity >= 2) && integral<remove_cv_t<decltype(T::vertex_id)>>
+class indexed_dary_heap {
+public:
+  using value_type      = T;
+  using container_type  = vector<T, Alloc>;
+  using size_type       = typename container_type::size_type;
+  using reference       = typename container_type::reference;
+  using const_reference = typename container_type::const_reference;
+  using value_compare   = Compare;
+  using allocator_type  = Alloc;
+
+  using vertex_id_type = remove_cv_t<decltype(T::vertex_id)>;
+  using weight_type    = remove_cv_t<decltype(T::weight)>;
+
+private:
+  using position_allocator_type = typename allocator_traits<Alloc>::template rebind_alloc<size_type>;
+  using position_vector         = vector<size_type, position_allocator_type>;
+
+  static constexpr size_type npos = numeric_limits<size_type>::max(); // vertex id isn't in the heap
+
+public:
+  indexed_dary_heap()                         = default;
+  indexed_dary_heap(const indexed_dary_heap&) = default;
+  indexed_dary_heap(indexed_dary_heap&&)      = default;
+  ~indexed_dary_heap()                        = default;
+
+  indexed_dary_heap& operator=(const indexed_dary_heap&) = default;
+  indexed_dary_heap& operator=(indexed_dary_heap&&)      = default;
+
+  explicit indexed_dary_heap(const Compare& compare, const Alloc& alloc = Alloc())
+        : heap_(alloc), positions_(alloc), compare_(compare) {}
+  explicit indexed_dary_heap(const Alloc& alloc) : heap_(alloc), positions_(alloc) {}
+
+  /**
+   * @brief Create a heap with room for vertex ids in the range [0, vertex_count).
+   * @param vertex_count The number of vertices that can be referenced without reallocation.
+   * @param compare      The weight comparison function object.
+   * @param alloc        The allocator for internal containers.
+  */
+  indexed_dary_heap(size_type vertex_count, const Compare& compare = Compare(), const Alloc& alloc = Alloc())
+        : heap_(alloc), positions_(alloc), compare_(compare) {
+    reserve(vertex_count);
+  }
+
+public: // Properties
+  [[nodiscard]] constexpr bool      empty() const noexcept { return heap_.empty(); }
+  [[nodiscard]] constexpr size_type size() const noexcept { return heap_.size(); }
+
+  /**
+   * @brief The element with the highest priority (lowest weight by default).
+   * @return A reference to the top element. The heap must not be empty.
+  */
+  [[nodiscard]] constexpr const_reference top() const noexcept {
+    assert(!heap_.empty());
+    return heap_.front();
+  }
+
+  /**
+   * @brief Is the vertex id currently in the heap?
+   * @param uid The vertex id.
+   * @return true if the vertex id is in the heap.
+  */
+  [[nodiscard]] constexpr bool contains(vertex_id_type uid) const noexcept {
+    return static_cast<size_type>(uid) < positions_.size() && positions_[static_cast<size_type>(uid)] != npos;
+  }
+
+public: // Operations
+  /**
+   * @brief Reserve space for vertex ids in the range [0, vertex_count). The position index grows
+   * as needed when larger vertex ids are pushed, so this is an optimization only.
+   * @param vertex_count The number of vertices.
+  */
+  void reserve(size_type vertex_count) {
+    if (positions_.size() < vertex_count)
+      positions_.resize(vertex_count, npos);
+    heap_.reserve(vertex_count);
+  }
+
+  /**
+   * @brief Add an element to the heap, or update the weight of its vertex id if it is already in the heap.
+   * @param value The element to add or update.
+  */
+  void push(const value_type& value) {
+    const size_type uidx = static_cast<size_type>(value.vertex_id);
+    if (uidx >= positions_.size())
+      positions_.resize(uidx + 1, npos);
+
+    if (positions_[uidx] == npos) {
+      heap_.push_back(value);
+      positions_[uidx] = heap_.size() - 1;
+      sift_up(heap_.size() - 1);
+    } else {
+      const size_type i          = positions_[uidx];
+      const bool      higher_pri = compare_(value.weight, heap_[i].weight);
+      heap_[i]                   = value;
+      if (higher_pri)
+        sift_up(i);
+      else
+        sift_down(i);
+    }
+  }
+
+  /**
+   * @brief Give the vertex id of value, which must be in the heap, a new weight that is the same or
+   * a higher priority than its current weight.
+   * @param value The vertex id and its new weight.
+  */
+  void decrease(const value_type& value) {
+    assert(contains(value.vertex_id));
+    const size_type i = positions_[static_cast<size_type>(value.vertex_id)];
+    assert(!compare_(heap_[i].weight, value.weight));
+    heap_[i] = value;
+    sift_up(i);
+  }
+
+  /**
+   * @brief Remove the top element.
+  */
+  void pop() {
+    assert(!heap_.empty());
+    positions_[static_cast<size_type>(heap_.front().vertex_id)] = npos;
+    if (heap_.size() > 1) {
+      heap_.front() = move(heap_.back());
+      heap_.pop_back();
+      positions_[static_cast<size_type>(heap_.front().vertex_id)] = 0;
+      sift_down(0);
+    } else {
+      heap_.pop_back();
+    }
+  }
+
+  /**
+   * @brief Remove all elements. The position index keeps its size so the heap can be reused
+   * without reallocation.
+   *
+   * Complexity: O(size())
+  */
+  void clear() noexcept {
+    for (auto&& value : heap_)
+      positions_[static_cast<size_type>(value.vertex_id)] = npos;
+    heap_.clear();
+  }
+
+private:
+  void sift_up(size_type i) {
+    value_type value = move(heap_[i]);
+    while (i > 0) {
+      const size_type parent = (i - 1) / Arity;
+      if (!compare_(value.weight, heap_[parent].weight))
+        break;
+      place(i, move(heap_[parent]));
+      i = parent;
+    }
+    place(i, move(value));
+  }
+
+  void sift_down(size_type i) {
+    const size_type n     = heap_.size();
+    value_type      value = move(heap_[i]);
+    for (size_type first = i * Arity + 1; first < n; first = i * Arity + 1) {
+      const size_type last = min(first + Arity, n);
+      size_type       best = first;
+      for (size_type child = first + 1; child < last; ++child)
+        if (compare_(heap_[child].weight, heap_[best].weight))
+          best = child;
+      if (!compare_(heap_[best].weight, value.weight))
+        break;
+      place(i, move(heap_[best]));
+      i = best;
+    }
+    place(i, move(value));
+  }
+
+  void place(size_type i, value_type&& value) {
+    positions_[static_cast<size_type>(value.vertex_id)] = i;
+    heap_[i]                                             = move(value);
+  }
+
+private:
+  container_type  heap_;      // heap-ordered elements
+  position_vector positions_; // positions_[uid] is the index of uid in heap_, or npos
+  [[no_unique_address]] value_compare compare_ = value_compare();
+};
+
+} // namespace std::graph::container
+
+#endif //GRAPH_INDEXED_DARY_HEAP_HPP
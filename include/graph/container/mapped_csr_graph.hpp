@@ -0,0 +1,200 @@
+#pragma once
+
+#include "graph/graph.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/detail/mapped_file.hpp"
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+// mapped_csr_graph(path) <- file written by csr_graph::save(path)
+//
+// A read-only compressed sparse row graph that uses the file written by csr_graph::save(path) in
+// place, through a memory mapping. Nothing is parsed or copied when it's opened; the row index and
+// target ids are only read once to check that they're inside the graph, and the values are read from
+// the file as they're used.
+//
+namespace std::graph::container {
+
+/**
+ * @ingroup graph_containers
+ * @brief Read-only compressed sparse row adjacency graph that's mapped from a file written by
+ * csr_graph::save(path).
+ *
+ * vertices(g), edges(g,u), target_id(g,uv) and the values of the vertices and edges are served
+ * directly from the mapped file, so they have the same cost as for csr_graph once the pages have been
+ * read. The graph can't be modified.
+ *
+ * The template arguments must match the csr_graph that saved the file, which is checked when the
+ * file is opened. The row index and target ids are also checked with one linear scan, so a truncated
+ * or corrupt file throws runtime_error rather than being read out of bounds. The vertex and edge
+ * values aren't checked. The graph value isn't saved.
+ *
+ * @tparam EV     Edge value type. It must be void or trivially copyable.
+ * @tparam VV     Vertex value type. It must be void or trivially copyable.
+ * @tparam VId    Vertex Id type.
+ * @tparam EIndex Edge Index type.
+*/
+template <csr_file_value EV = void, csr_file_value VV = void, integral VId = uint32_t, integral EIndex = uint32_t>
+class mapped_csr_graph {
+  using row_type = csr_row<EIndex>; // index into col_index
+  using col_type = csr_col<VId>;    // target_id
+
+public: // Types
+  using graph_type = mapped_csr_graph<EV, VV, VId, EIndex>;
+
+  using vertex_id_type    = VId;
+  using vertex_type       = row_type;
+  using vertex_value_type = VV;
+  using vertices_type     = ranges::subrange<const vertex_type*>;
+
+  using edge_type       = col_type;
+  using edge_value_type = EV;
+  using edge_index_type = EIndex;
+  using edges_type      = ranges::subrange<const edge_type*>;
+
+  using graph_value_type = void;
+  using value_type       = void;
+
+  using size_type = size_t;
+
+public: // Construction/Destruction
+  mapped_csr_graph()                        = default;
+  mapped_csr_graph(mapped_csr_graph&&)      = default;
+  mapped_csr_graph(const mapped_csr_graph&) = delete;
+  ~mapped_csr_graph()                       = default;
+
+  mapped_csr_graph& operator=(mapped_csr_graph&&)      = default;
+  mapped_csr_graph& operator=(const mapped_csr_graph&) = delete;
+
+  /// <summary>
+  /// Map a graph file written by csr_graph::save(path).
+  /// </summary>
+  /// <param name="path">The file to map.</param>
+  /// <exception cref="runtime_error">
+  /// The file can't be mapped, isn't a graph file, is truncated or corrupt, or doesn't match the template arguments.
+  /// </exception>
+  explicit mapped_csr_graph(const filesystem::path& path) : file_(path) {
+    auto fail = [&path](const char* reason) { throw runtime_error(path.string() + ": " + reason); };
+
+    if (file_.size() < sizeof(csr_file_header))
+      fail("not a csr graph file");
+    memcpy(&header_, file_.data(), sizeof(csr_file_header));
+    if (memcmp(header_.magic, csr_file_header::magic_value, sizeof(header_.magic)) != 0)
+      fail("not a csr graph file");
+    if (header_.version != csr_file_header::current_version)
+      fail("unsupported csr graph file version");
+    if (header_.byte_order != csr_file_header::byte_order_mark)
+      fail("csr graph file was written with a different byte order");
+    if (header_.vertex_id_size != sizeof(vertex_id_type) || header_.edge_index_size != sizeof(edge_index_type) ||
+        header_.vertex_value_size != csr_file_value_size<VV> || header_.edge_value_size != csr_file_value_size<EV>)
+      fail("csr graph file types don't match the graph type");
+
+    if (header_.vertex_count >= numeric_limits<uint64_t>::max()) // vertex_count + 1 rows
+      fail("csr graph file is truncated or corrupt");
+
+    // each section must be aligned and inside the file
+    auto section = [&](uint64_t offset, uint64_t count, uint64_t value_size) {
+      if (offset % csr_file_header::alignment != 0 || offset > file_.size() ||
+          (value_size > 0 && count > (file_.size() - offset) / value_size))
+        fail("csr graph file is truncated or corrupt");
+      return file_.data() + offset;
+    };
+    rows_ = reinterpret_cast<const row_type*>(
+          section(header_.row_index_offset, header_.vertex_count + 1, sizeof(row_type)));
+    cols_ = reinterpret_cast<const col_type*>(section(header_.col_index_offset, header_.edge_count, sizeof(col_type)));
+    if constexpr (!is_void_v<VV>)
+      vertex_values_ = reinterpret_cast<const VV*>(
+            section(header_.vertex_values_offset, header_.vertex_count, sizeof(VV)));
+    if constexpr (!is_void_v<EV>)
+      edge_values_ = reinterpret_cast<const EV*>(section(header_.edge_values_offset, header_.edge_count, sizeof(EV)));
+
+    // rows must be ordered, from 0 to edge_count, and targets must be vertices
+    if (rows_[0].index != 0 || static_cast<uint64_t>(rows_[header_.vertex_count].index) != header_.edge_count)
+      fail("csr graph file is truncated or corrupt");
+    for (uint64_t uid = 0; uid < header_.vertex_count; ++uid)
+      if (rows_[uid + 1].index < rows_[uid].index)
+        fail("csr graph file is truncated or corrupt");
+    for (uint64_t i = 0; i < header_.edge_count; ++i)
+      if (static_cast<uint64_t>(cols_[i].index) >= header_.vertex_count)
+        fail("csr graph file is truncated or corrupt");
+  }
+
+public: // Properties
+  [[nodiscard]] const csr_file_header& header() const noexcept { return header_; }
+
+  [[nodiscard]] size_type vertex_count() const noexcept { return static_cast<size_type>(header_.vertex_count); }
+  [[nodiscard]] size_type edge_count() const noexcept { return static_cast<size_type>(header_.edge_count); }
+
+public: // Operations
+  constexpr const vertex_type* find_vertex(vertex_id_type id) const noexcept { return rows_ + id; }
+
+  constexpr edge_index_type index_of(const row_type& u) const noexcept {
+    return static_cast<edge_index_type>(&u - rows_);
+  }
+  constexpr edge_index_type index_of(const col_type& uv) const noexcept {
+    return static_cast<edge_index_type>(&uv - cols_);
+  }
+
+public: // Operators
+  constexpr const vertex_type& operator[](vertex_id_type id) const noexcept { return rows_[id]; }
+
+private: // Member variables
+  _detail::mapped_file file_;
+  csr_file_header      header_;
+  const row_type*      rows_          = nullptr; // vertex_count()+1 rows, including the terminating row
+  const col_type*      cols_          = nullptr;
+  const VV*            vertex_values_ = nullptr; // not used when VV is void
+  const EV*            edge_values_   = nullptr; // not used when EV is void
+
+private: // tag_invoke properties
+  friend constexpr vertices_type tag_invoke(::std::graph::tag_invoke::vertices_fn_t, const graph_type& g) {
+    return vertices_type(g.rows_, g.rows_ + g.vertex_count()); // don't include terminating row
+  }
+
+  friend vertex_id_type
+  tag_invoke(::std::graph::tag_invoke::vertex_id_fn_t, const graph_type& g, const vertex_type* ui) {
+    return static_cast<vertex_id_type>(ui - g.rows_);
+  }
+
+  friend constexpr edges_type
+  tag_invoke(::std::graph::tag_invoke::edges_fn_t, const graph_type& g, const vertex_type& u) {
+    assert(g.index_of(u) < g.vertex_count()); // in rows_ bounds?
+    const vertex_type* u2 = &u + 1;
+    return edges_type(g.cols_ + u.index, g.cols_ + u2->index);
+  }
+  friend constexpr edges_type
+  tag_invoke(::std::graph::tag_invoke::edges_fn_t, const graph_type& g, const vertex_id_type uid) {
+    assert(static_cast<size_t>(uid) < g.vertex_count()); // in rows_ bounds?
+    return edges_type(g.cols_ + g.rows_[uid].index, g.cols_ + g.rows_[uid + 1].index);
+  }
+
+  // target_id(g,uv), target(g,uv)
+  friend constexpr vertex_id_type
+  tag_invoke(::std::graph::tag_invoke::target_id_fn_t, const graph_type&, const edge_type& uv) noexcept {
+    return uv.index;
+  }
+  friend constexpr const vertex_type&
+  tag_invoke(::std::graph::tag_invoke::target_fn_t, const graph_type& g, const edge_type& uv) noexcept {
+    return g.rows_[uv.index];
+  }
+
+  // vertex_value(g,u), edge_value(g,uv)
+  friend constexpr add_lvalue_reference_t<const VV>
+  tag_invoke(::std::graph::tag_invoke::vertex_value_fn_t, const graph_type& g, const vertex_type& u)
+  requires(!is_void_v<VV>)
+  {
+    return g.vertex_values_[g.index_of(u)];
+  }
+  friend constexpr add_lvalue_reference_t<const EV>
+  tag_invoke(::std::graph::tag_invoke::edge_value_fn_t, const graph_type& g, const edge_type& uv)
+  requires(!is_void_v<EV>)
+  {
+    return g.edge_values_[g.index_of(uv)];
+  }
+};
+
+} // namespace std::graph::container
@@ -0,0 +1,182 @@
+/**
+ * @file ring_queue.hpp
+ *
+ * @brief A FIFO queue in a contiguous, growable ring buffer.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cassert>
+
+#ifndef GRAPH_RING_QUEUE_HPP
+#  define GRAPH_RING_QUEUE_HPP
+
+namespace std::graph::container {
+
+/**
+ * @ingroup graph_utilities
+ * @brief A FIFO queue of values held in a single contiguous buffer used as a ring.
+ *
+ * The capacity is a power of two so the position of an element is found with a mask. When the buffer is
+ * full its capacity is doubled and the elements are moved to the front of the new buffer, so a queue
+ * that holds at most n elements at once makes O(log n) allocations over its lifetime regardless of the
+ * number of pushes. The buffer isn't initialized, so reserving space for all the vertices of a graph up
+ * front only costs the pages that are used.
+ *
+ * It has the same interface as std::queue for the operations used by the breadth-first search views,
+ * where it's the default queue: each vertex id is pushed at most once so the capacity is bounded by the
+ * number of vertices, and the values are read and written sequentially.
+ *
+ * Complexity: push is amortized O(1); pop, front, back, empty and size are O(1).
+ *
+ * @tparam T     The value type. It must be trivially copyable (e.g. a vertex id).
+ * @tparam Alloc The allocator used for the buffer.
+*/
+template <class T, class Alloc = allocator<T>>
+requires is_trivially_copyable_v<T>
+class ring_queue {
+  using alloc_traits = allocator_traits<Alloc>;
+
+public:
+  using value_type      = T;
+  using container_type  = vector<T, Alloc>; // not used for storage; for compatibility with std::queue
+  using size_type       = size_t;
+  using reference       = T&;
+  using const_reference = const T&;
+  using allocator_type  = Alloc;
+
+public:
+  ring_queue() = default;
+  ~ring_queue() {
+    if (buf_)
+      alloc_traits::deallocate(alloc_, buf_, mask_ + 1);
+  }
+
+  explicit ring_queue(const Alloc& alloc) : alloc_(alloc) {}
+
+  /**
+   * @brief Create an empty queue with room for at least n values.
+   * @param n     The number of values to reserve space for.
+   * @param alloc The allocator.
+  */
+  explicit ring_queue(size_type n, const Alloc& alloc = Alloc()) : alloc_(alloc) { reserve(n); }
+
+  ring_queue(const ring_queue& rhs)
+        : alloc_(alloc_traits::select_on_container_copy_construction(rhs.alloc_)) {
+    reserve(rhs.size_);
+    for (size_type i = 0; i < rhs.size_; ++i)
+      buf_[i] = rhs.buf_[(rhs.head_ + i) & rhs.mask_];
+    size_ = rhs.size_;
+  }
+  ring_queue(ring_queue&& rhs) noexcept
+        : alloc_(std::move(rhs.alloc_))
+        , buf_(exchange(rhs.buf_, nullptr))
+        , head_(exchange(rhs.head_, 0))
+        , size_(exchange(rhs.size_, 0))
+        , mask_(exchange(rhs.mask_, 0)) {}
+
+  ring_queue& operator=(const ring_queue& rhs) {
+    ring_queue tmp(rhs);
+    swap(tmp);
+    return *this;
+  }
+  ring_queue& operator=(ring_queue&& rhs) noexcept {
+    ring_queue tmp(std::move(rhs));
+    swap(tmp);
+    return *this;
+  }
+
+  [[nodiscard]] constexpr bool      empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+  [[nodiscard]] constexpr size_type capacity() const noexcept { return buf_ ? mask_ + 1 : 0; }
+
+  constexpr reference front() noexcept {
+    assert(!empty());
+    return buf_[head_];
+  }
+  constexpr const_reference front() const noexcept {
+    assert(!empty());
+    return buf_[head_];
+  }
+  constexpr reference back() noexcept {
+    assert(!empty());
+    return buf_[(head_ + size_ - 1) & mask_];
+  }
+  constexpr const_reference back() const noexcept {
+    assert(!empty());
+    return buf_[(head_ + size_ - 1) & mask_];
+  }
+
+  void push(const value_type& value) { emplace(value); }
+
+  template <class... Args>
+  reference emplace(Args&&... args) {
+    if (size_ == capacity())
+      grow(size_ + 1);
+    reference elem = buf_[(head_ + size_) & mask_];
+    elem           = value_type(std::forward<Args>(args)...);
+    ++size_;
+    return elem;
+  }
+
+  constexpr void pop() noexcept {
+    assert(!empty());
+    head_ = (head_ + 1) & mask_;
+    --size_;
+  }
+
+  /**
+   * @brief Make sure there's room for at least n values without growing.
+  */
+  void reserve(size_type n) {
+    if (n > capacity())
+      grow(n);
+  }
+
+  constexpr void clear() noexcept { head_ = size_ = 0; }
+
+  void swap(ring_queue& rhs) noexcept {
+    using std::swap;
+    swap(alloc_, rhs.alloc_);
+    swap(buf_, rhs.buf_);
+    swap(head_, rhs.head_);
+    swap(size_, rhs.size_);
+    swap(mask_, rhs.mask_);
+  }
+
+private:
+  // Move the values to the front of a buffer with a power-of-two capacity >= n.
+  void grow(size_type n) {
+    size_type cap = buf_ ? 2 * (mask_ + 1) : size_type(16);
+    while (cap < n)
+      cap *= 2;
+    T* buf = alloc_traits::allocate(alloc_, cap);
+    for (size_type i = 0; i < size_; ++i)
+      buf[i] = buf_[(head_ + i) & mask_];
+    if (buf_)
+      alloc_traits::deallocate(alloc_, buf_, mask_ + 1);
+    buf_  = buf;
+    head_ = 0;
+    mask_ = cap - 1;
+  }
+
+private:
+  [[no_unique_address]] Alloc alloc_;
+  T*                          buf_  = nullptr; // capacity is mask_ + 1, a power of 2, when not null
+  size_type                   head_ = 0;
+  size_type                   size_ = 0;
+  size_type                   mask_ = 0;
+};
+
+} // namespace std::graph::container
+
+#endif //GRAPH_RING_QUEUE_HPP
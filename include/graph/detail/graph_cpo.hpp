@@ -309,6 +309,76 @@ using edge_t = ranges::range_value_t<vertex_edge_range_t<G>>;
 template <class G>
 using edge_reference_t = ranges::range_reference_t<vertex_edge_range_t<G>>;
 
+//
+// in_edges(g,u)  -> vertex_in_edge_range_t<G>
+// in_edges(g,uid) -> vertex_in_edge_range_t<G>
+//      default = in_edges(g,*find_vertex(g,uid))
+//
+// target_id(g,uv) of an incoming edge uv of u is the id of the vertex the edge comes from, as for an
+// edge of the transpose graph, so algorithms can traverse in_edges(g,u) like edges(gt,u).
+//
+// vertex_in_edge_range_t<G> = in_edges(g,u)
+//
+namespace tag_invoke {
+  TAG_INVOKE_DEF(in_edges);
+
+  template <class G>
+  concept _has_in_edges_vtxref_adl = requires(G&& g, vertex_reference_t<G> u) {
+                                       { in_edges(g, u) };
+                                     };
+
+  template <class G>
+  concept _has_in_edges_vtxid_adl = requires(G&& g, vertex_id_t<G> uid) {
+                                      { in_edges(g, uid) };
+                                    };
+} // namespace tag_invoke
+
+/**
+ * @brief Get the incoming edges of a vertex, for graphs that keep them (e.g. bidirectional_csr_graph).
+ * 
+ * Complexity: O(1)
+ * 
+ * Default implementation: n/a. This must be specialized for each graph type that has incoming edges.
+ * 
+ * @tparam G The graph type.
+ * @param g A graph instance.
+ * @param u Vertex reference.
+ * @return A range of the incoming edges. target_id(g,uv) of an edge is the vertex it comes from.
+*/
+template <class G>
+requires tag_invoke::_has_in_edges_vtxref_adl<G>
+auto in_edges(G&& g, vertex_reference_t<G> u) -> decltype(tag_invoke::in_edges(g, u)) {
+  return tag_invoke::in_edges(g, u); // graph author must define
+}
+
+/**
+ * @brief Get the incoming edges of a vertex id.
+ * 
+ * Complexity: O(1)
+ * 
+ * Default implementation: in_edges(g, *find_vertex(g, uid))
+ * 
+ * @tparam G The graph type.
+ * @param g A graph instance.
+ * @param uid Vertex id.
+ * @return A range of the incoming edges. target_id(g,uv) of an edge is the vertex it comes from.
+*/
+template <class G>
+requires tag_invoke::_has_in_edges_vtxid_adl<G> || tag_invoke::_has_in_edges_vtxref_adl<G>
+auto in_edges(G&& g, vertex_id_t<G> uid) {
+  if constexpr (tag_invoke::_has_in_edges_vtxid_adl<G>)
+    return tag_invoke::in_edges(g, uid);
+  else
+    return in_edges(g, *find_vertex(g, uid));
+}
+
+/**
+ * @brief The incoming edge range type of a vertex for graph G.
+ * @tparam G The graph type.
+*/
+template <class G>
+using vertex_in_edge_range_t = decltype(in_edges(declval<G&&>(), declval<vertex_reference_t<G>>()));
+
 //
 // target_id(g,uv) -> vertex_id_t<G>
 //
@@ -520,7 +590,8 @@ namespace tag_invoke {
 /**
  * @brief Find an edge of a vertex.
  * 
- * Complexity: O(E), where |E| is the number of outgoing edges of vertex u
+ * Complexity: O(E), where |E| is the number of outgoing edges of vertex u. Graphs can override it with
+ * an index of their edges (e.g. csr_graph::index_edges()) for O(1) or O(log E).
  * 
  * Default implementation: find_if(edges(g, u), [&g, &vid](auto&& uv) { return target_id(g, uv) == vid; })
  * 
@@ -559,13 +630,13 @@ auto find_vertex_edge(G&& g, vertex_id_t<G> uid, vertex_id_t<G> vid) {
   if constexpr (tag_invoke::_has_find_vertex_id_edge_adl<G>)
     return tag_invoke::find_vertex_edge(g, uid, vid);
   else if constexpr (ranges::random_access_range<vertex_range_t<G>>)
-    find_vertex_edge(g, *(begin(vertices(g)) + uid), vid);
+    return find_vertex_edge(g, *(begin(vertices(g)) + uid), vid);
 }
 
 //
 // contains_edge(g,uid,vid) -> bool
 //      default = uid < size(vertices(g)) && vid < size(vertices(g)), if adjacency_matrix<G>
-//              = find_vertex_edge(g,uid) != ranges::end(edges(g,uid));
+//              = find_vertex_edge(g,uid,vid) != ranges::end(edges(g,uid));
 //
 namespace tag_invoke {
   TAG_INVOKE_DEF(contains_edge);
@@ -581,7 +652,7 @@ namespace tag_invoke {
  * 
  * Complexity: O(E), where |E| is the number of outgoing edges of vertex u
  * 
- * Default implementation: find_vertex_edge(g, *ui) != end(edges(g, *ui));
+ * Default implementation: find_vertex_edge(g, *ui, vid) != end(edges(g, *ui));
  * 
  * @tparam G The graph type.
  * @param g A graph instance.
@@ -597,7 +668,7 @@ auto contains_edge(G&& g, vertex_id_t<G> uid, vertex_id_t<G> vid) {
     return uid < ranges::size(vertices(g)) && vid < ranges::size(vertices(g));
   } else {
     auto ui = find_vertex(g, uid);
-    return find_vertex_edge(g, *ui) != ranges::end(edges(g, *ui));
+    return find_vertex_edge(g, *ui, vid) != ranges::end(edges(g, *ui));
   }
 }
 
@@ -0,0 +1,128 @@
+/**
+ * @file mapped_file.hpp
+ *
+ * @brief Read-only memory mapping of a file.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <cstddef>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#ifndef GRAPH_MAPPED_FILE_HPP
+#  define GRAPH_MAPPED_FILE_HPP
+
+namespace std::graph::_detail {
+
+/**
+ * @brief A read-only memory mapping of a whole file.
+ *
+ * Pages are read from the file when they're first accessed and are shared with the OS file cache, so
+ * mapping a large file is fast and processes that map the same file share the memory. The file can't be
+ * empty. The mapping is released by the destructor.
+*/
+class mapped_file {
+public:
+  mapped_file() = default;
+
+  /**
+   * @brief Map a file.
+   * @param path The file to map.
+   * @throws runtime_error if the file can't be opened or mapped, or if it's empty.
+  */
+  explicit mapped_file(const filesystem::path& path) {
+#  if defined(_WIN32)
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      throw runtime_error("unable to open " + path.string());
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+      CloseHandle(file);
+      throw runtime_error("unable to map empty file " + path.string());
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+      throw runtime_error("unable to map " + path.string());
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); // the view keeps the mapping open
+    if (!data)
+      throw runtime_error("unable to map " + path.string());
+    data_ = static_cast<const byte*>(data);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+#  else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw runtime_error("unable to open " + path.string());
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      throw runtime_error("unable to map empty file " + path.string());
+    }
+    void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file open
+    if (data == MAP_FAILED)
+      throw runtime_error("unable to map " + path.string());
+    data_ = static_cast<const byte*>(data);
+    size_ = static_cast<size_t>(st.st_size);
+#  endif
+  }
+
+  mapped_file(const mapped_file&)            = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  mapped_file(mapped_file&& rhs) noexcept : data_(exchange(rhs.data_, nullptr)), size_(exchange(rhs.size_, 0)) {}
+  mapped_file& operator=(mapped_file&& rhs) noexcept {
+    mapped_file tmp(std::move(rhs));
+    swap(data_, tmp.data_);
+    swap(size_, tmp.size_);
+    return *this;
+  }
+
+  ~mapped_file() {
+    if (!data_)
+      return;
+#  if defined(_WIN32)
+    UnmapViewOfFile(data_);
+#  else
+    ::munmap(const_cast<byte*>(data_), size_);
+#  endif
+  }
+
+  [[nodiscard]] const byte* data() const noexcept { return data_; }
+  [[nodiscard]] size_t      size() const noexcept { return size_; }
+  [[nodiscard]] bool        empty() const noexcept { return size_ == 0; }
+
+private:
+  const byte* data_ = nullptr;
+  size_t      size_ = 0;
+};
+
+} // namespace std::graph::_detail
+
+#endif //GRAPH_MAPPED_FILE_HPP
@@ -0,0 +1,260 @@
+/**
+ * @file parallel.hpp
+ *
+ * @brief Minimal fork-join threading support used by the parallel graph algorithms.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+#ifndef GRAPH_PARALLEL_HPP
+#  define GRAPH_PARALLEL_HPP
+
+namespace std::graph::_detail {
+
+/**
+ * @brief The number of threads used by parallel algorithms when the caller passes num_threads == 0.
+*/
+inline size_t default_num_threads() noexcept {
+  const size_t n = thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+/**
+ * @brief A team of threads that execute a sequence of fork-join parallel regions.
+ *
+ * The threads are created once by the constructor and reused for each call to run() or
+ * for_each_chunk(), so algorithms with many short phases (e.g. one per BFS level or distance
+ * bucket) don't pay the cost of thread creation per phase. The calling thread participates as
+ * thread id 0, so a team of size 1 runs everything inline.
+ *
+ * Parallel regions can't be nested. An exception thrown by a thread is rethrown by run() after
+ * all threads have finished the region.
+*/
+class thread_team {
+public:
+  /**
+   * @brief Create a team of threads.
+   * @param num_threads The number of threads in the team, including the calling thread. If 0,
+   *                    default_num_threads() is used.
+  */
+  explicit thread_team(size_t num_threads = 0) {
+    if (num_threads == 0)
+      num_threads = default_num_threads();
+    threads_.reserve(num_threads - 1);
+    for (size_t tid = 1; tid < num_threads; ++tid)
+      threads_.emplace_back([this, tid] { work(tid); });
+  }
+
+  thread_team(const thread_team&)            = delete;
+  thread_team& operator=(const thread_team&) = delete;
+
+  ~thread_team() {
+    {
+      lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    start_.notify_all();
+    for (auto&& t : threads_)
+      t.join();
+  }
+
+  /**
+   * @brief The number of threads in the team, including the calling thread.
+  */
+  [[nodiscard]] size_t size() const noexcept { return threads_.size() + 1; }
+
+  /**
+   * @brief Call fn(tid) on each thread of the team, for tid in [0, size()), and wait for all of
+   * them to return.
+   * @param fn The function to call.
+  */
+  template <class F>
+  void run(F&& fn) {
+    if (threads_.empty()) {
+      fn(size_t{0});
+      return;
+    }
+
+    function<void(size_t)> task = [&fn](size_t tid) { fn(tid); };
+    {
+      lock_guard lock(mutex_);
+      task_    = &task;
+      pending_ = threads_.size();
+      error_   = nullptr;
+      ++generation_;
+    }
+    start_.notify_all();
+
+    exception_ptr error;
+    try {
+      fn(size_t{0});
+    } catch (...) {
+      error = current_exception();
+    }
+
+    unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    task_ = nullptr;
+    if (!error)
+      error = error_;
+    if (error)
+      rethrow_exception(error);
+  }
+
+  /**
+   * @brief Call fn(tid, first, last) for consecutive chunks [first,last) of [0,n). Chunks are handed
+   * out dynamically so threads that finish early take more work.
+   *
+   * When n <= grain the work is done inline by the calling thread as fn(0, 0, n).
+   *
+   * @param n     The number of items.
+   * @param grain The number of items in each chunk.
+   * @param fn    The function to call for each chunk.
+  */
+  template <class F>
+  void for_each_chunk(size_t n, size_t grain, F&& fn) {
+    if (n == 0)
+      return;
+    grain = max(grain, size_t{1});
+    if (n <= grain || threads_.empty()) {
+      fn(size_t{0}, size_t{0}, n);
+      return;
+    }
+    atomic<size_t> next = 0;
+    run([&](size_t tid) {
+      for (size_t first = next.fetch_add(grain, memory_order_relaxed); first < n;
+           first        = next.fetch_add(grain, memory_order_relaxed))
+        fn(tid, first, min(first + grain, n));
+    });
+  }
+
+private:
+  void work(size_t tid) {
+    size_t seen = 0;
+    for (;;) {
+      function<void(size_t)>* task = nullptr;
+      {
+        unique_lock lock(mutex_);
+        start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_)
+          return;
+        seen = generation_;
+        task = task_;
+      }
+
+      exception_ptr error;
+      try {
+        (*task)(tid);
+      } catch (...) {
+        error = current_exception();
+      }
+
+      lock_guard lock(mutex_);
+      if (error && !error_)
+        error_ = error;
+      if (--pending_ == 0)
+        done_.notify_one();
+    }
+  }
+
+private:
+  vector<thread>          threads_;
+  mutex                   mutex_;
+  condition_variable      start_;
+  condition_variable      done_;
+  function<void(size_t)>* task_       = nullptr;
+  size_t                  generation_ = 0;
+  size_t                  pending_    = 0;
+  exception_ptr           error_;
+  bool                    stop_ = false;
+};
+
+/**
+ * @brief Move the values in lists(tid), for each thread id of the team, to out in thread id order.
+ * Each thread copies and clears its own list.
+ * @param team  The thread team.
+ * @param out   [out] The values from all lists.
+ * @param lists A function that returns a reference to the vector for a thread id.
+*/
+template <class T, class A, class Lists>
+void gather(thread_team& team, vector<T, A>& out, Lists&& lists) {
+  const size_t   nthreads = team.size();
+  vector<size_t> offset(nthreads + 1, 0);
+  for (size_t tid = 0; tid < nthreads; ++tid)
+    offset[tid + 1] = offset[tid] + lists(tid).size();
+  out.resize(offset[nthreads]);
+  team.run([&](size_t tid) {
+    auto& lst = lists(tid);
+    ranges::copy(lst, out.begin() + static_cast<ptrdiff_t>(offset[tid]));
+    lst.clear();
+  });
+}
+
+/**
+ * @brief Atomically replace target with value if value is smaller.
+ * @param target The value to update. It may be accessed concurrently by other threads only through atomic_ref.
+ * @param value  The candidate value.
+ * @return true if target was updated.
+*/
+template <class T>
+bool atomic_min(T& target, T value) noexcept {
+  atomic_ref<T> ref(target);
+  T             current = ref.load(memory_order_relaxed);
+  while (value < current)
+    if (ref.compare_exchange_weak(current, value, memory_order_relaxed))
+      return true;
+  return false;
+}
+
+/**
+ * @brief Sort [first,last) across the threads of a team. Each thread sorts a chunk, then the sorted chunks
+ * are merged in pairs, halving the number of chunks in each round.
+ * @param team  The thread team.
+ * @param first The first element.
+ * @param last  One past the last element.
+ * @param comp  The comparison function.
+*/
+template <random_access_iterator I, class Comp = less<>>
+void parallel_sort(thread_team& team, I first, I last, Comp comp = {}) {
+  constexpr size_t min_chunk = 16 * 1024; // elements per chunk worth sorting on a separate thread
+  const size_t     n         = static_cast<size_t>(last - first);
+  const size_t     chunks    = min(team.size(), n / min_chunk);
+  if (chunks <= 1) {
+    sort(first, last, comp);
+    return;
+  }
+
+  auto at = [&](size_t chunk) { return first + static_cast<ptrdiff_t>(n * chunk / chunks); };
+  team.run([&](size_t tid) {
+    if (tid < chunks)
+      sort(at(tid), at(tid + 1), comp);
+  });
+  for (size_t width = 1; width < chunks; width *= 2) {
+    team.run([&](size_t tid) {
+      const size_t lo = tid * 2 * width;
+      if (lo + width < chunks)
+        inplace_merge(at(lo), at(lo + width), at(min(lo + 2 * width, chunks)), comp);
+    });
+  }
+}
+
+} // namespace std::graph::_detail
+
+#endif //GRAPH_PARALLEL_HPP
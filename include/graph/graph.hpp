@@ -187,6 +187,22 @@ template <class G>
 concept sourced_adjacency_list =
       adjacency_list<G> && sourced_edge<G, edge_t<G>> && requires(G&& g, edge_reference_t<G> uv) { edge_id(g, uv); };
 
+/**
+ * @ingroup graph_concepts
+ * @brief Concept for a bidirectional adjacency list.
+ * 
+ * A bidirectional adjacency list extends the adjacency list with the incoming edges of each vertex,
+ * from in_edges(g,u) and in_edges(g,uid). target_id(g,uv) of an incoming edge is the vertex it comes from.
+ * 
+ * @tparam G The graph type.
+*/
+template <class G>
+concept bidirectional_adjacency_list =
+      adjacency_list<G> && requires(G&& g, vertex_reference_t<G> u, vertex_id_t<G> uid) {
+                             { in_edges(g, u) } -> ranges::forward_range;
+                             { in_edges(g, uid) } -> ranges::forward_range;
+                           };
+
 //
 // property concepts
 //
@@ -0,0 +1,433 @@
+/**
+ * @file csv.hpp
+ *
+ * @brief Single-pass loader for label-keyed CSV edge files.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/views/views_utility.hpp"
+#include "graph/detail/mapped_file.hpp"
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <functional>
+#include <optional>
+#include <memory>
+#include <vector>
+#include <ranges>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#ifndef GRAPH_CSV_HPP
+#  define GRAPH_CSV_HPP
+
+// read_csv_edges<VId,EV>(path) -> {labels, edges}: labels[id] -> label, edges -> copyable_edge_t<VId,EV>
+// load_csv_graph<G>(path) -> G, with the labels as vertex values when G has them
+//
+// examples: auto routes = io::read_csv_edges<uint32_t, double>("routes.csv");
+//           csr_graph<double> g;
+//           g.load_unsorted_edges(routes.edges, identity(), routes.vertex_count());
+//           auto frankfurt_id = routes.labels.find("Frankfürt");
+//
+//           auto g = io::load_csv_graph<csr_graph<double, std::string>>("routes.csv");
+//
+namespace std::graph::io {
+
+/**
+ * @ingroup graph_io
+ * @brief Assigns a unique, dense vertex id to each distinct label, in the order the labels are inserted.
+ *
+ * The labels are held in a flat open-addressing hash table with linear probing, so finding a label is a
+ * hash and, usually, a single comparison against a contiguous slot array, rather than O(log n) string
+ * comparisons in a tree. Each slot holds the label's hash so most mismatches, and rehashing, never touch
+ * the label text.
+ *
+ * The text of the labels is copied into an arena of large blocks that's owned by the table, so inserting
+ * a label doesn't make an allocation of its own and the string_views returned by operator[] remain valid
+ * for the lifetime of the table, independent of the source the labels came from.
+ *
+ * Complexity: insert and find are expected O(|label|); the load factor is kept at or below 1/2.
+ *
+ * @tparam VId The vertex id type.
+*/
+template <integral VId = uint32_t>
+class label_table {
+public:
+  using vertex_id_type = VId;
+  using value_type     = string_view;
+  using size_type      = size_t;
+  using const_iterator = typename vector<string_view>::const_iterator;
+  using iterator       = const_iterator;
+
+public:
+  label_table() = default;
+
+  /**
+   * @brief Create an empty table with room for at least n labels.
+  */
+  explicit label_table(size_type n) { reserve(n); }
+
+  label_table(label_table&&)            = default;
+  label_table& operator=(label_table&&) = default;
+
+public: // Properties
+  [[nodiscard]] size_type size() const noexcept { return labels_.size(); }
+  [[nodiscard]] bool      empty() const noexcept { return labels_.empty(); }
+
+  /**
+   * @brief The label of a vertex id, for id < size().
+  */
+  [[nodiscard]] string_view operator[](vertex_id_type id) const noexcept {
+    assert(static_cast<size_type>(id) < labels_.size());
+    return labels_[static_cast<size_type>(id)];
+  }
+
+  // the labels in id order
+  [[nodiscard]] const_iterator begin() const noexcept { return labels_.begin(); }
+  [[nodiscard]] const_iterator end() const noexcept { return labels_.end(); }
+
+public: // Operations
+  /**
+   * @brief Find the id of a label, adding it with the next id if it isn't in the table.
+   * @return The id of the label, and true if it was added.
+   * @throws runtime_error if there are more labels than can be represented by vertex_id_type.
+  */
+  pair<vertex_id_type, bool> insert(string_view lbl) {
+    if (2 * (labels_.size() + 1) > slots_.size())
+      rehash(max(size_type(64), 2 * slots_.size()));
+    const size_t h = hash<string_view>{}(lbl);
+    slot&        s = slots_[probe(lbl, h)];
+    if (s.id != empty_id)
+      return {s.id, false};
+    if (labels_.size() >= static_cast<size_type>(empty_id))
+      throw runtime_error("too many labels for the vertex id type");
+    s.hash = h;
+    s.id   = static_cast<vertex_id_type>(labels_.size());
+    labels_.push_back(store(lbl));
+    return {s.id, true};
+  }
+
+  /**
+   * @brief The id of a label, or nullopt if it isn't in the table.
+  */
+  [[nodiscard]] optional<vertex_id_type> find(string_view lbl) const {
+    if (slots_.empty())
+      return nullopt;
+    const slot& s = slots_[probe(lbl, hash<string_view>{}(lbl))];
+    return s.id != empty_id ? optional<vertex_id_type>(s.id) : nullopt;
+  }
+
+  [[nodiscard]] bool contains(string_view lbl) const { return find(lbl).has_value(); }
+
+  /**
+   * @brief Make sure n labels can be inserted without rehashing.
+  */
+  void reserve(size_type n) {
+    size_type cap = 64;
+    while (cap < 2 * n)
+      cap *= 2;
+    if (cap > slots_.size())
+      rehash(cap);
+    labels_.reserve(n);
+  }
+
+private:
+  struct slot {
+    size_t         hash = 0;
+    vertex_id_type id   = empty_id;
+  };
+  static constexpr vertex_id_type empty_id   = numeric_limits<vertex_id_type>::max();
+  static constexpr size_type      block_size = 64 * 1024; // bytes in an arena block
+
+  // The slot holding lbl, or the empty slot where it belongs
+  size_type probe(string_view lbl, size_t h) const noexcept {
+    const size_type mask = slots_.size() - 1;
+    for (size_type i = h & mask;; i = (i + 1) & mask) {
+      const slot& s = slots_[i];
+      if (s.id == empty_id || (s.hash == h && labels_[static_cast<size_type>(s.id)] == lbl))
+        return i;
+    }
+  }
+
+  // Move the entries to a slot array with cap slots, a power of 2, using the hashes already computed
+  void rehash(size_type cap) {
+    vector<slot>    slots(cap);
+    const size_type mask = cap - 1;
+    for (const slot& s : slots_) {
+      if (s.id == empty_id)
+        continue;
+      size_type i = s.hash & mask;
+      while (slots[i].id != empty_id)
+        i = (i + 1) & mask;
+      slots[i] = s;
+    }
+    slots_ = std::move(slots);
+  }
+
+  // Copy the text of a label into the arena. Long labels get a block of their own so the rest of
+  // the current block isn't wasted.
+  string_view store(string_view lbl) {
+    const size_type n = lbl.size();
+    if (n == 0)
+      return string_view();
+    char* dst = nullptr;
+    if (n > block_size / 4) {
+      blocks_.push_back(make_unique_for_overwrite<char[]>(n));
+      dst = blocks_.back().get();
+    } else {
+      if (n > avail_) {
+        blocks_.push_back(make_unique_for_overwrite<char[]>(block_size));
+        next_  = blocks_.back().get();
+        avail_ = block_size;
+      }
+      dst = next_;
+      next_ += n;
+      avail_ -= n;
+    }
+    memcpy(dst, lbl.data(), n);
+    return string_view(dst, n);
+  }
+
+private:
+  vector<slot>               slots_;  // size is 0 or a power of 2
+  vector<string_view>        labels_; // labels_[id] is the label of id, in the arena
+  vector<unique_ptr<char[]>> blocks_; // the arena
+  char*                      next_  = nullptr; // next free byte in the current block
+  size_type                  avail_ = 0;       // free bytes in the current block
+};
+
+/**
+ * @brief The layout of a CSV edge file. Fields are numbered from 0.
+*/
+struct csv_format {
+  size_t source_column = 0;    // label of the source vertex
+  size_t target_column = 1;    // label of the target vertex
+  size_t value_column  = 2;    // edge value; not used when the edge value type is void
+  char   delimiter     = ',';  //
+  bool   header        = true; // the first line that isn't blank holds the column names and is skipped
+};
+
+/**
+ * @brief The vertex labels and edges read from a CSV file by read_csv_edges().
+*/
+template <integral VId = uint32_t, class EV = double>
+struct csv_edges {
+  using vertex_id_type  = VId;
+  using edge_value_type = EV;
+  using edge_type       = copyable_edge_t<VId, EV>;
+
+  label_table<VId>  labels; // labels[id] is the label of vertex id
+  vector<edge_type> edges;  // in the order of the rows in the file
+
+  [[nodiscard]] size_t vertex_count() const noexcept { return labels.size(); }
+};
+
+/**
+ * @ingroup graph_io
+ * @brief Reads the edges of a CSV file where vertices are identified by a label, such as a city name.
+ *
+ * The file is memory-mapped and read in a single pass. The source and target labels of each row are
+ * interned into a label_table, which assigns ids in the order the labels are first found (the source
+ * before the target of the same row), and an edge {source_id, target_id [,value]} is appended for the row.
+ * The edges can be passed directly to csr_graph::load_unsorted_edges(), or to the load_edges() function of
+ * a dynamic_graph, without sorting them or looking up the labels again.
+ *
+ * Fields may be enclosed in double quotes, with "" for a quote in the field, but can't span lines. A leading
+ * UTF-8 byte order mark, CRLF line ends and blank lines are accepted. Labels are case sensitive and are used
+ * as-is, including any blanks around them.
+ *
+ * @tparam VId The vertex id type.
+ * @tparam EV  The edge value type: an arithmetic type parsed with from_chars, or void to ignore the values.
+ * @param path   The file to read.
+ * @param format The layout of the file.
+ * @throws runtime_error if the file can't be read, if a row doesn't have the fields in format or a value
+ *         can't be parsed in full, such as "3.5x", or "3.5" for an integral EV.
+*/
+template <integral VId = uint32_t, class EV = double>
+requires is_void_v<EV> || is_arithmetic_v<EV>
+csv_edges<VId, EV> read_csv_edges(const filesystem::path& path, const csv_format& format = {}) {
+  _detail::mapped_file file(path);
+  const char*          pos = reinterpret_cast<const char*>(file.data());
+  const char*          end = pos + file.size();
+  if (end - pos >= 3 && memcmp(pos, "\xEF\xBB\xBF", 3) == 0)
+    pos += 3; // UTF-8 byte order mark
+
+  const size_t last_column = is_void_v<EV> ? max(format.source_column, format.target_column)
+                                           : max({format.source_column, format.target_column, format.value_column});
+
+  csv_edges<VId, EV> result;
+  string             unquoted[3]; // scratch for quoted fields with "" in them
+  string_view        fields[3];   // source, target, value
+  size_t             line_num       = 0;
+  bool               header_skipped = !format.header;
+  auto fail = [&path, &line_num](const char* reason) {
+    throw runtime_error(path.string() + "(" + to_string(line_num) + "): " + reason);
+  };
+
+  while (pos != end) {
+    // next line, without the line end
+    const char* eol  = static_cast<const char*>(memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    const char* last = eol ? eol : end;
+    string_view line(pos, static_cast<size_t>(last - pos));
+    pos = eol ? eol + 1 : end;
+    ++line_num;
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+    if (line.empty())
+      continue;
+    if (!header_skipped) { // the first line that isn't blank
+      header_skipped = true;
+      continue;
+    }
+
+    // split the fields up to the last one needed
+    const char* p = line.data();
+    const char* e = p + line.size();
+    for (size_t col = 0; col <= last_column; ++col) {
+      if (col > 0) {
+        if (p == e)
+          fail("missing field");
+        ++p; // delimiter
+      }
+      string_view field;
+      int         slot = col == format.source_column   ? 0
+                         : col == format.target_column ? 1
+                         : col == format.value_column  ? 2
+                                                       : -1;
+      if (p != e && *p == '"') {
+        const char* first   = ++p;
+        bool        escaped = false;
+        for (;; ++p) {
+          if (p == e)
+            fail("unterminated quoted field");
+          if (*p == '"') {
+            if (p + 1 != e && p[1] == '"') {
+              escaped = true;
+              ++p;
+            } else {
+              break;
+            }
+          }
+        }
+        field = string_view(first, static_cast<size_t>(p - first));
+        ++p; // closing quote
+        if (p != e && *p != format.delimiter)
+          fail("unexpected text after quoted field");
+        if (escaped && slot >= 0) {
+          string& s = unquoted[slot];
+          s.clear();
+          for (size_t i = 0; i < field.size(); ++i) {
+            s += field[i];
+            if (field[i] == '"')
+              ++i; // skip the second quote of ""
+          }
+          field = s;
+        }
+      } else {
+        const char* first = p;
+        p = static_cast<const char*>(memchr(p, format.delimiter, static_cast<size_t>(e - p)));
+        if (!p)
+          p = e;
+        field = string_view(first, static_cast<size_t>(p - first));
+      }
+      if (slot >= 0)
+        fields[slot] = field;
+    }
+
+    typename csv_edges<VId, EV>::edge_type uv;
+    uv.source_id = result.labels.insert(fields[0]).first;
+    uv.target_id = result.labels.insert(fields[1]).first;
+    if constexpr (!is_void_v<EV>) {
+      const char* first = fields[2].data();
+      const char* vend  = first + fields[2].size();
+      while (first != vend && (*first == ' ' || *first == '\t'))
+        ++first;
+      auto [ptr, ec] = from_chars(first, vend, uv.value);
+      while (ptr != vend && (*ptr == ' ' || *ptr == '\t'))
+        ++ptr;
+      if (ec != errc() || first == vend || ptr != vend)
+        fail("invalid edge value");
+    }
+    result.edges.push_back(uv);
+  }
+  return result;
+}
+
+// The edge and vertex value types of G for load_csv_graph(), or void if G doesn't have them
+template <class G>
+struct csv_edge_value {
+  using type = void;
+};
+template <class G>
+requires requires { typename edge_value_t<G>; }
+struct csv_edge_value<G> {
+  using type = remove_cvref_t<edge_value_t<G>>;
+};
+
+template <class G>
+struct csv_vertex_value {
+  using type = void;
+};
+template <class G>
+requires requires { typename vertex_value_t<G>; }
+struct csv_vertex_value<G> {
+  using type = remove_cvref_t<vertex_value_t<G>>;
+};
+
+/**
+ * @ingroup graph_io
+ * @brief Creates a graph from a CSV file with read_csv_edges().
+ *
+ * The vertex ids are assigned in the order the labels are first found in the file. If the graph's vertex
+ * value type can be constructed from a string_view, the label of each vertex is stored as its value.
+ *
+ * The edges are loaded with load_unsorted_edges() when the graph has it (csr_graph), so the rows don't need
+ * to be ordered by their source, and with load_edges() otherwise (dynamic_graph).
+ *
+ * @tparam G The graph type. Its edge value type must be void or arithmetic.
+ * @param path   The file to read.
+ * @param format The layout of the file.
+*/
+template <class G>
+G load_csv_graph(const filesystem::path& path, const csv_format& format = {}) {
+  using vertex_id_type    = vertex_id_t<G>;
+  using edge_value_type   = typename csv_edge_value<G>::type;
+  using vertex_value_type = typename csv_vertex_value<G>::type;
+
+  auto csv = read_csv_edges<vertex_id_type, edge_value_type>(path, format);
+  G    g;
+
+  // values for vertices [0, vertex_count)
+  auto ids    = ranges::views::iota(size_t(0), csv.vertex_count());
+  auto vlabel = [&csv](auto id) { // generic so it's only instantiated when there are vertex values
+    const auto uid = static_cast<vertex_id_type>(id);
+    return copyable_vertex_t<vertex_id_type, vertex_value_type>{uid, vertex_value_type(csv.labels[uid])};
+  };
+
+  if constexpr (requires { g.load_unsorted_edges(csv.edges, identity(), csv.vertex_count()); }) {
+    g.load_unsorted_edges(csv.edges, identity(), csv.vertex_count());
+    if constexpr (constructible_from<vertex_value_type, string_view>)
+      g.load_vertices(ids, vlabel, csv.vertex_count());
+  } else {
+    if constexpr (constructible_from<vertex_value_type, string_view>)
+      g.load_vertices(ids, vlabel, csv.vertex_count());
+    g.load_edges(csv.edges, identity(), csv.vertex_count(), csv.edges.size());
+  }
+  return g;
+}
+
+} // namespace std::graph::io
+
+#endif //GRAPH_CSV_HPP
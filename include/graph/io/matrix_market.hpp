@@ -0,0 +1,311 @@
+/**
+ * @file matrix_market.hpp
+ *
+ * @brief Streaming reader for Matrix Market (.mtx) coordinate files.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * @authors
+ *   Andrew Lumsdaine
+ *   Phil Ratzloff
+ */
+
+#include "graph/graph.hpp"
+#include "graph/views/views_utility.hpp"
+#include "graph/detail/mapped_file.hpp"
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <iterator>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <limits>
+
+#ifndef GRAPH_MATRIX_MARKET_HPP
+#  define GRAPH_MATRIX_MARKET_HPP
+
+// mtx_reader<VId,EV>(path) -> forward_range of copyable_edge_t<VId,EV> -> {source_id, target_id [,value]}
+//
+// examples: io::mtx_reader<uint32_t, double> mtx("graph.mtx");
+//
+//           dynamic_adjacency_graph<vofl_graph_traits<double>> g;
+//           g.load_edges(mtx, identity(), mtx.vertex_count());
+//
+//           csr_graph<double> g;
+//           g.load_unsorted_edges(mtx, identity(), mtx.vertex_count());
+//
+namespace std::graph::io {
+
+/**
+ * @brief The field of a Matrix Market file: the type of the values of the entries.
+*/
+enum class mtx_field { pattern, real, integer };
+
+/**
+ * @brief The symmetry of a Matrix Market file. Only the lower triangle of a symmetric matrix is stored.
+*/
+enum class mtx_symmetry { general, symmetric };
+
+/**
+ * @brief The banner and size line of a Matrix Market coordinate file.
+*/
+struct mtx_header {
+  mtx_field    field    = mtx_field::pattern;
+  mtx_symmetry symmetry = mtx_symmetry::general;
+  size_t       rows     = 0;
+  size_t       cols     = 0;
+  size_t       entries  = 0; // number of entries stored in the file
+};
+
+/**
+ * @ingroup graph_io
+ * @brief Reads the entries of a Matrix Market coordinate file as edges.
+ *
+ * The reader is a forward_range of copyable_edge_t<VId,EV>, with an edge (i-1,j-1) for each entry (i,j)
+ * in the file, so it can be passed to the load_edges() functions of the graph containers, or to
+ * csr_graph::load_unsorted_edges() because the entries are rarely ordered by row. The edges are
+ * parsed as the range is iterated, so the file is never copied into an intermediate container.
+ *
+ * The file is memory-mapped and parsed with from_chars, so reading is bound by the speed of the disk
+ * (or the file cache) rather than by formatted stream input. Entries of a symmetric matrix are followed
+ * by their mirror (j-1,i-1), except on the diagonal.
+ *
+ * Coordinate files with pattern, real or integer fields and general or symmetric symmetry are supported.
+ * The constructor throws runtime_error for other files, or when the number of rows or columns doesn't fit
+ * in VId, and iteration throws runtime_error if an entry can't be parsed or is outside of the matrix.
+ *
+ * @tparam VId The vertex id type.
+ * @tparam EV  The edge value type, or void to ignore the values. Values are converted with static_cast;
+ *             entries of a pattern file have a value of 1.
+*/
+template <integral VId = uint32_t, class EV = void>
+class mtx_reader {
+public:
+  using vertex_id_type  = VId;
+  using edge_value_type = EV;
+  using edge_type       = copyable_edge_t<VId, EV>;
+
+  class iterator;
+  using const_iterator = iterator;
+
+public:
+  /**
+   * @brief Open a Matrix Market file and read its header.
+   * @param path The file to read.
+  */
+  explicit mtx_reader(const filesystem::path& path) : file_(path) {
+    const char* pos = reinterpret_cast<const char*>(file_.data());
+    end_            = pos + file_.size();
+    auto fail       = [&path](const string& reason) { throw runtime_error(path.string() + ": " + reason); };
+
+    // %%MatrixMarket matrix coordinate <field> <symmetry>
+    string_view banner = next_line(pos, end_);
+    auto        token  = [&banner]() {
+      banner.remove_prefix(min(banner.find_first_not_of(" \t"), banner.size()));
+      string tok(banner.substr(0, banner.find_first_of(" \t")));
+      banner.remove_prefix(tok.size());
+      for (char& c : tok)
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+      return tok;
+    };
+    if (token() != "%%matrixmarket" || token() != "matrix")
+      fail("not a Matrix Market matrix file");
+    if (token() != "coordinate")
+      fail("only coordinate Matrix Market files are supported");
+    const string field = token();
+    if (field == "pattern")
+      header_.field = mtx_field::pattern;
+    else if (field == "real" || field == "double")
+      header_.field = mtx_field::real;
+    else if (field == "integer")
+      header_.field = mtx_field::integer;
+    else
+      fail("unsupported Matrix Market field " + field);
+    const string symmetry = token();
+    if (symmetry == "general")
+      header_.symmetry = mtx_symmetry::general;
+    else if (symmetry == "symmetric")
+      header_.symmetry = mtx_symmetry::symmetric;
+    else
+      fail("unsupported Matrix Market symmetry " + symmetry);
+
+    // comments, then: <rows> <cols> <entries>
+    string_view size_line;
+    do {
+      if (pos == end_)
+        fail("missing Matrix Market size line");
+      size_line = next_line(pos, end_);
+    } while (is_blank_or_comment(size_line));
+    const char* p = size_line.data();
+    const char* e = p + size_line.size();
+    if (!parse_number(p, e, header_.rows) || !parse_number(p, e, header_.cols) ||
+        !parse_number(p, e, header_.entries))
+      fail("invalid Matrix Market size line");
+    if (max(header_.rows, header_.cols) > static_cast<size_t>(numeric_limits<VId>::max()))
+      fail("Matrix Market dimensions don't fit in the vertex id type");
+    first_ = pos;
+  }
+
+  mtx_reader(mtx_reader&&)            = default;
+  mtx_reader& operator=(mtx_reader&&) = default;
+
+public: // Properties
+  [[nodiscard]] const mtx_header& header() const noexcept { return header_; }
+
+  /**
+   * @brief The number of vertices needed for the edges: the larger of the number of rows and columns.
+  */
+  [[nodiscard]] size_t vertex_count() const noexcept { return max(header_.rows, header_.cols); }
+
+  /**
+   * @brief The largest number of edges, used to reserve space. It's exact for general files; for
+   * symmetric files it includes a mirror edge for the diagonal entries, which don't have one.
+  */
+  [[nodiscard]] size_t max_edge_count() const noexcept {
+    return header_.symmetry == mtx_symmetry::symmetric ? 2 * header_.entries : header_.entries;
+  }
+
+public: // Range
+  [[nodiscard]] iterator            begin() const { return iterator(this, first_); }
+  [[nodiscard]] default_sentinel_t end() const noexcept { return default_sentinel; }
+
+public:
+  /**
+   * @brief Forward iterator over the edges of the file. Each entry is parsed when the iterator is
+   * moved to it.
+  */
+  class iterator {
+  public:
+    using iterator_concept  = forward_iterator_tag;
+    using iterator_category = input_iterator_tag; // operator* returns a value
+    using value_type        = edge_type;
+    using difference_type   = ptrdiff_t;
+    using reference         = value_type;
+
+    iterator() = default;
+
+    [[nodiscard]] value_type operator*() const { return edge_; }
+
+    iterator& operator++() {
+      if (reader_->header_.symmetry == mtx_symmetry::symmetric && !mirror_ && edge_.source_id != edge_.target_id) {
+        swap(edge_.source_id, edge_.target_id);
+        mirror_ = true;
+      } else {
+        read(next_);
+      }
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+      return lhs.entry_ == rhs.entry_ && lhs.mirror_ == rhs.mirror_;
+    }
+    friend bool operator==(const iterator& it, default_sentinel_t) noexcept { return it.entry_ == nullptr; }
+
+  private:
+    friend class mtx_reader;
+    iterator(const mtx_reader* reader, const char* pos) : reader_(reader) { read(pos); }
+
+    // Parse the next entry at or after pos, or move to the end
+    void read(const char* pos) {
+      const char* end = reader_->end_;
+      string_view line;
+      do {
+        if (pos == end) {
+          entry_ = nullptr;
+          mirror_ = false;
+          return;
+        }
+        entry_ = pos;
+        line   = next_line(pos, end);
+      } while (is_blank_or_comment(line));
+      next_   = pos;
+      mirror_ = false;
+
+      const char* p = line.data();
+      const char* e = p + line.size();
+      size_t      row = 0, col = 0;
+      if (!parse_number(p, e, row) || !parse_number(p, e, col))
+        throw runtime_error("invalid Matrix Market entry: " + string(line));
+      if (row == 0 || col == 0 || row > reader_->header_.rows || col > reader_->header_.cols)
+        throw runtime_error("Matrix Market entry is outside of the matrix: " + string(line));
+      edge_.source_id = static_cast<VId>(row - 1);
+      edge_.target_id = static_cast<VId>(col - 1);
+
+      if constexpr (!is_void_v<EV>) {
+        bool ok = true;
+        switch (reader_->header_.field) {
+        case mtx_field::pattern: edge_.value = static_cast<EV>(1); break;
+        case mtx_field::real: {
+          double value = 0;
+          ok           = parse_number(p, e, value);
+          edge_.value  = static_cast<EV>(value);
+        } break;
+        case mtx_field::integer: {
+          int64_t value = 0;
+          ok            = parse_number(p, e, value);
+          edge_.value   = static_cast<EV>(value);
+        } break;
+        }
+        if (!ok)
+          throw runtime_error("invalid Matrix Market value: " + string(line));
+      }
+    }
+
+  private:
+    const mtx_reader* reader_ = nullptr;
+    const char*       entry_  = nullptr; // start of the current entry's line, or nullptr at the end
+    const char*       next_   = nullptr; // start of the line after the current entry
+    bool              mirror_ = false;   // the current edge is the mirror of the entry (symmetric only)
+    edge_type         edge_   = {};
+  };
+
+private:
+  // The line at pos, without the line end. pos is moved to the start of the next line.
+  static string_view next_line(const char*& pos, const char* end) noexcept {
+    const char* eol  = static_cast<const char*>(memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    const char* last = eol ? eol : end;
+    string_view line(pos, static_cast<size_t>(last - pos));
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+    pos = eol ? eol + 1 : end;
+    return line;
+  }
+
+  static bool is_blank_or_comment(string_view line) noexcept {
+    const size_t first = line.find_first_not_of(" \t\r");
+    return first == string_view::npos || line[first] == '%';
+  }
+
+  // Parse a number after optional blanks, moving p past it
+  template <class T>
+  static bool parse_number(const char*& p, const char* e, T& value) noexcept {
+    while (p != e && (*p == ' ' || *p == '\t'))
+      ++p;
+    auto [ptr, ec] = from_chars(p, e, value);
+    if (ec != errc())
+      return false;
+    p = ptr;
+    return true;
+  }
+
+private:
+  _detail::mapped_file file_;
+  mtx_header           header_;
+  const char*          first_ = nullptr; // the line after the size line
+  const char*          end_   = nullptr;
+};
+
+} // namespace std::graph::io
+
+#endif //GRAPH_MATRIX_MARKET_HPP
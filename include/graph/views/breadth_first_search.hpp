@@ -25,12 +25,20 @@
 //
 //  size(bfs) returns the size of the internal queue
 //
+// A search_colors<Alloc> object can be passed after the seed (and value function) as a workspace that is
+// reused across searches. Its reset() is O(1), so each search costs time proportional to the vertices
+// it visits instead of the number of vertices in the graph.
+//   search_colors colors;
+//   for (auto&& seed : seeds)
+//     for(auto&& [vid,v] : vertices_breadth_first_search(g,seed,colors)) ...
+//
 //  bfs.cancel(cancel_search::cancel_branch) will stop searching from the current vertex
 //  bfs.cancel(cancel_search::cancel_all) will stop searching and the iterator will be at the end()
 //
 
 #include "../graph.hpp"
 #include "graph/views/views_utility.hpp"
+#include "graph/container/ring_queue.hpp"
 #include <queue>
 #include <vector>
 #include <functional>
@@ -68,39 +76,25 @@ private:
         vertex_id_type>;
 
 public:
+  using colors_type = search_colors<Alloc>;
+
   bfs_base(graph_type& g, vertex_id_type seed, const Alloc& alloc)
-        : graph_(g), Q_(alloc), colors_(ranges::size(vertices(g)), white, alloc) {
-    if (seed < ranges::size(vertices(graph_)) && !ranges::empty(edges(graph_, seed))) {
-      uv_ = ranges::begin(edges(graph_, seed));
-      Q_.push(queue_elem{seed});
-      colors_[seed] = grey;
-    }
+        : graph_(g), Q_(alloc), colors_(ranges::size(vertices(g)), alloc) {
+    reserve_queue();
+    start(seed);
+  }
+  bfs_base(graph_type& g, vertex_id_type seed, colors_type& colors, const Alloc& alloc)
+        : graph_(g), Q_(alloc), shared_colors_(&colors) {
+    colors.reset(ranges::size(vertices(g)));
+    start(seed);
   }
 
   template <class VKR>
   requires ranges::input_range<VKR> && convertible_to<ranges::range_value_t<VKR>, vertex_id_t<G>>
-  bfs_base(graph_type& g, const VKR& seeds = 0) : graph_(g), colors_(ranges::size(vertices(g)), white) {
-    for (auto&& [seed] : seeds) {
-      if (seed < ranges::size(vertices(graph_)) && !ranges::empty(edges(graph_, seed))) {
-        if (Q_.empty()) {
-          uv_ = ranges::begin(edges(graph_, seed));
-        }
-        Q_.push(queue_elem{seed});
-        colors_[seed] = grey;
-      }
-    }
-    // advance uv_ to the first edge to be visited in case seeds adjacent to first seed
-    while (!Q_.empty()) {
-      auto          u_id = Q_.front();
-      edge_iterator uvi  = find_unvisited(u_id, ranges::begin(edges(graph_, u_id)));
-      if (uvi != ranges::end(edges(graph_, u_id))) {
-        uv_ = uvi;
-        break;
-      } else {
-        Q_.pop();
-        colors_[u_id] = black;
-      }
-    }
+  bfs_base(graph_type& g, const VKR& seeds, const Alloc& alloc)
+        : graph_(g), Q_(alloc), colors_(ranges::size(vertices(g)), alloc) {
+    reserve_queue();
+    start(seeds);
   }
 
   bfs_base()                = default;
@@ -120,6 +114,48 @@ public:
   constexpr cancel_search canceled() noexcept { return cancel_; }
 
 protected:
+  // the colors of the search: the shared workspace passed by the caller, if any
+  constexpr colors_type&       colors() noexcept { return shared_colors_ ? *shared_colors_ : colors_; }
+  constexpr const colors_type& colors() const noexcept { return shared_colors_ ? *shared_colors_ : colors_; }
+
+  // Each vertex is queued at most once, so a queue with reserve() (e.g. ring_queue) never needs to grow.
+  // This isn't done for a shared workspace, where searches are expected to be small.
+  void reserve_queue() {
+    if constexpr (requires(Queue& q) { q.reserve(ranges::size(vertices(graph_))); })
+      Q_.reserve(ranges::size(vertices(graph_)));
+  }
+
+  void start(vertex_id_type seed) {
+    if (seed < ranges::size(vertices(graph_)) && !ranges::empty(edges(graph_, seed))) {
+      uv_ = ranges::begin(edges(graph_, seed));
+      Q_.push(queue_elem{seed});
+      colors().set(seed, grey);
+    }
+  }
+
+  template <class VKR>
+  void start(const VKR& seeds) {
+    for (auto&& seed : seeds) {
+      if (seed < ranges::size(vertices(graph_)) && !ranges::empty(edges(graph_, seed)) &&
+          colors()[seed] == white) {
+        Q_.push(queue_elem{seed});
+        colors().set(seed, grey);
+      }
+    }
+    // advance uv_ to the first edge to be visited in case seeds adjacent to first seed
+    while (!Q_.empty()) {
+      auto          u_id = Q_.front();
+      edge_iterator uvi  = find_unvisited(u_id, ranges::begin(edges(graph_, u_id)));
+      if (uvi != ranges::end(edges(graph_, u_id))) {
+        uv_ = uvi;
+        break;
+      } else {
+        Q_.pop();
+        colors().set(u_id, black);
+      }
+    }
+  }
+
   constexpr vertex_id_type real_target_id(edge_reference uv, vertex_id_type) const
   requires ordered_edge<G, edge_type>
   {
@@ -136,7 +172,7 @@ protected:
 
   constexpr vertex_edge_iterator_t<G> find_unvisited(vertex_id_t<G> uid, vertex_edge_iterator_t<G> first) {
     return ranges::find_if(first, ranges::end(edges(graph_, uid)), [this, uid](edge_reference uv) -> bool {
-      return colors_[real_target_id(uv, uid)] == white;
+      return colors()[real_target_id(uv, uid)] == white;
     });
   }
 
@@ -148,13 +184,13 @@ protected:
     switch (cancel_) {
     case cancel_search::continue_search:
       Q_.push(queue_elem{v_id});
-      colors_[v_id] = grey; // visited v
+      colors().set(v_id, grey); // visited v
       uv_           = find_unvisited(u_id, ++uv_);
       break;
     case cancel_search::cancel_branch:
-      cancel_       = cancel_search::continue_search;
-      colors_[v_id] = black;
-      uv_           = find_unvisited(u_id, ++uv_);
+      cancel_ = cancel_search::continue_search;
+      colors().set(v_id, black);
+      uv_ = find_unvisited(u_id, ++uv_);
       break; // u will be marked completed below
     case cancel_search::cancel_all:
       while (!Q_.empty())
@@ -164,7 +200,7 @@ protected:
 
     // visited all neighbors of u, or cancelled u
     if (uv_ == ranges::end(edges(graph_, u_id))) {
-      colors_[u_id] = black; // finished with u
+      colors().set(u_id, black); // finished with u
       Q_.pop();
       while (!Q_.empty()) {
         u_id = Q_.front();
@@ -173,7 +209,7 @@ protected:
           break;
         } else {
           Q_.pop();
-          colors_[u_id] = black;
+          colors().set(u_id, black);
         }
       }
     }
@@ -183,15 +219,19 @@ protected:
   _detail::ref_to_ptr<graph_type&> graph_;
   Queue                            Q_;
   vertex_edge_iterator_t<G>        uv_;
-  vector<three_colors>             colors_;
-  cancel_search                    cancel_ = cancel_search::continue_search;
+  colors_type                      colors_;                  // used when no shared workspace is passed
+  colors_type*                     shared_colors_ = nullptr; // workspace passed by the caller
+  cancel_search                    cancel_        = cancel_search::continue_search;
 };
 
 //---------------------------------------------------------------------------------------
 /// breadth-first search range for vertices, given a single seed vertex.
 ///
 
-template <adjacency_list G, class VVF = void, class Queue = queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+template <adjacency_list G,
+          class VVF   = void,
+          class Queue = container::ring_queue<vertex_id_t<G>>,
+          class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
 class vertices_breadth_first_search_view : public bfs_base<G, Queue, Alloc> {
 public:
@@ -215,13 +255,19 @@ public:
                                      const VVF&     value_fn,
                                      const Alloc&   alloc = Alloc())
         : base_type(g, seed, alloc), value_fn_(&value_fn) {}
+  vertices_breadth_first_search_view(graph_type&                      g,
+                                     vertex_id_type                   seed,
+                                     const VVF&                       value_fn,
+                                     typename base_type::colors_type& colors,
+                                     const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc), value_fn_(&value_fn) {}
   template <class VKR>
   requires ranges::input_range<VKR> && convertible_to<ranges::range_value_t<VKR>, vertex_id_t<G>>
   vertices_breadth_first_search_view(graph_type&  graph,
                                      const VKR&   seeds,
                                      const VVF&   value_fn,
                                      const Alloc& alloc = Alloc())
-        : base_type(graph, seeds), value_fn_(&value_fn) {}
+        : base_type(graph, seeds, alloc), value_fn_(&value_fn) {}
 
   vertices_breadth_first_search_view()                                          = default;
   vertices_breadth_first_search_view(const vertices_breadth_first_search_view&) = delete; // can be expensive to copy
@@ -322,6 +368,11 @@ public:
 public:
   vertices_breadth_first_search_view(graph_type& g, vertex_id_type seed, const Alloc& alloc = Alloc())
         : base_type(g, seed, alloc) {}
+  vertices_breadth_first_search_view(graph_type&                      g,
+                                     vertex_id_type                   seed,
+                                     typename base_type::colors_type& colors,
+                                     const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc) {}
   template <class VKR>
   requires ranges::forward_range<VKR> && convertible_to<ranges::range_value_t<VKR>, vertex_id_t<G>>
   vertices_breadth_first_search_view(graph_type& g, const VKR& seeds, const Alloc& alloc = Alloc())
@@ -410,7 +461,7 @@ public:
 template <adjacency_list G,
           class EVF    = void,
           bool Sourced = false,
-          class Queue  = queue<vertex_id_t<G>>,
+          class Queue  = container::ring_queue<vertex_id_t<G>>,
           class Alloc  = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
 class edges_breadth_first_search_view : public bfs_base<G, Queue, Alloc> {
@@ -428,6 +479,12 @@ public:
 public:
   edges_breadth_first_search_view(G& g, vertex_id_type seed, const EVF& value_fn, const Alloc& alloc = Alloc())
         : base_type(g, seed, alloc), value_fn_(&value_fn) {}
+  edges_breadth_first_search_view(G&                               g,
+                                  vertex_id_type                   seed,
+                                  const EVF&                       value_fn,
+                                  typename base_type::colors_type& colors,
+                                  const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc), value_fn_(&value_fn) {}
   template <class VKR>
   requires ranges::forward_range<VKR> && convertible_to<ranges::range_value_t<VKR>, vertex_id_t<G>>
   edges_breadth_first_search_view(G& graph, const VKR& seeds, const EVF& value_fn, const Alloc& alloc = Alloc())
@@ -528,9 +585,14 @@ public:
 public:
   edges_breadth_first_search_view(G& g, vertex_id_type seed, const Alloc& alloc = Alloc())
         : base_type(g, seed, alloc) {}
+  edges_breadth_first_search_view(G&                               g,
+                                  vertex_id_type                   seed,
+                                  typename base_type::colors_type& colors,
+                                  const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc) {}
   template <class VKR>
   requires ranges::forward_range<VKR> && convertible_to<ranges::range_value_t<VKR>, vertex_id_t<G>>
-  edges_breadth_first_search_view(G& g, const VKR& seeds, const Alloc& alloc()) : base_type(g, seeds, alloc) {}
+  edges_breadth_first_search_view(G& g, const VKR& seeds, const Alloc& alloc = Alloc()) : base_type(g, seeds, alloc) {}
 
   edges_breadth_first_search_view()                                       = default;
   edges_breadth_first_search_view(const edges_breadth_first_search_view&) = delete; // can be expensive to copy
@@ -657,63 +719,117 @@ namespace std::graph::views {
 //
 // vertices_breadth_first_search(g,uid)
 // vertices_breadth_first_search(g,uid,vvf)
+// vertices_breadth_first_search(g,uid,colors)
+// vertices_breadth_first_search(g,uid,vvf,colors)
 //
-template <adjacency_list G, class Queue = queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+template <adjacency_list G, class Queue = container::ring_queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> && _detail::is_allocator_v<Alloc>
 constexpr auto vertices_breadth_first_search(G&& g, vertex_id_t<G> seed, const Alloc& alloc = Alloc()) {
   if constexpr (tag_invoke::_has_vtx_bfs_adl<G, Alloc>)
     return tag_invoke::vertices_breadth_first_search(g, seed, alloc);
   else
-    return vertices_breadth_first_search_view<G, void, Queue>(g, seed, alloc);
+    return vertices_breadth_first_search_view<G, void, Queue, Alloc>(g, seed, alloc);
+}
+
+template <adjacency_list G, class Queue = container::ring_queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
+constexpr auto vertices_breadth_first_search(G&& g, vertex_id_t<G> seed, search_colors<Alloc>& colors) {
+  return vertices_breadth_first_search_view<G, void, Queue, Alloc>(g, seed, colors, colors.get_allocator());
 }
 
-template <adjacency_list G, class VVF, class Queue = queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+template <adjacency_list G,
+          class VVF,
+          class Queue = container::ring_queue<vertex_id_t<G>>,
+          class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
          is_invocable_v<VVF, vertex_reference_t<G>> && _detail::is_allocator_v<Alloc>
 constexpr auto vertices_breadth_first_search(G&& g, vertex_id_t<G> seed, const VVF& vvf, const Alloc& alloc = Alloc()) {
   if constexpr (tag_invoke::_has_vtx_bfs_vvf_adl<G, VVF, Alloc>)
     return tag_invoke::vertices_breadth_first_search(g, seed, vvf, alloc);
   else
-    return vertices_breadth_first_search_view<G, VVF, Queue>(g, seed, vvf, alloc);
+    return vertices_breadth_first_search_view<G, VVF, Queue, Alloc>(g, seed, vvf, alloc);
+}
+
+template <adjacency_list G,
+          class VVF,
+          class Queue = container::ring_queue<vertex_id_t<G>>,
+          class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         is_invocable_v<VVF, vertex_reference_t<G>>
+constexpr auto
+vertices_breadth_first_search(G&& g, vertex_id_t<G> seed, const VVF& vvf, search_colors<Alloc>& colors) {
+  return vertices_breadth_first_search_view<G, VVF, Queue, Alloc>(g, seed, vvf, colors, colors.get_allocator());
 }
 
 //
 // edges_breadth_first_search(g,uid)
 // edges_breadth_first_search(g,uid,evf)
+// edges_breadth_first_search(g,uid,colors)
+// edges_breadth_first_search(g,uid,evf,colors)
 //
-template <adjacency_list G, class Queue = queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+template <adjacency_list G, class Queue = container::ring_queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> && _detail::is_allocator_v<Alloc>
 constexpr auto edges_breadth_first_search(G&& g, vertex_id_t<G> seed, const Alloc& alloc = Alloc()) {
   if constexpr (tag_invoke::_has_edg_bfs_adl<G, Alloc>)
     return tag_invoke::edges_breadth_first_search(g, seed, alloc);
   else
-    return edges_breadth_first_search_view<G, void, false, Queue>(g, seed, alloc);
+    return edges_breadth_first_search_view<G, void, false, Queue, Alloc>(g, seed, alloc);
+}
+
+template <adjacency_list G, class Queue = container::ring_queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
+constexpr auto edges_breadth_first_search(G&& g, vertex_id_t<G> seed, search_colors<Alloc>& colors) {
+  return edges_breadth_first_search_view<G, void, false, Queue, Alloc>(g, seed, colors, colors.get_allocator());
 }
 
-template <adjacency_list G, class EVF, class Queue = queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+template <adjacency_list G,
+          class EVF,
+          class Queue = container::ring_queue<vertex_id_t<G>>,
+          class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
          is_invocable_v<EVF, edge_reference_t<G>> && _detail::is_allocator_v<Alloc>
 constexpr auto edges_breadth_first_search(G&& g, vertex_id_t<G> seed, const EVF& evf, const Alloc& alloc = Alloc()) {
   if constexpr (tag_invoke::_has_edg_bfs_evf_adl<G, EVF, Alloc>)
     return tag_invoke::edges_breadth_first_search(g, seed, evf, alloc);
   else
-    return edges_breadth_first_search_view<G, EVF, false, Queue>(g, seed, evf, alloc);
+    return edges_breadth_first_search_view<G, EVF, false, Queue, Alloc>(g, seed, evf, alloc);
+}
+
+template <adjacency_list G,
+          class EVF,
+          class Queue = container::ring_queue<vertex_id_t<G>>,
+          class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         is_invocable_v<EVF, edge_reference_t<G>>
+constexpr auto edges_breadth_first_search(G&& g, vertex_id_t<G> seed, const EVF& evf, search_colors<Alloc>& colors) {
+  return edges_breadth_first_search_view<G, EVF, false, Queue, Alloc>(g, seed, evf, colors, colors.get_allocator());
 }
 
 //
 // sourced_edges_breadth_first_search(g,uid)
 // sourced_edges_breadth_first_search(g,uid,evf)
+// sourced_edges_breadth_first_search(g,uid,colors)
+// sourced_edges_breadth_first_search(g,uid,evf,colors)
 //
-template <adjacency_list G, class Queue = queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+template <adjacency_list G, class Queue = container::ring_queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> && _detail::is_allocator_v<Alloc>
 constexpr auto sourced_edges_breadth_first_search(G&& g, vertex_id_t<G> seed, const Alloc& alloc = Alloc()) {
   if constexpr (tag_invoke::_has_src_edg_bfs_adl<G, Alloc>)
     return tag_invoke::sourced_edges_breadth_first_search(g, seed, alloc);
   else
-    return edges_breadth_first_search_view<G, void, true, Queue>(g, seed, alloc);
+    return edges_breadth_first_search_view<G, void, true, Queue, Alloc>(g, seed, alloc);
 }
 
-template <adjacency_list G, class EVF, class Queue = queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+template <adjacency_list G, class Queue = container::ring_queue<vertex_id_t<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
+constexpr auto sourced_edges_breadth_first_search(G&& g, vertex_id_t<G> seed, search_colors<Alloc>& colors) {
+  return edges_breadth_first_search_view<G, void, true, Queue, Alloc>(g, seed, colors, colors.get_allocator());
+}
+
+template <adjacency_list G,
+          class EVF,
+          class Queue = container::ring_queue<vertex_id_t<G>>,
+          class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
          is_invocable_v<EVF, edge_reference_t<G>> && _detail::is_allocator_v<Alloc>
 constexpr auto
@@ -721,7 +837,18 @@ sourced_edges_breadth_first_search(G&& g, vertex_id_t<G> seed, const EVF& evf, c
   if constexpr (tag_invoke::_has_src_edg_bfs_evf_adl<G, EVF, Alloc>)
     return tag_invoke::sourced_edges_breadth_first_search(g, seed, evf, alloc);
   else
-    return edges_breadth_first_search_view<G, EVF, true, Queue>(g, seed, evf, alloc);
+    return edges_breadth_first_search_view<G, EVF, true, Queue, Alloc>(g, seed, evf, alloc);
+}
+
+template <adjacency_list G,
+          class EVF,
+          class Queue = container::ring_queue<vertex_id_t<G>>,
+          class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         is_invocable_v<EVF, edge_reference_t<G>>
+constexpr auto
+sourced_edges_breadth_first_search(G&& g, vertex_id_t<G> seed, const EVF& evf, search_colors<Alloc>& colors) {
+  return edges_breadth_first_search_view<G, EVF, true, Queue, Alloc>(g, seed, evf, colors, colors.get_allocator());
 }
 
 
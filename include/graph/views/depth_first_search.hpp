@@ -19,6 +19,10 @@
 //
 //  size(dfs) returns the depth of the current search (the size of the internal stack)
 //
+// A search_colors<Alloc> object can be passed after the seed (and value function) as a workspace that is
+// reused across searches, so each search costs time proportional to the vertices it visits. See
+// breadth_first_search.hpp.
+//
 //  dfs.cancel(cancel_search::cancel_branch) will stop searching from the current vertex
 //  dfs.cancel(cancel_search::cancel_all) will stop searching and the iterator will be at the end()
 //
@@ -68,19 +72,16 @@ private:
         vertex_id_type>;
 
 public:
-  dfs_base(graph_type& g, vertex_id_type seed, const Alloc& alloc)
-        : graph_(g), S_(alloc), colors_(ranges::size(vertices(g)), white, alloc) {
-    if (seed < static_cast<vertex_id_type>(ranges::size(vertices(graph_))) && !ranges::empty(edges(graph_, seed))) {
-      edge_iterator uvi = ranges::begin(edges(graph_, seed));
-      S_.push(stack_elem{seed, uvi});
-      colors_[seed] = grey;
+  using colors_type = search_colors<Alloc>;
 
-      // Mark initial vertex as visited
-      if (uvi != ranges::end(edges(graph_, seed))) {
-        vertex_id_type v_id = real_target_id(*uvi, seed);
-        colors_[v_id]       = grey;
-      }
-    }
+  dfs_base(graph_type& g, vertex_id_type seed, const Alloc& alloc)
+        : graph_(g), S_(alloc), colors_(ranges::size(vertices(g)), alloc) {
+    start(seed);
+  }
+  dfs_base(graph_type& g, vertex_id_type seed, colors_type& colors, const Alloc& alloc)
+        : graph_(g), S_(alloc), shared_colors_(&colors) {
+    colors.reset(ranges::size(vertices(g)));
+    start(seed);
   }
   dfs_base()                = default;
   dfs_base(const dfs_base&) = delete; // can be expensive to copy
@@ -99,6 +100,24 @@ public:
   constexpr cancel_search canceled() noexcept { return cancel_; }
 
 protected:
+  // the colors of the search: the shared workspace passed by the caller, if any
+  constexpr colors_type&       colors() noexcept { return shared_colors_ ? *shared_colors_ : colors_; }
+  constexpr const colors_type& colors() const noexcept { return shared_colors_ ? *shared_colors_ : colors_; }
+
+  void start(vertex_id_type seed) {
+    if (seed < static_cast<vertex_id_type>(ranges::size(vertices(graph_))) && !ranges::empty(edges(graph_, seed))) {
+      edge_iterator uvi = ranges::begin(edges(graph_, seed));
+      S_.push(stack_elem{seed, uvi});
+      colors().set(seed, grey);
+
+      // Mark initial vertex as visited
+      if (uvi != ranges::end(edges(graph_, seed))) {
+        vertex_id_type v_id = real_target_id(*uvi, seed);
+        colors().set(v_id, grey);
+      }
+    }
+  }
+
   constexpr vertex_id_type real_target_id(edge_reference uv, vertex_id_type) const
   requires ordered_edge<G, edge_type>
   {
@@ -115,7 +134,7 @@ protected:
 
   constexpr vertex_edge_iterator_t<G> find_unvisited(vertex_id_t<G> uid, vertex_edge_iterator_t<G> first) {
     return ranges::find_if(first, ranges::end(edges(graph_, uid)), [this, uid](edge_reference uv) -> bool {
-      return colors_[real_target_id(uv, uid)] == white;
+      return colors()[real_target_id(uv, uid)] == white;
     });
   }
 
@@ -131,8 +150,8 @@ protected:
       vwi = find_unvisited(v_id, ranges::begin(edges(graph_, v_id)));
       break;
     case cancel_search::cancel_branch: {
-      cancel_       = cancel_search::continue_search;
-      colors_[v_id] = black; // finished with v
+      cancel_ = cancel_search::continue_search;
+      colors().set(v_id, black); // finished with v
 
       // Continue with sibling?
       uvi = find_unvisited(u_id, ++uvi);
@@ -152,11 +171,11 @@ protected:
     if (vwi != ranges::end(edges(graph_, v_id))) {
       S_.push(stack_elem{v_id, vwi});
       vertex_id_type w_id = real_target_id(*vwi, v_id);
-      colors_[w_id]       = grey; // visited w
+      colors().set(w_id, grey); // visited w
     }
     // we've reached the end of a branch in the DFS tree; start unwinding the stack to find other unvisited branches
     else {
-      colors_[v_id] = black; // finished with v
+      colors().set(v_id, black); // finished with v
       S_.pop();
       while (!S_.empty()) {
         auto [x_id, xyi] = S_.top();
@@ -167,10 +186,10 @@ protected:
         if (xyi != ranges::end(edges(graph_, x_id))) {
           S_.push({x_id, xyi});
           vertex_id_type y_id = real_target_id(*xyi, x_id);
-          colors_[y_id]       = grey; // visited y
+          colors().set(y_id, grey); // visited y
           break;
         } else {
-          colors_[x_id] = black; // finished with x
+          colors().set(x_id, black); // finished with x
         }
       }
     }
@@ -179,8 +198,9 @@ protected:
 protected:
   _detail::ref_to_ptr<graph_type&> graph_;
   Stack                            S_;
-  vector<three_colors>             colors_;
-  cancel_search                    cancel_ = cancel_search::continue_search;
+  colors_type                      colors_;                  // used when no shared workspace is passed
+  colors_type*                     shared_colors_ = nullptr; // workspace passed by the caller
+  cancel_search                    cancel_        = cancel_search::continue_search;
 };
 
 
@@ -211,6 +231,12 @@ public:
                                    const VVF&     value_fn,
                                    const Alloc&   alloc = Alloc())
         : base_type(g, seed, alloc), value_fn_(&value_fn) {}
+  vertices_depth_first_search_view(graph_type&                      g,
+                                   vertex_id_type                   seed,
+                                   const VVF&                       value_fn,
+                                   typename base_type::colors_type& colors,
+                                   const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc), value_fn_(&value_fn) {}
   vertices_depth_first_search_view()                                        = default;
   vertices_depth_first_search_view(const vertices_depth_first_search_view&) = delete; // can be expensive to copy
   vertices_depth_first_search_view(vertices_depth_first_search_view&&)      = default;
@@ -308,6 +334,11 @@ public:
 public:
   vertices_depth_first_search_view(graph_type& g, vertex_id_type seed, const Alloc& alloc = Alloc())
         : base_type(g, seed, alloc) {}
+  vertices_depth_first_search_view(graph_type&                      g,
+                                   vertex_id_type                   seed,
+                                   typename base_type::colors_type& colors,
+                                   const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc) {}
   vertices_depth_first_search_view()                                        = default;
   vertices_depth_first_search_view(const vertices_depth_first_search_view&) = delete; // can be expensive to copy
   vertices_depth_first_search_view(vertices_depth_first_search_view&&)      = default;
@@ -408,6 +439,12 @@ public:
 public:
   edges_depth_first_search_view(G& g, vertex_id_type seed, const EVF& value_fn, const Alloc& alloc = Alloc())
         : base_type(g, seed, alloc), value_fn_(&value_fn) {}
+  edges_depth_first_search_view(G&                               g,
+                                vertex_id_type                   seed,
+                                const EVF&                       value_fn,
+                                typename base_type::colors_type& colors,
+                                const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc), value_fn_(&value_fn) {}
 
   edges_depth_first_search_view()                                     = default;
   edges_depth_first_search_view(const edges_depth_first_search_view&) = delete; // can be expensive to copy
@@ -502,6 +539,11 @@ public:
 
 public:
   edges_depth_first_search_view(G& g, vertex_id_type seed, const Alloc& alloc = Alloc()) : base_type(g, seed, alloc) {}
+  edges_depth_first_search_view(G&                               g,
+                                vertex_id_type                   seed,
+                                typename base_type::colors_type& colors,
+                                const Alloc&                     alloc = Alloc())
+        : base_type(g, seed, colors, alloc) {}
 
   edges_depth_first_search_view()                                     = default;
   edges_depth_first_search_view(const edges_depth_first_search_view&) = delete; // can be expensive to copy
@@ -626,6 +668,8 @@ namespace std::graph::views {
 //
 // vertices_depth_first_search(g,uid,alloc)
 // vertices_depth_first_search(g,uid,vvf,alloc)
+// vertices_depth_first_search(g,uid,colors)
+// vertices_depth_first_search(g,uid,vvf,colors)
 //
 template <adjacency_list G, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> && _detail::is_allocator_v<Alloc>
@@ -633,7 +677,13 @@ constexpr auto vertices_depth_first_search(G&& g, vertex_id_t<G> seed, const All
   if constexpr (std::graph::tag_invoke::_has_vtx_dfs_adl<G, Alloc>)
     return std::graph::tag_invoke::vertices_depth_first_search(g, seed, alloc);
   else
-    return vertices_depth_first_search_view<G, void, Stack>(g, seed, alloc);
+    return vertices_depth_first_search_view<G, void, Stack, Alloc>(g, seed, alloc);
+}
+
+template <adjacency_list G, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
+constexpr auto vertices_depth_first_search(G&& g, vertex_id_t<G> seed, search_colors<Alloc>& colors) {
+  return vertices_depth_first_search_view<G, void, Stack, Alloc>(g, seed, colors, colors.get_allocator());
 }
 
 template <adjacency_list G, class VVF, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
@@ -643,12 +693,21 @@ constexpr auto vertices_depth_first_search(G&& g, vertex_id_t<G> seed, const VVF
   if constexpr (std::graph::tag_invoke::_has_vtx_dfs_vvf_adl<G, VVF, Alloc>)
     return std::graph::tag_invoke::vertices_depth_first_search(g, seed, vvf, alloc);
   else
-    return vertices_depth_first_search_view<G, VVF, Stack>(g, seed, vvf, alloc);
+    return vertices_depth_first_search_view<G, VVF, Stack, Alloc>(g, seed, vvf, alloc);
+}
+
+template <adjacency_list G, class VVF, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         invocable<VVF, vertex_reference_t<G>>
+constexpr auto vertices_depth_first_search(G&& g, vertex_id_t<G> seed, const VVF& vvf, search_colors<Alloc>& colors) {
+  return vertices_depth_first_search_view<G, VVF, Stack, Alloc>(g, seed, vvf, colors, colors.get_allocator());
 }
 
 //
 // edges_depth_first_search(g,uid,alloc)
 // edges_depth_first_search(g,uid,evf,alloc)
+// edges_depth_first_search(g,uid,colors)
+// edges_depth_first_search(g,uid,evf,colors)
 //
 template <adjacency_list G, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> && _detail::is_allocator_v<Alloc>
@@ -656,7 +715,13 @@ constexpr auto edges_depth_first_search(G&& g, vertex_id_t<G> seed, const Alloc&
   if constexpr (std::graph::tag_invoke::_has_edg_dfs_adl<G, Alloc>)
     return std::graph::tag_invoke::edges_depth_first_search(g, seed, alloc);
   else
-    return edges_depth_first_search_view<G, void, false, Stack>(g, seed, alloc);
+    return edges_depth_first_search_view<G, void, false, Stack, Alloc>(g, seed, alloc);
+}
+
+template <adjacency_list G, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
+constexpr auto edges_depth_first_search(G&& g, vertex_id_t<G> seed, search_colors<Alloc>& colors) {
+  return edges_depth_first_search_view<G, void, false, Stack, Alloc>(g, seed, colors, colors.get_allocator());
 }
 
 template <adjacency_list G, class EVF, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
@@ -666,12 +731,21 @@ constexpr auto edges_depth_first_search(G&& g, vertex_id_t<G> seed, const EVF& e
   if constexpr (std::graph::tag_invoke::_has_edg_dfs_evf_adl<G, EVF, Alloc>)
     return std::graph::tag_invoke::edges_depth_first_search(g, seed, evf, alloc);
   else
-    return edges_depth_first_search_view<G, EVF, false, Stack>(g, seed, evf, alloc);
+    return edges_depth_first_search_view<G, EVF, false, Stack, Alloc>(g, seed, evf, alloc);
+}
+
+template <adjacency_list G, class EVF, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         invocable<EVF, edge_reference_t<G>>
+constexpr auto edges_depth_first_search(G&& g, vertex_id_t<G> seed, const EVF& evf, search_colors<Alloc>& colors) {
+  return edges_depth_first_search_view<G, EVF, false, Stack, Alloc>(g, seed, evf, colors, colors.get_allocator());
 }
 
 //
 // sourced_edges_depth_first_search(g,uid,alloc)
 // sourced_edges_depth_first_search(g,uid,evf,alloc)
+// sourced_edges_depth_first_search(g,uid,colors)
+// sourced_edges_depth_first_search(g,uid,evf,colors)
 //
 template <adjacency_list G, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
 requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> && _detail::is_allocator_v<Alloc>
@@ -679,7 +753,13 @@ constexpr auto sourced_edges_depth_first_search(G&& g, vertex_id_t<G> seed, cons
   if constexpr (std::graph::tag_invoke::_has_src_edg_dfs_adl<G, Alloc>)
     return std::graph::tag_invoke::sourced_edges_depth_first_search(g, seed, alloc);
   else
-    return edges_depth_first_search_view<G, void, true, Stack>(g, seed, alloc);
+    return edges_depth_first_search_view<G, void, true, Stack, Alloc>(g, seed, alloc);
+}
+
+template <adjacency_list G, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>>
+constexpr auto sourced_edges_depth_first_search(G&& g, vertex_id_t<G> seed, search_colors<Alloc>& colors) {
+  return edges_depth_first_search_view<G, void, true, Stack, Alloc>(g, seed, colors, colors.get_allocator());
 }
 
 template <adjacency_list G, class EVF, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
@@ -690,7 +770,15 @@ sourced_edges_depth_first_search(G&& g, vertex_id_t<G> seed, const EVF& evf, con
   if constexpr (std::graph::tag_invoke::_has_src_edg_dfs_evf_adl<G, EVF, Alloc>)
     return std::graph::tag_invoke::sourced_edges_depth_first_search(g, seed, evf, alloc);
   else
-    return edges_depth_first_search_view<G, EVF, true, Stack>(g, seed, evf, alloc);
+    return edges_depth_first_search_view<G, EVF, true, Stack, Alloc>(g, seed, evf, alloc);
+}
+
+template <adjacency_list G, class EVF, class Stack = stack<dfs_element<G>>, class Alloc = allocator<bool>>
+requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_id_t<G>> &&
+         invocable<EVF, edge_reference_t<G>>
+constexpr auto
+sourced_edges_depth_first_search(G&& g, vertex_id_t<G> seed, const EVF& evf, search_colors<Alloc>& colors) {
+  return edges_depth_first_search_view<G, EVF, true, Stack, Alloc>(g, seed, evf, colors, colors.get_allocator());
 }
 
 
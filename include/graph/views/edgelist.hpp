@@ -1,5 +1,6 @@
 #pragma once
 #include "graph/graph.hpp"
+#include "views_utility.hpp"
 
 //
 // edgelist(g,u) -> edge_view<VId,true,E,EV> -> {source_id, target_id, edge& [,value]}
@@ -243,7 +244,9 @@ private: // member variables
 template <class G, class EVF>
 using edgelist_view = ranges::subrange<edgelist_iterator<G, EVF>, vertex_iterator_t<G>>;
 
-namespace tag_invoke {
+} // namespace std::graph::views
+
+namespace std::graph::tag_invoke {
   // ranges
   TAG_INVOKE_DEF(edgelist); // edgelist(g)                 -> edges[uid,vid,uv]
                             // edgelist(g,fn)              -> edges[uid,vid,uv,value]
@@ -268,7 +271,9 @@ namespace tag_invoke {
                                { edgelist(g, uid, vid, evf) };
                              };
 
-} // namespace tag_invoke
+} // namespace std::graph::tag_invoke
+
+namespace std::graph::views {
 
 //
 // edgelist(g)
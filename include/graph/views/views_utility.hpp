@@ -1,11 +1,120 @@
 #pragma once
 
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+
 namespace std::graph {
 
 // Common types for DFS & BFS views
 enum three_colors : int8_t { black, white, grey }; // { finished, undiscovered, discovered }
 enum struct cancel_search : int8_t { continue_search, cancel_branch, cancel_all };
 
+/// <summary>
+/// The three_colors of the vertices in a depth-first or breadth-first search, packed at 2 bits per vertex.
+///
+/// A search_colors object can be passed to the search views as a workspace that is reused across searches,
+/// avoiding an allocation and an O(|V|) initialization for each one. reset() makes all vertices white in O(1)
+/// by advancing a generation counter. Each word of colors records the generation it was last written in, and
+/// a word from an earlier generation is white, so a search only touches the words of the vertices it visits.
+/// </summary>
+/// <typeparam name="Alloc">The allocator type. It is rebound for the internal containers.</typeparam>
+template <class Alloc = allocator<bool>>
+class search_colors {
+  using word_type        = uint64_t;
+  using generation_type  = uint32_t;
+  using word_alloc       = typename allocator_traits<Alloc>::template rebind_alloc<word_type>;
+  using generation_alloc = typename allocator_traits<Alloc>::template rebind_alloc<generation_type>;
+
+  static constexpr size_t colors_per_word = numeric_limits<word_type>::digits / 2;
+
+public:
+  using size_type      = size_t;
+  using allocator_type = Alloc;
+
+  explicit search_colors(const Alloc& alloc = Alloc()) : words_(alloc), generations_(alloc) {}
+  explicit search_colors(size_type n, const Alloc& alloc = Alloc()) : words_(alloc), generations_(alloc) {
+    resize(n);
+  }
+
+  search_colors(const search_colors&) = default;
+  search_colors(search_colors&&)      = default;
+  ~search_colors()                    = default;
+
+  search_colors& operator=(const search_colors&) = default;
+  search_colors& operator=(search_colors&&)      = default;
+
+  constexpr allocator_type get_allocator() const { return allocator_type(words_.get_allocator()); }
+
+  /// <summary>
+  /// The number of vertices.
+  /// </summary>
+  constexpr size_type size() const noexcept { return size_; }
+
+  /// <summary>
+  /// Change the number of vertices to n and make all vertices white.
+  /// </summary>
+  void resize(size_type n) {
+    const size_type nwords = (n + colors_per_word - 1) / colors_per_word;
+    words_.resize(nwords);
+    generations_.resize(nwords);
+    size_ = n;
+    reset();
+  }
+
+  /// <summary>
+  /// Make all vertices white for a new search. The words are cleared lazily when they're first written.
+  /// </summary>
+  void reset() noexcept {
+    if (++generation_ == 0) { // wrapped around; invalidate all words
+      ranges::fill(generations_, generation_type(0));
+      generation_ = 1;
+    }
+  }
+
+  /// <summary>
+  /// Make sure there are at least n vertices and make all vertices white for a new search.
+  /// </summary>
+  void reset(size_type n) {
+    if (size_ < n)
+      resize(n);
+    else
+      reset();
+  }
+
+  constexpr three_colors operator[](size_type uid) const noexcept {
+    assert(uid < size_);
+    const size_type w = uid / colors_per_word;
+    if (generations_[w] != generation_)
+      return white;
+    return static_cast<three_colors>(((words_[w] >> shift(uid)) & 3u) ^ 1u);
+  }
+
+  constexpr void set(size_type uid, three_colors color) noexcept {
+    assert(uid < size_);
+    const size_type w = uid / colors_per_word;
+    if (generations_[w] != generation_) {
+      words_[w]       = 0; // all white
+      generations_[w] = generation_;
+    }
+    const size_t s = shift(uid);
+    words_[w]      = (words_[w] & ~(word_type(3) << s)) | (word_type(static_cast<unsigned>(color) ^ 1u) << s);
+  }
+
+private:
+  // The stored 2-bit value is color ^ 1 so that white is 0: black=1, white=0, grey=3.
+  static constexpr size_t shift(size_type uid) noexcept { return (uid % colors_per_word) * 2; }
+
+private:
+  vector<word_type, word_alloc>             words_;
+  vector<generation_type, generation_alloc> generations_;
+  size_type                                 size_       = 0;
+  generation_type                           generation_ = 0;
+};
+
 
 //
 // vertex_view
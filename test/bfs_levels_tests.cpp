@@ -0,0 +1,153 @@
+#include <catch2/catch.hpp>
+#include "csv_routes.hpp"
+#include "graph/graph.hpp"
+#include "graph/algorithm/bfs_levels.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include "graph/container/csr_graph.hpp"
+#include <vector>
+#include <queue>
+#include <random>
+#include <algorithm>
+#include <limits>
+
+using std::vector;
+
+using std::graph::vertex_id_t;
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+
+using std::graph::breadth_first_search_levels;
+
+using routes_volf_graph_traits = std::graph::container::vofl_graph_traits<double, std::string>;
+using routes_volf_graph_type   = std::graph::container::dynamic_adjacency_graph<routes_volf_graph_traits>;
+
+using levels_csr_graph_type = std::graph::container::csr_graph<int, void, void>;
+using levels_edge_type      = std::graph::copyable_edge_t<uint32_t, int>;
+
+// Sequential reference BFS
+template <class G>
+static vector<uint32_t> reference_levels(G&& g, const vector<vertex_id_t<G>>& seeds) {
+  constexpr uint32_t        unreached = std::numeric_limits<uint32_t>::max();
+  vector<uint32_t>          level(std::ranges::size(vertices(g)), unreached);
+  std::queue<vertex_id_t<G>> q;
+  for (auto&& seed : seeds) {
+    if (level[seed] == unreached) {
+      level[seed] = 0;
+      q.push(seed);
+    }
+  }
+  while (!q.empty()) {
+    auto uid = q.front();
+    q.pop();
+    for (auto&& uv : edges(g, uid)) {
+      auto vid = target_id(g, uv);
+      if (level[vid] == unreached) {
+        level[vid] = level[uid] + 1;
+        q.push(vid);
+      }
+    }
+  }
+  return level;
+}
+
+static levels_csr_graph_type make_levels_graph(vector<levels_edge_type> edge_list, uint32_t vertex_count) {
+  std::ranges::sort(edge_list, [](auto&& lhs, auto&& rhs) {
+    return std::tie(lhs.source_id, lhs.target_id) < std::tie(rhs.source_id, rhs.target_id);
+  });
+  levels_csr_graph_type g;
+  g.load_edges(edge_list, std::identity(), vertex_count);
+  return g;
+}
+
+// A random directed graph with a few high-degree hubs so the frontier grows quickly, plus a set of
+// vertices that are only reachable through a long chain so the search switches back to top-down.
+static vector<levels_edge_type> make_levels_edges(uint32_t vertex_count, uint32_t avg_degree, uint32_t chain) {
+  std::mt19937                            rng(7);
+  std::uniform_int_distribution<uint32_t> any(0, vertex_count - chain - 1);
+  vector<levels_edge_type>                edge_list;
+  for (uint32_t uid = 0; uid < vertex_count - chain; ++uid)
+    for (uint32_t i = 0; i < avg_degree; ++i)
+      edge_list.push_back({uid, any(rng), 0});
+  for (uint32_t uid = 0; uid < 16; ++uid)
+    for (uint32_t i = 0; i < 200; ++i)
+      edge_list.push_back({uid, any(rng), 0});
+  for (uint32_t uid = vertex_count - chain - 1; uid + 1 < vertex_count; ++uid)
+    edge_list.push_back({uid, uid + 1, 0});
+  return edge_list;
+}
+
+static vector<levels_edge_type> transpose_edges(vector<levels_edge_type> edge_list) {
+  for (auto&& uv : edge_list)
+    std::swap(uv.source_id, uv.target_id);
+  return edge_list;
+}
+
+TEST_CASE("breadth_first_search_levels on routes", "[csv][vofl][bfs][bfs_levels]") {
+  init_console();
+  using G     = routes_volf_graph_type;
+  auto&& g    = load_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+  auto frankfurt_id = find_city_id(g, "Frankf\xC3\xBCrt");
+
+  vector<uint32_t> expected = reference_levels(g, {frankfurt_id});
+  vector<uint32_t> level(size(vertices(g)));
+  for (size_t num_threads : {size_t(1), size_t(3)}) {
+    breadth_first_search_levels(g, vector{frankfurt_id}, level, num_threads);
+    REQUIRE(level == expected);
+  }
+  REQUIRE(level[frankfurt_id] == 0);
+}
+
+TEST_CASE("breadth_first_search_levels direction-optimizing", "[bfs][bfs_levels]") {
+  constexpr uint32_t vertex_count = 20000;
+  constexpr uint32_t chain        = 300;
+  auto               edge_list    = make_levels_edges(vertex_count, 6, chain);
+  auto               g            = make_levels_graph(edge_list, vertex_count);
+  auto               gt           = make_levels_graph(transpose_edges(edge_list), vertex_count);
+  constexpr uint32_t unreached    = std::numeric_limits<uint32_t>::max();
+
+  SECTION("single seed") {
+    vector<uint32_t> expected = reference_levels(g, {0});
+    REQUIRE(std::ranges::count(expected, unreached) < vertex_count / 10); // mostly reachable
+    REQUIRE(expected.back() > chain);                                      // includes the long chain
+    vector<uint32_t> level(vertex_count);
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      breadth_first_search_levels(g, gt, vector<uint32_t>{0}, level, num_threads);
+      REQUIRE(level == expected);
+      std::ranges::fill(level, 0);
+      breadth_first_search_levels(g, vector<uint32_t>{0}, level, num_threads);
+      REQUIRE(level == expected);
+    }
+  }
+  SECTION("multiple seeds, including duplicates") {
+    vector<uint32_t> seeds    = {vertex_count - 1, 5, 5, vertex_count - chain / 2};
+    vector<uint32_t> expected = reference_levels(g, seeds);
+    vector<uint32_t> level(vertex_count);
+    breadth_first_search_levels(g, gt, seeds, level, 3);
+    REQUIRE(level == expected);
+    REQUIRE(level[vertex_count - 1] == 0);
+  }
+  SECTION("unreachable vertices") {
+    // the last vertex of the chain has no outgoing edges
+    vector<uint32_t> level(vertex_count, 0);
+    breadth_first_search_levels(g, gt, vector<uint32_t>{vertex_count - 1}, level, 2);
+    REQUIRE(level[vertex_count - 1] == 0);
+    REQUIRE(std::ranges::count(level, unreached) == vertex_count - 1);
+  }
+}
+
+TEST_CASE("breadth_first_search_levels on a symmetric graph", "[bfs][bfs_levels]") {
+  constexpr uint32_t vertex_count = 5000;
+  auto               edge_list    = make_levels_edges(vertex_count, 4, 1);
+  auto               reverse      = transpose_edges(edge_list);
+  edge_list.insert(edge_list.end(), reverse.begin(), reverse.end());
+  auto g = make_levels_graph(edge_list, vertex_count);
+
+  vector<uint32_t> expected = reference_levels(g, {42});
+  vector<uint16_t> level(vertex_count);
+  breadth_first_search_levels(g, g, vector<uint32_t>{42}, level, 4);
+  for (uint32_t uid = 0; uid < vertex_count; ++uid)
+    REQUIRE(static_cast<uint32_t>(level[uid]) ==
+            (expected[uid] == std::numeric_limits<uint32_t>::max() ? std::numeric_limits<uint16_t>::max()
+                                                                    : expected[uid]));
+}
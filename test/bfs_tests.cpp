@@ -1085,3 +1085,87 @@ TEST_CASE("edges_breadth_first_search test", "[dynamic][bfs][edge]") {
     REQUIRE(6 == city_cnt);
   }
 }
+
+TEST_CASE("search_colors", "[bfs][dfs][search_colors]") {
+  using std::graph::three_colors;
+  std::graph::search_colors<> colors(100);
+  REQUIRE(colors.size() == 100);
+  for (size_t uid = 0; uid < colors.size(); ++uid)
+    REQUIRE(colors[uid] == std::graph::white);
+
+  colors.set(0, std::graph::grey);
+  colors.set(31, std::graph::black);
+  colors.set(32, std::graph::grey);
+  colors.set(99, std::graph::black);
+  REQUIRE(colors[0] == std::graph::grey);
+  REQUIRE(colors[1] == std::graph::white);
+  REQUIRE(colors[31] == std::graph::black);
+  REQUIRE(colors[32] == std::graph::grey);
+  REQUIRE(colors[99] == std::graph::black);
+  colors.set(0, std::graph::black);
+  REQUIRE(colors[0] == std::graph::black);
+  colors.set(0, std::graph::white);
+  REQUIRE(colors[0] == std::graph::white);
+
+  colors.reset();
+  for (size_t uid = 0; uid < colors.size(); ++uid)
+    REQUIRE(colors[uid] == std::graph::white);
+  colors.set(33, std::graph::grey);
+  REQUIRE(colors[32] == std::graph::white); // rest of the word is cleared on first write
+  REQUIRE(colors[33] == std::graph::grey);
+
+  colors.reset(200);
+  REQUIRE(colors.size() == 200);
+  REQUIRE(colors[33] == std::graph::white);
+  REQUIRE(colors[199] == std::graph::white);
+}
+
+TEST_CASE("breadth_first_search with a shared search_colors workspace", "[dynamic][bfs][search_colors]") {
+  init_console();
+  using G  = routes_vol_graph_type;
+  auto&& g = load_ordered_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv", name_order_policy::source_order_found);
+
+  std::graph::search_colors<> colors;
+  for (vertex_id_t<G> seed = 0; seed < size(vertices(g)); ++seed) {
+    std::vector<vertex_id_t<G>> expected, visited;
+    for (auto&& [vid, v] : vertices_breadth_first_search(g, seed))
+      expected.push_back(vid);
+    for (auto&& [vid, v] : vertices_breadth_first_search(g, seed, colors))
+      visited.push_back(vid);
+    REQUIRE(visited == expected);
+
+    visited.clear();
+    for (auto&& [vid, uv, km] : edges_breadth_first_search(g, seed, [&g](auto&& uv) { return edge_value(g, uv); },
+                                                          colors))
+      visited.push_back(vid);
+    REQUIRE(visited == expected);
+
+    visited.clear();
+    for (auto&& [uid, vid, uv] : sourced_edges_breadth_first_search(g, seed, colors))
+      visited.push_back(vid);
+    REQUIRE(visited == expected);
+  }
+  REQUIRE(colors.size() == size(vertices(g)));
+}
+
+TEST_CASE("breadth_first_search with multiple seeds", "[dynamic][bfs][vertex]") {
+  init_console();
+  using G  = routes_vol_graph_type;
+  auto&& g = load_ordered_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv", name_order_policy::source_order_found);
+
+  auto frankfurt_id = find_frankfurt_id(g);
+
+  // a single seed in a range gives the same result as the seed
+  std::vector<vertex_id_t<G>> expected, visited;
+  for (auto&& [vid, v] : vertices_breadth_first_search(g, frankfurt_id))
+    expected.push_back(vid);
+  std::vector<vertex_id_t<G>> seeds = {frankfurt_id, frankfurt_id};
+  for (auto&& [vid, v] : vertices_breadth_first_search_view<G, void>(g, seeds))
+    visited.push_back(vid);
+  REQUIRE(visited == expected);
+
+  visited.clear();
+  for (auto&& [vid, uv] : edges_breadth_first_search_view<G, void, false>(g, seeds))
+    visited.push_back(vid);
+  REQUIRE(visited == expected);
+}
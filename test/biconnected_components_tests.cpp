@@ -0,0 +1,187 @@
+#include <catch2/catch.hpp>
+#include "undirected_graphs.hpp"
+#include "graph/graph.hpp"
+#include "graph/algorithm/biconnected_components.hpp"
+#include "graph/container/csr_graph.hpp"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iterator>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+
+using std::graph::biconnected_components;
+using std::graph::articulation_points;
+
+using bcc_csr_graph_type = std::graph::container::csr_graph<void, void, void>;
+using bcc_edge_type      = std::graph::copyable_edge_t<uint32_t, void>;
+
+// The components with sorted vertices, in sorted order
+static vector<vector<uint32_t>> sorted_components(vector<vector<uint32_t>> components) {
+  for (auto&& c : components)
+    std::ranges::sort(c);
+  std::ranges::sort(components);
+  return components;
+}
+
+// The number of connected components of g without vertex skip
+static size_t count_components(const bcc_csr_graph_type& g, uint32_t skip) {
+  const uint32_t V = static_cast<uint32_t>(std::ranges::size(vertices(g)));
+  vector<char>   seen(V, 0);
+  size_t         count = 0;
+  for (uint32_t seed = 0; seed < V; ++seed) {
+    if (seed == skip || seen[seed])
+      continue;
+    ++count;
+    vector<uint32_t> stack = {seed};
+    seen[seed]             = 1;
+    while (!stack.empty()) {
+      uint32_t uid = stack.back();
+      stack.pop_back();
+      for (auto&& uv : edges(g, uid))
+        if (target_id(g, uv) != skip && !seen[target_id(g, uv)]) {
+          seen[target_id(g, uv)] = 1;
+          stack.push_back(target_id(g, uv));
+        }
+    }
+  }
+  return count;
+}
+
+TEST_CASE("biconnected_components example", "[biconnected]") {
+  // two triangles joined by the edge 1-3, a bridge 5-6 from the second triangle, an isolated vertex 7 and an
+  // edge 8-9 by itself
+  const vector<bcc_edge_type> edge_list = {{0, 1}, {1, 2}, {2, 0}, {1, 3}, {3, 4}, {4, 5}, {5, 3}, {5, 6}, {8, 9}};
+  auto                        g         = make_undirected_graph<bcc_csr_graph_type>(edge_list, 10);
+
+  vector<vector<uint32_t>> components;
+  biconnected_components(g, components);
+  REQUIRE(sorted_components(components) == vector<vector<uint32_t>>{{0, 1, 2}, {1, 3}, {3, 4, 5}, {5, 6}, {7}, {8, 9}});
+
+  vector<uint32_t> cut;
+  articulation_points(g, std::back_inserter(cut));
+  REQUIRE(cut == vector<uint32_t>{1, 3, 5});
+
+  SECTION("empty graph") {
+    bcc_csr_graph_type empty;
+    components.clear();
+    cut.clear();
+    biconnected_components(empty, components);
+    articulation_points(empty, std::back_inserter(cut));
+    REQUIRE(components.empty());
+    REQUIRE(cut.empty());
+  }
+}
+
+TEST_CASE("biconnected_components random graphs", "[biconnected]") {
+  for (uint32_t edge_count : {40u, 60u, 90u, 150u}) {
+    const uint32_t                          vertex_count = 60;
+    std::mt19937                            rng(edge_count);
+    std::uniform_int_distribution<uint32_t> any(0, vertex_count - 1);
+    vector<bcc_edge_type>                   edge_list;
+    for (uint32_t i = 0; i < edge_count; ++i)
+      edge_list.push_back({any(rng), any(rng)}); // with self-loops & parallel edges
+    auto g = make_undirected_graph<bcc_csr_graph_type>(edge_list, vertex_count);
+
+    // a vertex is an articulation point when removing it adds a component
+    const size_t     base = count_components(g, vertex_count);
+    vector<uint32_t> expected_cut;
+    for (uint32_t uid = 0; uid < vertex_count; ++uid) {
+      const bool isolated = std::ranges::all_of(edges(g, uid), [&](auto&& uv) { return target_id(g, uv) == uid; });
+      if (count_components(g, uid) > base - isolated)
+        expected_cut.push_back(uid);
+    }
+    vector<uint32_t> cut;
+    articulation_points(g, std::back_inserter(cut));
+    REQUIRE(cut == expected_cut);
+
+    vector<vector<uint32_t>> components;
+    biconnected_components(g, components);
+
+    // each vertex is in one component, or more if it's an articulation point
+    vector<size_t> memberships(vertex_count, 0);
+    for (auto&& c : components)
+      for (uint32_t uid : c)
+        ++memberships[uid];
+    for (uint32_t uid = 0; uid < vertex_count; ++uid)
+      REQUIRE((memberships[uid] > 1) == std::ranges::binary_search(expected_cut, uid));
+
+    // each edge between different vertices is in exactly one component
+    for (auto&& [uid, vid] : edge_list) {
+      if (uid == vid)
+        continue;
+      auto in = [&](auto&& c) { return std::ranges::count(c, uid) && std::ranges::count(c, vid); };
+      REQUIRE(std::ranges::count_if(components, in) == 1);
+    }
+
+    // no vertex of a component disconnects the rest of it
+    for (auto&& c : components) {
+      for (uint32_t skip : c) {
+        vector<uint32_t> reached, stack = {c[0] == skip ? c.back() : c[0]};
+        while (!stack.empty()) {
+          uint32_t uid = stack.back();
+          stack.pop_back();
+          if (uid == skip || std::ranges::count(reached, uid) || !std::ranges::count(c, uid))
+            continue;
+          reached.push_back(uid);
+          for (auto&& uv : edges(g, uid))
+            stack.push_back(target_id(g, uv));
+        }
+        REQUIRE(reached.size() == c.size() - 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("biconnected_components deep search", "[biconnected]") {
+  // a path of a million vertices is searched without recursion: every inner vertex is an articulation point
+  // and every edge is a component
+  const uint32_t        vertex_count = 1000000;
+  vector<bcc_edge_type> edge_list;
+  for (uint32_t uid = 0; uid + 1 < vertex_count; ++uid)
+    edge_list.push_back({uid, uid + 1});
+  auto g = make_undirected_graph<bcc_csr_graph_type>(edge_list, vertex_count);
+
+  vector<uint32_t> cut;
+  articulation_points(g, std::back_inserter(cut));
+  REQUIRE(cut.size() == vertex_count - 2);
+  REQUIRE(cut.front() == 1);
+  REQUIRE(cut.back() == vertex_count - 2);
+
+  vector<vector<uint32_t>> components;
+  biconnected_components(g, components);
+  REQUIRE(components.size() == vertex_count - 1);
+  REQUIRE(std::ranges::all_of(components, [](auto&& c) { return c.size() == 2; }));
+
+  // closing the path makes a cycle, which is biconnected
+  edge_list.push_back({vertex_count - 1, 0});
+  auto cycle = make_undirected_graph<bcc_csr_graph_type>(edge_list, vertex_count);
+  cut.clear();
+  articulation_points(cycle, std::back_inserter(cut));
+  REQUIRE(cut.empty());
+  components.clear();
+  biconnected_components(cycle, components);
+  REQUIRE(components.size() == 1);
+  REQUIRE(components[0].size() == vertex_count);
+}
+
+TEST_CASE("biconnected_components karate", "[biconnected][dynamic]") {
+  auto g = load_karate_graph();
+
+  // vertex 0 separates vertex 11, and vertices 4, 5, 6, 10 & 16, from the rest
+  vector<uint32_t> cut;
+  articulation_points(g, std::back_inserter(cut));
+  REQUIRE(cut == vector<uint32_t>{0});
+
+  vector<vector<uint32_t>> components;
+  biconnected_components(g, components);
+  components = sorted_components(components);
+  REQUIRE(components.size() == 3);
+  REQUIRE(components[0].size() == 28);
+  REQUIRE(components[1] == vector<uint32_t>{0, 4, 5, 6, 10, 16});
+  REQUIRE(components[2] == vector<uint32_t>{0, 11});
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch.hpp>
+#include "graph/graph.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/bidirectional_csr_graph.hpp"
+#include "graph/algorithm/page_rank.hpp"
+#include <vector>
+#include <random>
+#include <tuple>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+
+using std::vector;
+using std::tuple;
+
+using std::graph::vertices;
+using std::graph::vertex_id;
+using std::graph::edges;
+using std::graph::in_edges;
+using std::graph::target_id;
+using std::graph::edge_value;
+using std::graph::vertex_value;
+using std::graph::graph_value;
+
+using std::graph::container::csr_graph;
+using std::graph::container::bidirectional_csr_graph;
+
+// The edges of a graph as sorted (source_id, target_id, value) tuples. reverse swaps the ids.
+template <class G>
+static auto edge_tuples(G&& g, bool reverse = false) {
+  vector<tuple<uint32_t, uint32_t, double>> result;
+  for (uint32_t uid = 0; uid < std::ranges::size(vertices(g)); ++uid)
+    for (auto&& uv : edges(g, uid))
+      if (reverse)
+        result.emplace_back(target_id(g, uv), uid, edge_value(g, uv));
+      else
+        result.emplace_back(uid, target_id(g, uv), edge_value(g, uv));
+  std::ranges::sort(result);
+  return result;
+}
+
+static vector<std::graph::copyable_edge_t<uint32_t, double>> random_edges(uint32_t vertex_count, size_t edge_count) {
+  std::mt19937                                          rng(11);
+  std::uniform_int_distribution<uint32_t>               vid_dist(0, vertex_count - 1);
+  vector<std::graph::copyable_edge_t<uint32_t, double>> edge_list;
+  for (size_t i = 0; i < edge_count; ++i)
+    edge_list.push_back({vid_dist(rng), vid_dist(rng), static_cast<double>(i)});
+  return edge_list;
+}
+
+TEST_CASE("csr_graph transpose", "[csr][transpose]") {
+  using G        = csr_graph<double, std::string, std::string>;
+  auto edge_list = random_edges(1000, 20000);
+
+  G g(std::string("graph"));
+  g.load_unsorted_edges(edge_list, std::identity(), 0, 1);
+  vector<std::graph::copyable_vertex_t<uint32_t, std::string>> vertex_values;
+  for (uint32_t uid = 0; uid < 1000; ++uid)
+    vertex_values.push_back({uid, std::to_string(uid)});
+  g.load_vertices(vertex_values, std::identity());
+  auto expected = edge_tuples(g, true);
+
+  for (size_t num_threads : {size_t(1), size_t(4)}) {
+    G gt = g.transpose(num_threads);
+    REQUIRE(std::ranges::size(vertices(gt)) == 1000);
+    REQUIRE(edge_tuples(gt) == expected);
+    REQUIRE(vertex_value(gt, *(std::ranges::begin(vertices(gt)) + 123)) == "123");
+    REQUIRE(graph_value(gt) == "graph");
+    REQUIRE(gt.sorted_rows() == (num_threads == 1));
+    if (num_threads == 1)
+      for (uint32_t uid = 0; uid < 1000; ++uid)
+        REQUIRE(std::ranges::is_sorted(edges(gt, uid), std::less<>(), [&gt](auto&& uv) { return target_id(gt, uv); }));
+
+    // transposing again gives the original edges
+    REQUIRE(edge_tuples(gt.transpose(num_threads), true) == edge_tuples(gt));
+    REQUIRE(edge_tuples(gt.transpose(num_threads)) == edge_tuples(g));
+  }
+
+  SECTION("vertices without incoming edges") {
+    csr_graph<void> h({{0, 1}, {0, 2}, {3, 2}});
+    auto            ht = h.transpose(1);
+    REQUIRE(std::ranges::size(vertices(ht)) == 4);
+    REQUIRE(std::ranges::empty(edges(ht, 0)));
+    REQUIRE(std::ranges::size(edges(ht, 2)) == 2);
+    REQUIRE(target_id(ht, *std::ranges::begin(edges(ht, 2))) == 0);
+    REQUIRE(std::ranges::empty(edges(ht, 3)));
+  }
+  SECTION("empty graph") {
+    csr_graph<void> h;
+    REQUIRE(std::ranges::empty(vertices(h.transpose())));
+  }
+}
+
+TEST_CASE("bidirectional_csr_graph", "[csr][transpose]") {
+  using G = bidirectional_csr_graph<double>;
+  static_assert(std::graph::bidirectional_adjacency_list<G>);
+  static_assert(!std::graph::bidirectional_adjacency_list<csr_graph<double>>);
+  static_assert(!std::is_convertible_v<G&, csr_graph<double>&>); // the edges can't change without the transpose
+
+  auto edge_list = random_edges(500, 5000);
+  G    g;
+  g.load_unsorted_edges(edge_list, std::identity(), 0, 3);
+  REQUIRE(std::ranges::size(vertices(g)) == 500);
+
+  // the incoming edges of each vertex, with their values
+  auto check_in_edges = [](auto&& bg) {
+    auto                                      expected = edge_tuples(bg);
+    vector<tuple<uint32_t, uint32_t, double>> found;
+    for (uint32_t vid = 0; vid < std::ranges::size(vertices(bg)); ++vid)
+      for (auto&& uv : in_edges(bg, vid))
+        found.emplace_back(target_id(bg, uv), vid, edge_value(bg, uv));
+    std::ranges::sort(found);
+    REQUIRE(found == expected);
+
+    size_t count = 0;
+    for (auto&& v : vertices(bg))
+      count += static_cast<size_t>(std::ranges::distance(in_edges(bg, v)));
+    REQUIRE(count == expected.size());
+  };
+  check_in_edges(g);
+  check_in_edges(std::as_const(g));
+
+  // the values of the incoming edges are copies
+  auto&&       vu  = *std::ranges::begin(in_edges(g, 7));
+  const double val = edge_value(g, vu);
+  edge_value(g, vu) += 0.5;
+  REQUIRE(edge_value(g, vu) == val + 0.5);
+  REQUIRE(std::ranges::any_of(edges(g, target_id(g, vu)), [&g, val](auto&& uv) {
+    return target_id(g, uv) == 7 && edge_value(g, uv) == val;
+  }));
+
+  SECTION("dedup_rows and sort_rows") {
+    g.dedup_rows(std::plus<>(), 2);
+    check_in_edges(g);
+    g.sort_rows(2);
+    for (uint32_t vid = 0; vid < 500; ++vid)
+      REQUIRE(std::ranges::is_sorted(in_edges(g, vid), std::less<>(), [&g](auto&& e) { return target_id(g, e); }));
+  }
+  SECTION("from a csr_graph") {
+    csr_graph<double> h;
+    h.load_unsorted_edges(edge_list, std::identity(), 0, 1);
+    G gh(std::move(h), 2);
+    check_in_edges(gh);
+  }
+  SECTION("csr_graph functions") {
+    REQUIRE(edge_tuples(g.out_graph()) == edge_tuples(g));
+    g.index_edges(4);
+    for (auto&& [uid, vid, w] : edge_list)
+      REQUIRE(std::graph::contains_edge(g, uid, vid));
+    REQUIRE(vertex_id(g, std::ranges::begin(vertices(g)) + 42) == 42);
+    REQUIRE(&*g.find_vertex(42) == &g[42]);
+  }
+  SECTION("vertex and graph values") {
+    bidirectional_csr_graph<double, std::string, std::string> h({{0, 1, 1.0}, {1, 2, 2.0}});
+    vector<std::graph::copyable_vertex_t<uint32_t, std::string>> names = {{0, "a"}, {1, "b"}, {2, "c"}};
+    h.load_vertices(names, std::identity());
+    REQUIRE(vertex_value(h, h[1]) == "b");
+    graph_value(h).resize(3, 'h');
+    REQUIRE(graph_value(std::as_const(h)) == "hhh");
+    REQUIRE(target_id(h, *std::ranges::begin(in_edges(h, 2))) == 1);
+  }
+  SECTION("transpose for algorithms") {
+    G              small({{0, 1, 1.0}, {1, 2, 1.0}, {2, 0, 1.0}, {3, 0, 1.0}});
+    vector<double> ranks(4);
+    std::graph::page_rank(small, small.transpose_graph(), ranks, 0.85, 1e-10, 1000, 1);
+    REQUIRE(ranks[0] > ranks[3]);
+    REQUIRE(ranks[3] == Approx(0.15 / 4));
+  }
+}
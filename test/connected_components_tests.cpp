@@ -0,0 +1,153 @@
+#include <catch2/catch.hpp>
+#include "graph/graph.hpp"
+#include "graph/algorithm/connected_components.hpp"
+#include "graph/views/edgelist.hpp"
+#include "graph/io/matrix_market.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include <vector>
+#include <array>
+#include <random>
+#include <numeric>
+#include <list>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+
+using std::graph::connected_components;
+using std::graph::afforest_connected_components;
+
+using cc_csr_graph_type = std::graph::container::csr_graph<void, void, void>;
+using cc_edge_type      = std::graph::copyable_edge_t<uint32_t, void>;
+
+// Sequential flood fill over the edges in both directions; the label is the smallest id of the component
+static vector<uint32_t> reference_components(const vector<cc_edge_type>& edge_list, uint32_t vertex_count) {
+  vector<vector<uint32_t>> adj(vertex_count);
+  for (auto&& [uid, vid] : edge_list) {
+    adj[uid].push_back(vid);
+    adj[vid].push_back(uid);
+  }
+  vector<uint32_t> label(vertex_count, vertex_count);
+  for (uint32_t seed = 0; seed < vertex_count; ++seed) {
+    if (label[seed] != vertex_count)
+      continue;
+    vector<uint32_t> stack = {seed};
+    label[seed]            = seed;
+    while (!stack.empty()) {
+      uint32_t uid = stack.back();
+      stack.pop_back();
+      for (uint32_t vid : adj[uid])
+        if (label[vid] == vertex_count) {
+          label[vid] = seed;
+          stack.push_back(vid);
+        }
+    }
+  }
+  return label;
+}
+
+static size_t count_components(const vector<uint32_t>& label) {
+  size_t n = 0;
+  for (uint32_t uid = 0; uid < label.size(); ++uid)
+    n += (label[uid] == uid);
+  return n;
+}
+
+// A giant component over most of the vertices, plus small components, isolated vertices and self-loops
+static vector<cc_edge_type> component_edges(uint32_t vertex_count, bool symmetric) {
+  std::mt19937                            rng(23);
+  const uint32_t                          giant = vertex_count * 3 / 4;
+  std::uniform_int_distribution<uint32_t> giant_dist(0, giant - 1);
+  vector<cc_edge_type>                    edge_list;
+  for (uint32_t i = 0; i < giant * 3; ++i)
+    edge_list.push_back({giant_dist(rng), giant_dist(rng)});
+  for (uint32_t uid = giant; uid + 3 < vertex_count; uid += 5) // paths of 3 edges, then an isolated vertex
+    for (uint32_t k = 0; k < 3; ++k)
+      edge_list.push_back({uid + k + 1, uid + k}); // larger to smaller id
+  if (symmetric) {
+    const size_t n = edge_list.size();
+    for (size_t i = 0; i < n; ++i)
+      edge_list.push_back({edge_list[i].target_id, edge_list[i].source_id});
+  }
+  std::ranges::shuffle(edge_list, rng);
+  return edge_list;
+}
+
+TEST_CASE("connected_components undirected", "[connected_components]") {
+  for (uint32_t vertex_count : {8u, 20u, 5000u}) {
+    auto             edge_list = component_edges(vertex_count, true);
+    auto             expected  = reference_components(edge_list, vertex_count);
+    cc_csr_graph_type g;
+    g.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1);
+
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      vector<uint32_t> component(vertex_count);
+      REQUIRE(connected_components(g, component, num_threads) == count_components(expected));
+      REQUIRE(component == expected);
+
+      for (size_t rounds : std::array<size_t, 4>{0, 1, 2, 5}) {
+        vector<uint64_t> component64(vertex_count, 99);
+        REQUIRE(afforest_connected_components(g, component64, rounds, num_threads) == count_components(expected));
+        REQUIRE(std::ranges::equal(component64, expected));
+      }
+
+      vector<uint32_t> from_edges(vertex_count);
+      REQUIRE(connected_components(edge_list, from_edges, std::identity(), num_threads) == count_components(expected));
+      REQUIRE(from_edges == expected);
+    }
+  }
+}
+
+TEST_CASE("connected_components directed", "[connected_components]") {
+  // weakly connected components
+  const uint32_t vertex_count = 3000;
+  auto           edge_list    = component_edges(vertex_count, false);
+  auto           expected     = reference_components(edge_list, vertex_count);
+  cc_csr_graph_type g;
+  g.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1);
+
+  vector<int> component(vertex_count);
+  REQUIRE(connected_components(g, component, 3) == count_components(expected));
+  REQUIRE(std::ranges::equal(component, expected));
+
+  // from a forward_range of pairs and a projection, read on one thread
+  std::list<std::pair<int, int>> pairs;
+  for (auto&& [uid, vid] : edge_list)
+    pairs.emplace_back(static_cast<int>(uid), static_cast<int>(vid));
+  auto             proj = [](const std::pair<int, int>& p) { return cc_edge_type{static_cast<uint32_t>(p.first),
+                                                                                 static_cast<uint32_t>(p.second)}; };
+  vector<uint32_t> from_pairs(vertex_count);
+  REQUIRE(connected_components(pairs, from_pairs, proj) == count_components(expected));
+  REQUIRE(from_pairs == expected);
+
+  // from the edges of the graph, read on one thread
+  vector<uint32_t> from_view(vertex_count);
+  REQUIRE(connected_components(std::graph::views::edgelist(g), from_view) == count_components(expected));
+  REQUIRE(from_view == expected);
+}
+
+TEST_CASE("connected_components karate and dynamic_graph", "[connected_components][dynamic]") {
+  using G = std::graph::container::dynamic_adjacency_graph<std::graph::container::vofl_graph_traits<void>>;
+  std::graph::io::mtx_reader<uint32_t> mtx(TEST_DATA_ROOT_DIR "karate.mtx");
+  G                                    g;
+  g.load_edges(mtx, std::identity(), mtx.vertex_count() + 2); // 2 isolated vertices
+
+  vector<uint32_t> component(36);
+  REQUIRE(connected_components(g, component, 2) == 3);
+  REQUIRE(std::ranges::count(component, 0u) == 34);
+  REQUIRE(component[34] == 34);
+  REQUIRE(component[35] == 35);
+
+  REQUIRE(afforest_connected_components(g, component, 2, 2) == 3);
+  REQUIRE(std::ranges::count(component, 0u) == 34);
+
+  SECTION("empty graph") {
+    cc_csr_graph_type empty;
+    vector<uint32_t>  none;
+    REQUIRE(connected_components(empty, none) == 0);
+    REQUIRE(afforest_connected_components(empty, none) == 0);
+  }
+}
@@ -5,6 +5,8 @@
 #include "graph/views/neighbors.hpp"
 #include "graph/container/csr_graph.hpp"
 #include <cassert>
+#include <random>
+#include <algorithm>
 
 #define TEST_OPTION_OUTPUT (1) // output tests for visual inspection
 #define TEST_OPTION_GEN (2)    // generate unit test code to be pasted into this file
@@ -35,6 +37,7 @@ using std::graph::edge_value;
 using std::graph::degree;
 using std::graph::find_vertex;
 using std::graph::find_vertex_edge;
+using std::graph::contains_edge;
 
 
 using routes_csr_graph_type = std::graph::container::csr_graph<double, std::string, std::string>;
@@ -71,6 +74,11 @@ TEST_CASE("CSR void EV test", "[csr][capabilities]") {
   });
 
   graph_value(g) = "Germany Routes";
+
+  REQUIRE(10 == std::ranges::size(vertices(g)));
+  REQUIRE(3 == std::ranges::size(edges(g, 0)));
+  REQUIRE(0 == std::ranges::size(edges(g, 9)));
+  REQUIRE(7 == target_id(g, *(std::ranges::begin(edges(g, 4)) + 1)));
 }
 
 TEST_CASE("CSR void VV test", "[csr][capabilities]") {
@@ -184,6 +192,226 @@ TEST_CASE("CSR graph test", "[csr][capabilities]") {
   }
 };
 
+TEST_CASE("CSR load_unsorted_edges test", "[csr][load]") {
+  using G         = std::graph::container::csr_graph<int, std::string, void>;
+  using edge_type = std::graph::copyable_edge_t<uint32_t, int>;
+
+  // random edges with the value holding the position in the input
+  constexpr uint32_t                      vertex_count = 1000;
+  std::mt19937                            rng(42);
+  std::uniform_int_distribution<uint32_t> any(0, vertex_count - 2); // no edges for the last vertex
+  std::vector<edge_type>                  edge_list;
+  for (int i = 0; i < 20000; ++i)
+    edge_list.push_back({any(rng), any(rng), i});
+
+  std::vector<edge_type> sorted_edges = edge_list;
+  std::ranges::stable_sort(sorted_edges, {}, &edge_type::source_id);
+  G expected;
+  expected.load_edges(sorted_edges, std::identity(), vertex_count);
+
+  auto row_values = [](auto&& g, uint32_t uid) {
+    std::vector<std::pair<uint32_t, int>> row;
+    for (auto&& uv : edges(g, uid))
+      row.emplace_back(target_id(g, uv), edge_value(g, uv));
+    return row;
+  };
+
+  SECTION("single thread keeps the input order") {
+    G g;
+    g.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1);
+    REQUIRE(vertex_count == std::ranges::size(vertices(g)));
+    for (uint32_t uid = 0; uid < vertex_count; ++uid)
+      REQUIRE(row_values(g, uid) == row_values(expected, uid));
+  }
+
+  SECTION("multiple threads") {
+    G g;
+    g.load_unsorted_edges(edge_list, std::identity(), 0, 4);
+    REQUIRE(vertex_count - 1 == std::ranges::size(vertices(g))); // last vertex isn't referenced
+    for (uint32_t uid = 0; uid < vertex_count - 1; ++uid) {
+      auto row = row_values(g, uid);
+      std::ranges::sort(row, {}, &std::pair<uint32_t, int>::second);
+      REQUIRE(row == row_values(expected, uid));
+    }
+  }
+
+  SECTION("vertex values") {
+    G                             g;
+    std::vector<std::string_view> names = {"zero", "one", "two"};
+    g.load_vertices(names, [&names](std::string_view& nm) {
+      auto uid = static_cast<vertex_id_t<G>>(&nm - names.data());
+      return std::graph::copyable_vertex_t<vertex_id_t<G>, std::string>{uid, std::string(nm)};
+    });
+    g.load_unsorted_edges(edge_list, std::identity(), vertex_count, 2);
+    REQUIRE(vertex_count == std::ranges::size(vertices(g)));
+    REQUIRE("two" == vertex_value(g, *find_vertex(g, 2)));
+    REQUIRE(vertex_value(g, *find_vertex(g, vertex_count - 1)).empty());
+  }
+
+  SECTION("void edge value") {
+    using G2 = std::graph::container::csr_graph<void, void, void>;
+    std::vector<std::graph::copyable_edge_t<uint32_t, void>> void_edges = {{3, 1}, {0, 2}, {3, 0}, {0, 1}, {1, 3}};
+    G2 g;
+    g.load_unsorted_edges(void_edges, std::identity(), 0, 1);
+    REQUIRE(4 == std::ranges::size(vertices(g)));
+    REQUIRE(2 == std::ranges::size(edges(g, 0)));
+    REQUIRE(0 == std::ranges::size(edges(g, 2)));
+    REQUIRE(1 == target_id(g, *std::ranges::begin(edges(g, 3))));
+    REQUIRE(0 == target_id(g, *(std::ranges::begin(edges(g, 3)) + 1)));
+  }
+}
+
+TEST_CASE("CSR index_edges test", "[csr][find_edge]") {
+  using G         = std::graph::container::csr_graph<int, void, void>;
+  using edge_type = std::graph::copyable_edge_t<uint32_t, int>;
+
+  // vertex 0 is a hub with many edges, including duplicates; the value is the position in the input
+  constexpr uint32_t                      vertex_count = 2000;
+  std::mt19937                            rng(7);
+  std::uniform_int_distribution<uint32_t> vid_dist(0, vertex_count - 1);
+  std::vector<edge_type>                  edge_list;
+  for (int i = 0; i < 3000; ++i)
+    edge_list.push_back({0, vid_dist(rng), static_cast<int>(edge_list.size())});
+  for (uint32_t uid = 1; uid < vertex_count; ++uid)
+    for (int i = 0; i < 5; ++i)
+      edge_list.push_back({uid, vid_dist(rng), static_cast<int>(edge_list.size())});
+
+  // the first edge uid->vid in the input, or -1
+  auto first_edge = [&edge_list](uint32_t uid, uint32_t vid) {
+    for (auto&& uv : edge_list)
+      if (uv.source_id == uid && uv.target_id == vid)
+        return uv.value;
+    return -1;
+  };
+
+  // find_vertex_edge(g,uid,vid) & contains_edge(g,uid,vid) agree with a scan of the input
+  auto check = [&](const G& g) {
+    for (uint32_t uid : {0u, 1u, 2u, 1000u, vertex_count - 1})
+      for (uint32_t vid = 0; vid < vertex_count; ++vid) {
+        int  expected = first_edge(uid, vid);
+        auto uvit     = find_vertex_edge(g, uid, vid);
+        REQUIRE(contains_edge(g, uid, vid) == (expected >= 0));
+        REQUIRE((uvit == std::ranges::end(edges(g, uid))) == (expected < 0));
+        if (expected >= 0) {
+          REQUIRE(target_id(g, *uvit) == vid);
+          REQUIRE(edge_value(g, *uvit) == expected);
+          REQUIRE(uvit == find_vertex_edge(g, *find_vertex(g, uid), vid));
+        }
+      }
+  };
+
+  G g;
+  g.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1); // preserves the input order in a row
+
+  SECTION("linear") { check(g); }
+  SECTION("hashed hubs") {
+    g.index_edges(64);
+    REQUIRE(!g.sorted_rows());
+    check(g);
+    g.clear_edge_index();
+    check(g);
+  }
+  SECTION("sorted rows") {
+    std::ranges::stable_sort(edge_list, [](const edge_type& lhs, const edge_type& rhs) {
+      return std::tie(lhs.source_id, lhs.target_id) < std::tie(rhs.source_id, rhs.target_id);
+    });
+    G g2;
+    g2.load_edges(edge_list, std::identity(), vertex_count);
+    g2.index_edges(); // vertex 0 is hashed, the other rows use binary search
+    REQUIRE(g2.sorted_rows());
+    check(g2);
+    g2.index_edges(std::numeric_limits<size_t>::max()); // only binary search
+    check(g2);
+  }
+  SECTION("empty graph") {
+    G g2;
+    g2.index_edges();
+    REQUIRE(std::ranges::size(vertices(g2)) == 0);
+  }
+}
+
+TEST_CASE("CSR sort_rows and dedup_rows test", "[csr][sort_rows]") {
+  using G         = std::graph::container::csr_graph<int, void, void>;
+  using edge_type = std::graph::copyable_edge_t<uint32_t, int>;
+
+  // random edges with many duplicates; the value is the position in the input
+  constexpr uint32_t                      vertex_count = 3000;
+  std::mt19937                            rng(11);
+  std::uniform_int_distribution<uint32_t> uid_dist(0, vertex_count - 1);
+  std::uniform_int_distribution<uint32_t> vid_dist(0, 20);
+  std::vector<edge_type>                  edge_list;
+  for (int i = 0; i < 30000; ++i)
+    edge_list.push_back({uid_dist(rng), vid_dist(rng), i});
+  for (int i = 0; i < 2000; ++i) // a hub
+    edge_list.push_back({5, uid_dist(rng), 30000 + i});
+
+  // expected edges, in row order
+  std::vector<edge_type> expected = edge_list;
+  std::ranges::stable_sort(expected, [](const edge_type& lhs, const edge_type& rhs) {
+    return std::tie(lhs.source_id, lhs.target_id) < std::tie(rhs.source_id, rhs.target_id);
+  });
+  auto graph_edges = [](const G& g) {
+    std::vector<edge_type> result;
+    for (uint32_t uid = 0; uid < std::ranges::size(vertices(g)); ++uid)
+      for (auto&& uv : edges(g, uid))
+        result.push_back({uid, target_id(g, uv), edge_value(g, uv)});
+    return result;
+  };
+  auto same_edges = [](const std::vector<edge_type>& lhs, const std::vector<edge_type>& rhs) {
+    return std::ranges::equal(lhs, rhs, [](const edge_type& a, const edge_type& b) {
+      return a.source_id == b.source_id && a.target_id == b.target_id && a.value == b.value;
+    });
+  };
+
+  G g;
+  g.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1);
+  g.index_edges(64);
+  REQUIRE(!g.sorted_rows());
+
+  SECTION("sort_rows") {
+    g.sort_rows(3);
+    REQUIRE(g.sorted_rows());
+    REQUIRE(same_edges(graph_edges(g), expected));
+    REQUIRE(edge_value(g, *find_vertex_edge(g, expected[0].source_id, expected[0].target_id)) == expected[0].value);
+  }
+  SECTION("dedup_rows keeps the first") {
+    g.dedup_rows(3);
+    REQUIRE(g.sorted_rows());
+    auto [last, _] = std::ranges::unique(expected, [](const edge_type& a, const edge_type& b) {
+      return a.source_id == b.source_id && a.target_id == b.target_id;
+    });
+    expected.erase(last, expected.end());
+    REQUIRE(same_edges(graph_edges(g), expected));
+    for (auto&& [uid, vid, val] : expected) // the rebuilt index finds the remaining edges
+      REQUIRE(edge_value(g, *find_vertex_edge(g, uid, vid)) == val);
+  }
+  SECTION("dedup_rows with reducer") {
+    g.dedup_rows(std::plus<>(), 3);
+    std::vector<edge_type> sums;
+    for (auto&& uv : expected)
+      if (!sums.empty() && sums.back().source_id == uv.source_id && sums.back().target_id == uv.target_id)
+        sums.back().value += uv.value;
+      else
+        sums.push_back(uv);
+    REQUIRE(same_edges(graph_edges(g), sums));
+    REQUIRE(std::ranges::size(vertices(g)) == vertex_count);
+  }
+  SECTION("void edge value") {
+    using G2 = std::graph::container::csr_graph<void, void, void>;
+    std::vector<std::graph::copyable_edge_t<uint32_t, void>> void_edges = {{1, 3}, {0, 2}, {1, 0}, {0, 2},
+                                                                           {1, 3}, {0, 1}, {1, 3}};
+    G2 g2;
+    g2.load_unsorted_edges(void_edges, std::identity(), 0, 1);
+    g2.dedup_rows(2);
+    REQUIRE(g2.sorted_rows());
+    std::vector<std::pair<uint32_t, uint32_t>> result;
+    for (uint32_t uid = 0; uid < std::ranges::size(vertices(g2)); ++uid)
+      for (auto&& uv : edges(g2, uid))
+        result.emplace_back(uid, target_id(g2, uv));
+    REQUIRE(result == std::vector<std::pair<uint32_t, uint32_t>>{{0, 1}, {0, 2}, {1, 0}, {1, 3}});
+  }
+}
+
 TEST_CASE("Germany routes CSV+csr test", "[csv][csr][germany]") {
   init_console();
 
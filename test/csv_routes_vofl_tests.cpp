@@ -39,6 +39,7 @@ using std::graph::edge_value;
 using std::graph::degree;
 using std::graph::find_vertex;
 using std::graph::find_vertex_edge;
+using std::graph::contains_edge;
 
 
 using routes_volf_graph_traits = std::graph::container::vofl_graph_traits<double, std::string, std::string>;
@@ -142,6 +143,9 @@ TEST_CASE("Dynamic graph vofl test", "[vofl][capabilities]") {
     REQUIRE(4 == vit - std::ranges::begin(vertices(g)));
     auto uvit = find_vertex_edge(g, *vit, 7);
     REQUIRE(edge_value(g, *uvit) == 186.0);
+    REQUIRE(edge_value(g, *find_vertex_edge(g, 4, 7)) == 186.0);
+    REQUIRE(contains_edge(g, 4, 7));
+    REQUIRE(!contains_edge(g, 4, 6));
   }
 
   SECTION("const functions") {
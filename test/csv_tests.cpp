@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+#include "csv_routes.hpp"
+#include "temp_file.hpp"
+#include "graph/graph.hpp"
+#include "graph/io/csv.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <tuple>
+
+using std::vector;
+using std::string;
+using std::string_view;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+using std::graph::vertex_value;
+using std::graph::edge_value;
+
+using std::graph::io::label_table;
+using std::graph::io::csv_format;
+using std::graph::io::read_csv_edges;
+using std::graph::io::load_csv_graph;
+
+using routes_csr_graph_type  = std::graph::container::csr_graph<double, std::string, std::string>;
+using routes_vofl_graph_type = std::graph::container::dynamic_adjacency_graph<
+      std::graph::container::vofl_graph_traits<double, std::string, std::string>>;
+
+// The edges of a graph as sorted [source label, target label, value] tuples
+template <class G>
+static auto labeled_edges(G&& g) {
+  vector<std::tuple<string, string, double>> result;
+  for (uint32_t uid = 0; uid < std::ranges::size(vertices(g)); ++uid)
+    for (auto&& uv : edges(g, uid))
+      result.emplace_back(vertex_value(g, *(std::ranges::begin(vertices(g)) + uid)),
+                          vertex_value(g, *(std::ranges::begin(vertices(g)) + target_id(g, uv))), edge_value(g, uv));
+  std::ranges::sort(result);
+  return result;
+}
+
+TEST_CASE("label_table", "[csv][label_table]") {
+  label_table<uint32_t> labels;
+  REQUIRE(labels.empty());
+  REQUIRE(!labels.find("a"));
+
+  REQUIRE(labels.insert("a") == std::pair<uint32_t, bool>(0, true));
+  REQUIRE(labels.insert("b") == std::pair<uint32_t, bool>(1, true));
+  REQUIRE(labels.insert("a") == std::pair<uint32_t, bool>(0, false));
+  REQUIRE(labels.insert("") == std::pair<uint32_t, bool>(2, true));
+  REQUIRE(labels.size() == 3);
+  REQUIRE(labels[1] == "b");
+  REQUIRE(labels[2].empty());
+  REQUIRE(labels.contains(""));
+  REQUIRE(!labels.contains("A")); // case sensitive
+
+  // labels remain valid as the table and arena grow, and are independent of the inserted string
+  string_view first = labels[0];
+  string      long_label(100000, 'x');
+  for (uint32_t i = 0; i < 10000; ++i) {
+    string lbl = "label" + std::to_string(i);
+    REQUIRE(labels.insert(lbl).first == i + 3);
+  }
+  REQUIRE(labels.insert(long_label).first == 10003);
+  long_label[0] = 'y';
+  REQUIRE(labels[10003] == string(100000, 'x'));
+  REQUIRE(first.data() == labels[0].data());
+  REQUIRE(labels.size() == 10004);
+  for (uint32_t i = 0; i < 10000; ++i)
+    REQUIRE(*labels.find("label" + std::to_string(i)) == i + 3);
+  REQUIRE(std::ranges::equal(std::ranges::subrange(labels.begin(), labels.begin() + 2), vector<string_view>{"a", "b"}));
+}
+
+TEST_CASE("read_csv_edges germany routes", "[csv]") {
+  auto routes = read_csv_edges<uint32_t, double>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+  REQUIRE(routes.vertex_count() == 10);
+  REQUIRE(routes.edges.size() == 11);
+
+  // ids are assigned in the order the labels are found (the byte order mark isn't part of the header)
+  REQUIRE(routes.labels[0] == "Frankf\xC3\xBCrt");
+  REQUIRE(routes.labels[1] == "Mannheim");
+  REQUIRE(routes.labels[2] == "W\xC3\xBCrzburg");
+  REQUIRE(*routes.labels.find("Kassel") == 3);
+  REQUIRE(routes.edges[0].source_id == 0);
+  REQUIRE(routes.edges[0].target_id == 1);
+  REQUIRE(routes.edges[0].value == 85.0);
+
+  auto routes_void = read_csv_edges<uint32_t, void>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+  REQUIRE(routes_void.edges.size() == 11);
+  REQUIRE(routes_void.edges[1].target_id == 2);
+}
+
+TEST_CASE("load_csv_graph matches load_ordered_graph", "[csv][csr][dynamic]") {
+  auto expected_graph = load_ordered_graph<routes_csr_graph_type>(TEST_DATA_ROOT_DIR "germany_routes.csv",
+                                                                  name_order_policy::order_found);
+  auto expected       = labeled_edges(expected_graph);
+  REQUIRE(expected.size() == 11);
+
+  SECTION("csr_graph") {
+    auto g = load_csv_graph<routes_csr_graph_type>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+    REQUIRE(std::ranges::size(vertices(g)) == 10);
+    for (uint32_t uid = 0; uid < 10; ++uid) // same ids as order_found
+      REQUIRE(vertex_value(g, *(std::ranges::begin(vertices(g)) + uid)) ==
+              vertex_value(expected_graph, *(std::ranges::begin(vertices(expected_graph)) + uid)));
+    REQUIRE(labeled_edges(g) == expected);
+  }
+  SECTION("dynamic_graph") {
+    auto g = load_csv_graph<routes_vofl_graph_type>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+    REQUIRE(std::ranges::size(vertices(g)) == 10);
+    REQUIRE(labeled_edges(g) == expected);
+  }
+  SECTION("without vertex values") {
+    auto g = load_csv_graph<std::graph::container::csr_graph<double>>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+    REQUIRE(std::ranges::size(vertices(g)) == 10);
+    REQUIRE(std::ranges::size(edges(g, 0)) == 3);
+  }
+}
+
+TEST_CASE("read_csv_edges format", "[csv]") {
+  temp_file file("graph_v2_csv_format.csv", "1 ;\"a;b\";x;\"say \"\"hi\"\"\"\r\n"
+                                                "\r\n"
+                                                "-2;c;y;\"a;b\"\r\n"
+                                                " 7;c;z;c"); // no line end
+  csv_format format{.source_column = 1, .target_column = 3, .value_column = 0, .delimiter = ';', .header = false};
+  auto       csv = read_csv_edges<uint32_t, int>(file.path, format);
+  REQUIRE(csv.vertex_count() == 3);
+  REQUIRE(csv.labels[0] == "a;b");
+  REQUIRE(csv.labels[1] == "say \"hi\"");
+  REQUIRE(csv.labels[2] == "c");
+
+  vector<std::tuple<uint32_t, uint32_t, int>> edge_list;
+  for (auto&& [uid, vid, val] : csv.edges)
+    edge_list.emplace_back(uid, vid, val);
+  REQUIRE(edge_list == vector<std::tuple<uint32_t, uint32_t, int>>{{0, 1, 1}, {2, 0, -2}, {2, 2, 7}});
+}
+
+TEST_CASE("read_csv_edges header after blank lines", "[csv]") {
+  temp_file file("graph_v2_csv_blank_header.csv", "\r\n\nfrom,to,value\na,b,1.5\n");
+  auto      csv = read_csv_edges<uint32_t, double>(file.path);
+  REQUIRE(csv.vertex_count() == 2);
+  REQUIRE(csv.edges.size() == 1);
+  REQUIRE(csv.edges[0].value == 1.5);
+}
+
+TEST_CASE("read_csv_edges errors", "[csv]") {
+  SECTION("missing file") {
+    REQUIRE_THROWS_AS((read_csv_edges<uint32_t, double>("graph_v2_no_such_file.csv")), std::runtime_error);
+  }
+  SECTION("missing field") {
+    temp_file file("graph_v2_csv_missing.csv", "from,to,value\na,b,1\nc,d\n");
+    REQUIRE_THROWS_AS((read_csv_edges<uint32_t, double>(file.path)), std::runtime_error);
+    REQUIRE_NOTHROW((read_csv_edges<uint32_t, void>(file.path)));
+  }
+  SECTION("invalid value") {
+    temp_file file("graph_v2_csv_value.csv", "from,to,value\na,b,far\n");
+    REQUIRE_THROWS_AS((read_csv_edges<uint32_t, double>(file.path)), std::runtime_error);
+  }
+  SECTION("trailing text after value") {
+    temp_file file("graph_v2_csv_value_suffix.csv", "from,to,value\na,b,3.5x\n");
+    REQUIRE_THROWS_AS((read_csv_edges<uint32_t, double>(file.path)), std::runtime_error);
+  }
+  SECTION("fractional value for an integral type") {
+    temp_file file("graph_v2_csv_value_int.csv", "from,to,value\na,b,3.5\n");
+    REQUIRE_THROWS_AS((read_csv_edges<uint32_t, int>(file.path)), std::runtime_error);
+    REQUIRE(read_csv_edges<uint32_t, double>(file.path).edges[0].value == 3.5);
+  }
+  SECTION("unterminated quote") {
+    temp_file file("graph_v2_csv_quote.csv", "from,to,value\n\"a,b,1\n");
+    REQUIRE_THROWS_AS((read_csv_edges<uint32_t, double>(file.path)), std::runtime_error);
+  }
+}
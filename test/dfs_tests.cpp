@@ -1134,3 +1134,31 @@ void shortest_paths_example() {
 #endif ///
 
 TEST_CASE("shortest paths demo", "[dynamic][shortest_paths][vertex]") {}
+
+TEST_CASE("depth_first_search with a shared search_colors workspace", "[dynamic][dfs][search_colors]") {
+  init_console();
+  using G  = routes_vol_graph_type;
+  auto&& g = load_ordered_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv", name_order_policy::source_order_found);
+
+  std::graph::search_colors<> colors;
+  for (vertex_id_t<G> seed = 0; seed < size(vertices(g)); ++seed) {
+    std::vector<vertex_id_t<G>> expected, visited;
+    for (auto&& [vid, v] : vertices_depth_first_search(g, seed))
+      expected.push_back(vid);
+    for (auto&& [vid, v] : vertices_depth_first_search(g, seed, colors))
+      visited.push_back(vid);
+    REQUIRE(visited == expected);
+
+    visited.clear();
+    for (auto&& [vid, uv, km] : edges_depth_first_search(g, seed, [&g](auto&& uv) { return edge_value(g, uv); },
+                                                        colors))
+      visited.push_back(vid);
+    REQUIRE(visited == expected);
+
+    visited.clear();
+    for (auto&& [uid, vid, uv] : sourced_edges_depth_first_search(g, seed, colors))
+      visited.push_back(vid);
+    REQUIRE(visited == expected);
+  }
+  REQUIRE(colors.size() == size(vertices(g)));
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+#include "graph/container/indexed_dary_heap.hpp"
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <functional>
+
+using std::vector;
+using std::graph::container::indexed_dary_heap;
+
+struct test_weighted_id {
+  uint32_t vertex_id = 0;
+  double   weight    = 0.0;
+};
+
+TEST_CASE("indexed_dary_heap push/pop order", "[heap][indexed_dary_heap]") {
+  indexed_dary_heap<test_weighted_id> q;
+  REQUIRE(q.empty());
+  REQUIRE(q.size() == 0);
+
+  std::mt19937   rng(42);
+  vector<double> weights(100);
+  for (auto& w : weights)
+    w = std::uniform_real_distribution<double>(0.0, 1000.0)(rng);
+  for (uint32_t uid = 0; uid < weights.size(); ++uid)
+    q.push({uid, weights[uid]});
+  REQUIRE(q.size() == weights.size());
+
+  vector<double> popped;
+  while (!q.empty()) {
+    REQUIRE(q.contains(q.top().vertex_id));
+    popped.push_back(q.top().weight);
+    uint32_t uid = q.top().vertex_id;
+    q.pop();
+    REQUIRE(!q.contains(uid));
+  }
+  std::ranges::sort(weights);
+  REQUIRE(popped == weights);
+}
+
+TEST_CASE("indexed_dary_heap decrease-key", "[heap][indexed_dary_heap]") {
+  indexed_dary_heap<test_weighted_id, 2> q(10);
+  for (uint32_t uid = 0; uid < 10; ++uid)
+    q.push({uid, 100.0 + uid});
+
+  SECTION("push of a queued vertex updates its weight in place") {
+    q.push({7, 1.0});
+    REQUIRE(q.size() == 10);
+    REQUIRE(q.top().vertex_id == 7);
+    REQUIRE(q.top().weight == 1.0);
+  }
+  SECTION("decrease") {
+    q.decrease({9, 50.0});
+    q.decrease({3, 60.0});
+    REQUIRE(q.size() == 10);
+    REQUIRE(q.top().vertex_id == 9);
+    q.pop();
+    REQUIRE(q.top().vertex_id == 3);
+  }
+  SECTION("push of a queued vertex with a larger weight moves it down") {
+    q.push({0, 200.0});
+    REQUIRE(q.size() == 10);
+    REQUIRE(q.top().vertex_id == 1);
+    uint32_t last = 0;
+    while (!q.empty()) {
+      last = q.top().vertex_id;
+      q.pop();
+    }
+    REQUIRE(last == 0);
+  }
+  SECTION("clear") {
+    q.clear();
+    REQUIRE(q.empty());
+    for (uint32_t uid = 0; uid < 10; ++uid)
+      REQUIRE(!q.contains(uid));
+    q.push({4, 4.0});
+    REQUIRE(q.size() == 1);
+    REQUIRE(q.top().vertex_id == 4);
+  }
+}
+
+TEST_CASE("indexed_dary_heap max-heap and lazy growth", "[heap][indexed_dary_heap]") {
+  indexed_dary_heap<test_weighted_id, 3, std::greater<>> q; // no reserve; position index grows on push
+  q.push({1000, 1.0});
+  q.push({5, 3.0});
+  q.push({42, 2.0});
+  REQUIRE(q.contains(1000));
+  REQUIRE(!q.contains(999));
+  REQUIRE(!q.contains(5000));
+  REQUIRE(q.top().vertex_id == 5);
+  q.pop();
+  REQUIRE(q.top().vertex_id == 42);
+  q.pop();
+  REQUIRE(q.top().vertex_id == 1000);
+  q.pop();
+  REQUIRE(q.empty());
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+#include "undirected_graphs.hpp"
+#include "graph/graph.hpp"
+#include "graph/algorithm/label_propagation.hpp"
+#include "graph/container/csr_graph.hpp"
+#include <vector>
+#include <set>
+#include <random>
+#include <algorithm>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edge_value;
+
+using std::graph::label_propagation;
+using std::graph::label_propagation_sweep;
+
+using lp_csr_graph_type = std::graph::container::csr_graph<int, void, void>;
+using lp_edge_type      = std::graph::copyable_edge_t<uint32_t, int>;
+
+// Is each group [first, first + group_size) one community, labelled by one of its vertices, with a
+// different label from the other groups?
+static bool found_groups(const vector<uint32_t>& labels, uint32_t group_size) {
+  std::set<uint32_t> seen;
+  for (uint32_t first = 0; first < labels.size(); first += group_size) {
+    const uint32_t label = labels[first];
+    if (label < first || label >= first + group_size || !seen.insert(label).second)
+      return false;
+    for (uint32_t uid = first; uid < first + group_size; ++uid)
+      if (labels[uid] != label)
+        return false;
+  }
+  return true;
+}
+
+TEST_CASE("label_propagation cliques", "[label_propagation]") {
+  // two 5-cliques joined by the edge 4-5, and an isolated vertex 10
+  vector<lp_edge_type> edge_list = {{4, 5, 1}};
+  for (uint32_t first : {0u, 5u})
+    for (uint32_t uid = first; uid < first + 5; ++uid)
+      for (uint32_t vid = uid + 1; vid < first + 5; ++vid)
+        edge_list.push_back({uid, vid, 1});
+  auto g = make_undirected_graph<lp_csr_graph_type>(edge_list, 11);
+
+  for (auto sweep : {label_propagation_sweep::asynchronous, label_propagation_sweep::synchronous}) {
+    vector<uint32_t> labels(11);
+    size_t           iterations = label_propagation(g, labels, 100, 0.0, sweep);
+    REQUIRE(iterations < 100);
+    REQUIRE(labels[10] == 10);
+    labels.pop_back();
+    REQUIRE(found_groups(labels, 5));
+  }
+
+  SECTION("empty graph") {
+    lp_csr_graph_type empty;
+    vector<uint32_t>  labels;
+    REQUIRE(label_propagation(empty, labels) == 1);
+  }
+}
+
+TEST_CASE("label_propagation weighted votes", "[label_propagation]") {
+  // two 5-cliques with heavy edges, and a light edge from each vertex to each vertex of the other clique
+  vector<lp_edge_type> edge_list;
+  for (uint32_t uid = 0; uid < 10; ++uid)
+    for (uint32_t vid = uid + 1; vid < 10; ++vid)
+      edge_list.push_back({uid, vid, (uid < 5) == (vid < 5) ? 10 : 1});
+  auto g = make_undirected_graph<lp_csr_graph_type>(edge_list, 10);
+
+  // one vote per edge: the light edges outnumber the heavy ones
+  vector<uint32_t> labels(10);
+  label_propagation(g, labels, 100, 0.0);
+  REQUIRE(std::ranges::count(labels, labels[0]) == 10);
+
+  for (auto sweep : {label_propagation_sweep::asynchronous, label_propagation_sweep::synchronous}) {
+    label_propagation(g, labels, [&g](auto&& uv) { return edge_value(g, uv); }, 100, 0.0, sweep);
+    REQUIRE(found_groups(labels, 5));
+  }
+
+  SECTION("weight returned by reference") {
+    for (auto sweep : {label_propagation_sweep::asynchronous, label_propagation_sweep::synchronous}) {
+      label_propagation(g, labels, [&g](auto&& uv) -> const int& { return edge_value(g, uv); }, 100, 0.0, sweep);
+      REQUIRE(found_groups(labels, 5));
+    }
+  }
+}
+
+TEST_CASE("label_propagation planted communities", "[label_propagation]") {
+  // 16 groups of 500 vertices, each with about 20 edges inside its group for every edge to another group
+  const uint32_t                          groups = 16, group_size = 500, vertex_count = groups * group_size;
+  std::mt19937                            rng(42);
+  std::uniform_int_distribution<uint32_t> member(0, group_size - 1), any(0, vertex_count - 1);
+  vector<lp_edge_type>                    edge_list;
+  for (uint32_t uid = 0; uid < vertex_count; ++uid) {
+    const uint32_t first = uid - uid % group_size;
+    for (int i = 0; i < 10; ++i)
+      edge_list.push_back({uid, first + member(rng), 1});
+    if (uid % 2 == 0)
+      edge_list.push_back({uid, any(rng), 1});
+  }
+  auto g = make_undirected_graph<lp_csr_graph_type>(edge_list, vertex_count);
+
+  for (auto sweep : {label_propagation_sweep::asynchronous, label_propagation_sweep::synchronous}) {
+    vector<uint32_t> expected;
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      vector<uint32_t> labels(vertex_count);
+      size_t           iterations = label_propagation(g, labels, 100, 0.0, sweep, num_threads);
+      REQUIRE(iterations < 100);
+      REQUIRE(found_groups(labels, group_size));
+
+      // a synchronous sweep doesn't depend on the number of threads
+      if (sweep == label_propagation_sweep::synchronous) {
+        if (expected.empty())
+          expected = labels;
+        REQUIRE(labels == expected);
+      }
+    }
+  }
+
+  SECTION("tolerance") {
+    // stopping once at most a quarter of the labels change takes fewer sweeps
+    vector<uint32_t> labels(vertex_count);
+    const size_t     all = label_propagation(g, labels, 100, 0.0);
+    REQUIRE(label_propagation(g, labels, 100, 0.25) < all);
+    REQUIRE(label_propagation(g, labels, 1, 0.0) == 1);
+  }
+}
+
+TEST_CASE("label_propagation karate", "[label_propagation][dynamic]") {
+  auto g = load_karate_graph();
+
+  // a few communities of the 34 members
+  vector<uint32_t> labels(std::ranges::size(vertices(g)));
+  label_propagation(g, labels, 100, 0.0, label_propagation_sweep::synchronous);
+  std::set<uint32_t> communities(labels.begin(), labels.end());
+  REQUIRE(communities.size() >= 1);
+  REQUIRE(communities.size() < 10);
+}
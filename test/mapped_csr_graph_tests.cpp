@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+#include "temp_file.hpp"
+#include "graph/graph.hpp"
+#include "graph/views/vertexlist.hpp"
+#include "graph/views/incidence.hpp"
+#include "graph/views/breadth_first_search.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/mapped_csr_graph.hpp"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+using std::vector;
+
+using std::graph::vertex_id_t;
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+using std::graph::target;
+using std::graph::vertex_id;
+using std::graph::vertex_value;
+using std::graph::edge_value;
+using std::graph::find_vertex;
+
+using std::graph::container::csr_graph;
+using std::graph::container::mapped_csr_graph;
+
+TEST_CASE("mapped_csr_graph with edge and vertex values", "[csr][mapped_csr]") {
+  using G  = csr_graph<double, int, void>;
+  using MG = mapped_csr_graph<double, int>;
+
+  // same as the germany routes using source_order_found
+  G g = {{0, 1, 85.0},  {0, 4, 217.0}, {0, 6, 173.0}, {1, 2, 80.0},  {2, 3, 250.0}, {3, 8, 84.0},
+         {4, 5, 103.0}, {4, 7, 186.0}, {5, 8, 167.0}, {5, 9, 183.0}, {6, 8, 502.0}};
+  vector<int> populations = {753056, 309370, 308436, 296582, 127880, 518365, 201048, 213692, 1484226};
+  g.load_vertices(populations, [&populations](int& pop) {
+    return std::graph::copyable_vertex_t<uint32_t, int>{static_cast<uint32_t>(&pop - populations.data()), pop};
+  });
+
+  temp_file file("graph_v2_mapped_csr_test.bin");
+  g.save(file.path);
+  MG mg(file.path);
+
+  REQUIRE(mg.vertex_count() == 10);
+  REQUIRE(mg.edge_count() == 11);
+  REQUIRE(std::ranges::size(vertices(mg)) == std::ranges::size(vertices(g)));
+  for (auto&& [uid, u] : std::graph::views::vertexlist(mg)) {
+    REQUIRE(vertex_id(mg, find_vertex(mg, uid)) == uid);
+    // the last vertex value wasn't loaded and is value-initialized
+    REQUIRE(vertex_value(mg, u) == (uid < populations.size() ? populations[uid] : 0));
+    REQUIRE(std::ranges::size(edges(mg, u)) == std::ranges::size(edges(g, uid)));
+
+    auto uvi = std::ranges::begin(edges(g, uid));
+    for (auto&& [vid, uv] : std::graph::views::incidence(mg, uid)) {
+      REQUIRE(vid == target_id(g, *uvi));
+      REQUIRE(edge_value(mg, uv) == edge_value(g, *uvi));
+      REQUIRE(vertex_id(mg, &target(mg, uv)) == vid);
+      ++uvi;
+    }
+  }
+
+  // searches work on the mapped graph
+  vector<uint32_t> visited;
+  for (auto&& [vid, v] : std::graph::views::vertices_breadth_first_search(mg, 0))
+    visited.push_back(vid);
+  REQUIRE(visited == vector<uint32_t>{1, 4, 6, 2, 5, 7, 8, 3, 9});
+
+  // the graph can be moved
+  MG mg2 = std::move(mg);
+  REQUIRE(mg2.edge_count() == 11);
+  REQUIRE(edge_value(mg2, *std::ranges::begin(edges(mg2, 4))) == 103.0);
+}
+
+TEST_CASE("mapped_csr_graph without values", "[csr][mapped_csr]") {
+  using G  = csr_graph<void, void, void>;
+  using MG = mapped_csr_graph<void, void>;
+  temp_file file("graph_v2_mapped_csr_void_test.bin");
+
+  SECTION("edges") {
+    G g = {{0, 2}, {0, 3}, {2, 1}, {3, 0}};
+    g.save(file.path);
+    MG mg(file.path);
+    REQUIRE(mg.vertex_count() == 4);
+    REQUIRE(mg.edge_count() == 4);
+    REQUIRE(std::ranges::size(edges(mg, 0)) == 2);
+    REQUIRE(std::ranges::size(edges(mg, 1)) == 0);
+    REQUIRE(target_id(mg, *std::ranges::begin(edges(mg, 2))) == 1);
+    REQUIRE(target_id(mg, *std::ranges::begin(edges(mg, 3))) == 0);
+  }
+  SECTION("empty graph") {
+    G g;
+    g.save(file.path);
+    MG mg(file.path);
+    REQUIRE(std::ranges::size(vertices(mg)) == 0);
+  }
+}
+
+TEST_CASE("mapped_csr_graph rejects invalid files", "[csr][mapped_csr]") {
+  temp_file file("graph_v2_mapped_csr_invalid_test.bin");
+  csr_graph<float, void, void> g = {{0, 1, 1.0f}, {1, 2, 2.0f}, {2, 0, 3.0f}};
+  g.save(file.path);
+
+  REQUIRE_NOTHROW(mapped_csr_graph<float, void>(file.path));
+  REQUIRE_THROWS_AS((mapped_csr_graph<double, void>(file.path)), std::runtime_error);
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, int>(file.path)), std::runtime_error);
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, void, uint64_t>(file.path)), std::runtime_error);
+
+  // overwrite a value of a valid file
+  const std::graph::container::csr_file_header header = mapped_csr_graph<float, void>(file.path).header();
+  auto corrupt = [&file](uint64_t offset, auto value) {
+    std::fstream f(file.path, std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(static_cast<std::streamoff>(offset));
+    f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  auto restore = [&g, &file]() { g.save(file.path); };
+
+  corrupt(header.row_index_offset + sizeof(uint32_t), uint32_t{3}); // rows {0,3,2,3}
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, void>(file.path)), std::runtime_error);
+  restore();
+  corrupt(header.col_index_offset, uint32_t{3}); // target id == vertex_count
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, void>(file.path)), std::runtime_error);
+  restore();
+  corrupt(offsetof(std::graph::container::csr_file_header, vertex_count), std::numeric_limits<uint64_t>::max());
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, void>(file.path)), std::runtime_error);
+  restore();
+  REQUIRE_NOTHROW(mapped_csr_graph<float, void>(file.path));
+
+  std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 4);
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, void>(file.path)), std::runtime_error);
+
+  std::ofstream(file.path, std::ios::binary) << "not a graph";
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, void>(file.path)), std::runtime_error);
+
+  std::filesystem::remove(file.path);
+  REQUIRE_THROWS_AS((mapped_csr_graph<float, void>(file.path)), std::runtime_error);
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+#include "temp_file.hpp"
+#include "graph/graph.hpp"
+#include "graph/io/matrix_market.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include <algorithm>
+#include <vector>
+#include <tuple>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+using std::graph::edge_value;
+
+using std::graph::io::mtx_reader;
+using std::graph::io::mtx_field;
+using std::graph::io::mtx_symmetry;
+
+// The edges of a graph as sorted [uid,vid,value] tuples
+template <class G>
+static auto sorted_edges(G&& g) {
+  vector<std::tuple<uint32_t, uint32_t, double>> result;
+  for (uint32_t uid = 0; uid < std::ranges::size(vertices(g)); ++uid)
+    for (auto&& uv : edges(g, uid))
+      result.emplace_back(uid, target_id(g, uv), edge_value(g, uv));
+  std::ranges::sort(result);
+  return result;
+}
+
+TEST_CASE("mtx_reader pattern symmetric", "[mtx]") {
+  mtx_reader<uint32_t> mtx(TEST_DATA_ROOT_DIR "karate.mtx");
+  REQUIRE(mtx.header().field == mtx_field::pattern);
+  REQUIRE(mtx.header().symmetry == mtx_symmetry::symmetric);
+  REQUIRE(mtx.header().entries == 78);
+  REQUIRE(mtx.vertex_count() == 34);
+  REQUIRE(mtx.max_edge_count() == 156);
+
+  vector<std::graph::copyable_edge_t<uint32_t, void>> edge_list;
+  std::ranges::copy(mtx, std::back_inserter(edge_list));
+  REQUIRE(edge_list.size() == 156);
+  REQUIRE(edge_list[0].source_id == 1); // "2 1"
+  REQUIRE(edge_list[0].target_id == 0);
+  REQUIRE(edge_list[1].source_id == 0); // mirror
+  REQUIRE(edge_list[1].target_id == 1);
+
+  // the range can be read more than once
+  REQUIRE(std::ranges::distance(mtx) == 156);
+
+  using G = std::graph::container::csr_graph<void, void, void>;
+  G g;
+  g.load_unsorted_edges(mtx, std::identity(), mtx.vertex_count());
+  REQUIRE(std::ranges::size(vertices(g)) == 34);
+  REQUIRE(std::ranges::size(edges(g, 0)) == 16);
+  REQUIRE(std::ranges::size(edges(g, 33)) == 17);
+}
+
+TEST_CASE("mtx_reader real general", "[mtx]") {
+  mtx_reader<uint32_t, double> mtx(TEST_DATA_ROOT_DIR "bktest1.mtx");
+  REQUIRE(mtx.header().field == mtx_field::real);
+  REQUIRE(mtx.header().symmetry == mtx_symmetry::general);
+  REQUIRE(mtx.vertex_count() == 12);
+
+  using csr_type = std::graph::container::csr_graph<double, void, void>;
+  csr_type csr;
+  csr.load_unsorted_edges(mtx, std::identity(), mtx.vertex_count());
+
+  using vofl_type = std::graph::container::dynamic_adjacency_graph<std::graph::container::vofl_graph_traits<double>>;
+  vofl_type vofl;
+  vofl.load_edges(mtx, std::identity(), mtx.vertex_count());
+
+  auto expected = sorted_edges(csr);
+  REQUIRE(expected.size() == 34);
+  REQUIRE(expected.front() == std::tuple<uint32_t, uint32_t, double>(0, 1, 5.0));
+  REQUIRE(sorted_edges(vofl) == expected);
+}
+
+TEST_CASE("mtx_reader integer values, comments and line endings", "[mtx]") {
+  temp_file file("graph_v2_mtx_test.mtx", "%%MatrixMarket Matrix Coordinate Integer Symmetric\r\n"
+                                              "% comment\r\n"
+                                              "\r\n"
+                                              "4 4 4\r\n"
+                                              "1 1 7\r\n"
+                                              "% comment between entries\r\n"
+                                              "3 1 -2\r\n"
+                                              "  4\t2   9\r\n"
+                                              "4 3 1"); // no line end
+  mtx_reader<uint32_t, int> mtx(file.path);
+  REQUIRE(mtx.header().field == mtx_field::integer);
+  REQUIRE(mtx.header().symmetry == mtx_symmetry::symmetric);
+
+  vector<std::tuple<uint32_t, uint32_t, int>> edge_list;
+  for (auto&& [uid, vid, val] : mtx)
+    edge_list.emplace_back(uid, vid, val);
+  REQUIRE(edge_list == vector<std::tuple<uint32_t, uint32_t, int>>{
+                             {0, 0, 7}, {2, 0, -2}, {0, 2, -2}, {3, 1, 9}, {1, 3, 9}, {3, 2, 1}, {2, 3, 1}});
+}
+
+TEST_CASE("mtx_reader errors", "[mtx]") {
+  SECTION("unsupported format") {
+    temp_file file("graph_v2_mtx_array.mtx", "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+    REQUIRE_THROWS_AS(mtx_reader<uint32_t>(file.path), std::runtime_error);
+  }
+  SECTION("unsupported field") {
+    temp_file file("graph_v2_mtx_complex.mtx", "%%MatrixMarket matrix coordinate complex general\n1 1 0\n");
+    REQUIRE_THROWS_AS(mtx_reader<uint32_t>(file.path), std::runtime_error);
+  }
+  SECTION("not a Matrix Market file") {
+    temp_file file("graph_v2_mtx_invalid.mtx", "1 2 3\n");
+    REQUIRE_THROWS_AS(mtx_reader<uint32_t>(file.path), std::runtime_error);
+  }
+  SECTION("dimensions too large for the vertex id type") {
+    temp_file file("graph_v2_mtx_large.mtx", "%%MatrixMarket matrix coordinate pattern general\n2 300 1\n1 300\n");
+    REQUIRE_THROWS_AS(mtx_reader<uint8_t>(file.path), std::runtime_error);
+    REQUIRE_NOTHROW(mtx_reader<uint16_t>(file.path));
+  }
+  SECTION("entry outside of the matrix") {
+    temp_file file("graph_v2_mtx_range.mtx", "%%MatrixMarket matrix coordinate pattern general\n2 2 2\n1 2\n3 1\n");
+    mtx_reader<uint32_t> mtx(file.path);
+    REQUIRE_THROWS_AS(std::ranges::distance(mtx), std::runtime_error);
+  }
+  SECTION("missing value") {
+    temp_file file("graph_v2_mtx_value.mtx", "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 2\n");
+    mtx_reader<uint32_t, double> mtx(file.path);
+    REQUIRE_THROWS_AS(mtx.begin(), std::runtime_error);
+  }
+}
@@ -0,0 +1,286 @@
+#include <catch2/catch.hpp>
+#include "undirected_graphs.hpp"
+#include "graph/graph.hpp"
+#include "graph/algorithm/mst.hpp"
+#include "graph/views/edgelist.hpp"
+#include "graph/container/csr_graph.hpp"
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <queue>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+using std::graph::edge_value;
+
+using std::graph::kruskal_minimum_spanning_tree;
+using std::graph::prim_minimum_spanning_tree;
+
+using mst_csr_graph_type = std::graph::container::csr_graph<double, void, void>;
+using mst_edge_type      = std::graph::copyable_edge_t<uint32_t, double>;
+
+// Random edges with self-loops, parallel edges and repeated weights
+static vector<mst_edge_type> random_edges(uint32_t vertex_count, size_t edge_count, uint32_t seed) {
+  std::mt19937                            rng(seed);
+  std::uniform_int_distribution<uint32_t> any(0, vertex_count - 1);
+  std::uniform_int_distribution<int>      weight(1, 1000);
+  vector<mst_edge_type>                   edge_list;
+  for (size_t i = 0; i < edge_count; ++i)
+    edge_list.push_back({any(rng), any(rng), static_cast<double>(weight(rng))});
+  return edge_list;
+}
+
+// Kruskal's algorithm without filtering or threads, with ties broken by the vertex ids
+static vector<mst_edge_type> reference_mst(vector<mst_edge_type> edge_list, uint32_t vertex_count) {
+  for (auto& e : edge_list)
+    if (e.source_id > e.target_id)
+      std::swap(e.source_id, e.target_id);
+  std::ranges::sort(edge_list, {}, [](auto& e) { return std::tuple(e.value, e.source_id, e.target_id); });
+
+  vector<uint32_t> parent(vertex_count);
+  std::iota(parent.begin(), parent.end(), 0u);
+  auto find = [&](uint32_t x) {
+    while (parent[x] != x)
+      x = parent[x] = parent[parent[x]];
+    return x;
+  };
+  vector<mst_edge_type> tree;
+  for (auto& e : edge_list) {
+    uint32_t u = find(e.source_id), v = find(e.target_id);
+    if (u != v) {
+      parent[u] = v;
+      tree.push_back(e);
+    }
+  }
+  return tree;
+}
+
+static bool same_edges(const vector<mst_edge_type>& lhs, const vector<mst_edge_type>& rhs) {
+  auto key = [](const mst_edge_type& e) { return std::tuple(e.value, e.source_id, e.target_id); };
+  return std::ranges::equal(lhs, rhs, {}, key, key);
+}
+
+static double total_weight(const vector<mst_edge_type>& tree) {
+  return std::accumulate(tree.begin(), tree.end(), 0.0, [](double sum, auto& e) { return sum + e.value; });
+}
+
+TEST_CASE("kruskal_minimum_spanning_tree example", "[mst][kruskal]") {
+  // a square 0-1-2-3 with the diagonal 0-2, a self-loop on 1, and a separate edge 4-5
+  const vector<mst_edge_type> edge_list = {{0, 1, 1.0}, {1, 2, 2.0}, {2, 3, 1.5}, {3, 0, 4.0},
+                                           {0, 2, 3.0}, {1, 1, 0.5}, {5, 4, 7.0}};
+  auto                        g         = make_undirected_graph<mst_csr_graph_type>(edge_list, 6);
+  auto                        weight    = [&g](auto&& uv) { return edge_value(g, uv); };
+
+  vector<mst_edge_type> tree;
+  double                total = kruskal_minimum_spanning_tree(g, weight, std::back_inserter(tree));
+  REQUIRE(total == 11.5);
+  REQUIRE(same_edges(tree, {{0, 1, 1.0}, {2, 3, 1.5}, {1, 2, 2.0}, {4, 5, 7.0}}));
+
+  SECTION("edge list") {
+    tree.clear();
+    total = kruskal_minimum_spanning_tree(edge_list, [](auto& e) { return e.value; }, std::back_inserter(tree));
+    REQUIRE(total == 11.5);
+    REQUIRE(same_edges(tree, {{0, 1, 1.0}, {2, 3, 1.5}, {1, 2, 2.0}, {4, 5, 7.0}}));
+  }
+
+  SECTION("weight returned by reference") {
+    tree.clear();
+    auto weight_ref = [&g](auto&& uv) -> const double& { return edge_value(g, uv); };
+    REQUIRE(kruskal_minimum_spanning_tree(g, weight_ref, std::back_inserter(tree)) == 11.5);
+    REQUIRE(same_edges(tree, {{0, 1, 1.0}, {2, 3, 1.5}, {1, 2, 2.0}, {4, 5, 7.0}}));
+
+    tree.clear();
+    total = kruskal_minimum_spanning_tree(
+          edge_list, [](auto& e) -> const double& { return e.value; }, std::back_inserter(tree));
+    REQUIRE(total == 11.5);
+    REQUIRE(same_edges(tree, {{0, 1, 1.0}, {2, 3, 1.5}, {1, 2, 2.0}, {4, 5, 7.0}}));
+  }
+
+  SECTION("empty graph") {
+    mst_csr_graph_type    empty;
+    vector<mst_edge_type> no_edges;
+    tree.clear();
+    REQUIRE(kruskal_minimum_spanning_tree(empty, weight, std::back_inserter(tree)) == 0.0);
+    REQUIRE(kruskal_minimum_spanning_tree(no_edges, [](auto& e) { return e.value; }, std::back_inserter(tree)) ==
+            0.0);
+    REQUIRE(tree.empty());
+  }
+}
+
+TEST_CASE("kruskal_minimum_spanning_tree random graphs", "[mst][kruskal]") {
+  // the larger graphs are partitioned by the filter before they're sorted
+  for (auto [vertex_count, edge_count] : {std::pair<uint32_t, size_t>{50, 40},
+                                          {200, 3000},
+                                          {2000, 100000},
+                                          {100000, 150000}}) { // a forest
+    const auto edge_list = random_edges(vertex_count, edge_count, vertex_count);
+    const auto expected  = reference_mst(edge_list, vertex_count);
+    auto       g         = make_undirected_graph<mst_csr_graph_type>(edge_list, vertex_count);
+
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      vector<mst_edge_type> tree;
+      double                total = kruskal_minimum_spanning_tree(
+            g, [&g](auto&& uv) { return edge_value(g, uv); }, std::back_inserter(tree), num_threads);
+      REQUIRE(same_edges(tree, expected));
+      REQUIRE(total == total_weight(expected));
+
+      tree.clear();
+      total = kruskal_minimum_spanning_tree(
+            edge_list, [](auto& e) { return e.value; }, std::back_inserter(tree), std::identity(), num_threads);
+      REQUIRE(same_edges(tree, expected));
+      REQUIRE(total == total_weight(expected));
+    }
+  }
+}
+
+TEST_CASE("kruskal_minimum_spanning_tree edge ranges", "[mst][kruskal]") {
+  const uint32_t vertex_count = 300;
+  const auto     edge_list    = random_edges(vertex_count, 5000, 7);
+  const auto     expected     = reference_mst(edge_list, vertex_count);
+
+  SECTION("list") {
+    std::list<mst_edge_type> edge_set(edge_list.begin(), edge_list.end());
+    vector<mst_edge_type>    tree;
+    kruskal_minimum_spanning_tree(edge_set, [](auto& e) { return e.value; }, std::back_inserter(tree));
+    REQUIRE(same_edges(tree, expected));
+  }
+
+  SECTION("views::edgelist") {
+    // each edge is seen in both directions, which is the same edge
+    auto                  g = make_undirected_graph<mst_csr_graph_type>(edge_list, vertex_count);
+    vector<mst_edge_type> tree;
+    kruskal_minimum_spanning_tree(
+          std::graph::views::edgelist(g), [&g](auto&& e) { return edge_value(g, e.edge); },
+          std::back_inserter(tree));
+    REQUIRE(same_edges(tree, expected));
+  }
+
+  SECTION("projection") {
+    vector<std::tuple<uint32_t, uint32_t, double>> tuples;
+    for (auto&& [uid, vid, w] : edge_list)
+      tuples.emplace_back(uid, vid, w);
+    vector<mst_edge_type> tree;
+    kruskal_minimum_spanning_tree(
+          tuples, [](auto& t) { return std::get<2>(t); }, std::back_inserter(tree),
+          [](auto& t) { return std::graph::copyable_edge_t<uint32_t, void>{std::get<0>(t), std::get<1>(t)}; });
+    REQUIRE(same_edges(tree, expected));
+  }
+}
+
+TEST_CASE("kruskal_minimum_spanning_tree karate", "[mst][kruskal][dynamic]") {
+  auto g = load_karate_graph();
+
+  // the graph is connected, so any spanning tree of unit weights has |V| - 1 edges
+  vector<std::graph::copyable_edge_t<uint32_t, int>> tree;
+  int total = kruskal_minimum_spanning_tree(g, [](auto&&) { return 1; }, std::back_inserter(tree));
+  REQUIRE(total == 33);
+  REQUIRE(tree.size() == 33);
+  REQUIRE(std::ranges::all_of(tree, [](auto& e) { return e.source_id < e.target_id; }));
+}
+
+// Check that predecessor & weight are a spanning forest of g with the edges of the minimum spanning forest
+static void check_prim_forest(const mst_csr_graph_type&    g,
+                              const vector<uint32_t>&      predecessor,
+                              const vector<double>&        weight,
+                              const vector<mst_edge_type>& expected) {
+  const uint32_t        V = static_cast<uint32_t>(std::ranges::size(vertices(g)));
+  vector<mst_edge_type> tree;
+  vector<uint32_t>      wrong_weight;
+  for (uint32_t vid = 0; vid < V; ++vid) {
+    const uint32_t uid = predecessor[vid];
+    if (uid == vid) {
+      if (weight[vid] != 0.0)
+        wrong_weight.push_back(vid);
+      continue;
+    }
+    // the lightest edge between uid and vid
+    double w = std::numeric_limits<double>::max();
+    for (auto&& uv : edges(g, uid))
+      if (target_id(g, uv) == vid)
+        w = std::min(w, edge_value(g, uv));
+    if (weight[vid] != w)
+      wrong_weight.push_back(vid);
+    tree.push_back({std::min(uid, vid), std::max(uid, vid), w});
+  }
+  REQUIRE(wrong_weight.empty());
+  // a seed for each tree, and the same total weight as any other minimum spanning forest
+  REQUIRE(tree.size() == expected.size());
+  REQUIRE(total_weight(tree) == total_weight(expected));
+
+  // every vertex reaches its seed
+  bool acyclic = true;
+  for (uint32_t vid = 0; vid < V && acyclic; ++vid) {
+    uint32_t uid = vid, steps = 0;
+    for (; predecessor[uid] != uid && steps < V; ++steps)
+      uid = predecessor[uid];
+    acyclic = steps < V;
+  }
+  REQUIRE(acyclic);
+}
+
+TEST_CASE("prim_minimum_spanning_tree example", "[mst][prim]") {
+  // a square 0-1-2-3 with the diagonal 0-2, a self-loop on 1, a separate edge 4-5 and an isolated vertex 6
+  const vector<mst_edge_type> edge_list = {{0, 1, 1.0}, {1, 2, 2.0}, {2, 3, 1.5}, {3, 0, 4.0},
+                                           {0, 2, 3.0}, {1, 1, 0.5}, {5, 4, 7.0}};
+  auto                        g         = make_undirected_graph<mst_csr_graph_type>(edge_list, 7);
+  auto                        weight_fn = [&g](auto&& uv) { return edge_value(g, uv); };
+
+  vector<uint32_t> predecessor(7);
+  vector<double>   weight(7);
+  prim_minimum_spanning_tree(g, predecessor, weight, weight_fn);
+  REQUIRE(predecessor == vector<uint32_t>{0, 0, 1, 2, 4, 4, 6});
+  REQUIRE(weight == vector<double>{0.0, 1.0, 2.0, 1.5, 0.0, 7.0, 0.0});
+
+  SECTION("unit weights") {
+    vector<int> hops(7);
+    prim_minimum_spanning_tree(g, predecessor, hops);
+    REQUIRE(predecessor == vector<uint32_t>{0, 0, 0, 0, 4, 4, 6});
+    REQUIRE(hops == vector<int>{0, 1, 1, 1, 0, 1, 0});
+  }
+}
+
+TEST_CASE("prim_minimum_spanning_tree random graphs", "[mst][prim]") {
+  using weighted_vertex_type = std::graph::weighted_vertex<mst_csr_graph_type, double>;
+  using pq_type              = std::priority_queue<weighted_vertex_type, vector<weighted_vertex_type>,
+                                      std::greater<weighted_vertex_type>>;
+
+  for (auto [vertex_count, edge_count] : {std::pair<uint32_t, size_t>{50, 40},
+                                          {200, 3000},
+                                          {2000, 100000},
+                                          {20000, 15000}}) { // a forest
+    const auto edge_list = random_edges(vertex_count, edge_count, vertex_count);
+    const auto expected  = reference_mst(edge_list, vertex_count);
+    auto       g         = make_undirected_graph<mst_csr_graph_type>(edge_list, vertex_count);
+    auto       weight_fn = [&g](auto&& uv) { return edge_value(g, uv); };
+
+    vector<uint32_t> predecessor(vertex_count);
+    vector<double>   weight(vertex_count);
+    prim_minimum_spanning_tree(g, predecessor, weight, weight_fn); // default: indexed_dary_heap
+    check_prim_forest(g, predecessor, weight, expected);
+
+    vector<uint32_t> pq_predecessor(vertex_count);
+    vector<double>   pq_weight(vertex_count);
+    prim_minimum_spanning_tree(g, pq_predecessor, pq_weight, weight_fn, pq_type());
+    check_prim_forest(g, pq_predecessor, pq_weight, expected); // ties may give a different forest
+  }
+}
+
+TEST_CASE("prim_minimum_spanning_tree karate", "[mst][prim][dynamic]") {
+  auto           g            = load_karate_graph();
+  const uint32_t vertex_count = static_cast<uint32_t>(std::ranges::size(vertices(g)));
+
+  // the graph is connected, so vertex 0 is the only seed
+  vector<uint32_t> predecessor(vertex_count);
+  vector<int>      weight(vertex_count);
+  prim_minimum_spanning_tree(g, predecessor, weight);
+  REQUIRE(predecessor[0] == 0);
+  REQUIRE(std::ranges::count_if(std::views::iota(0u, vertex_count),
+                                [&](uint32_t uid) { return predecessor[uid] == uid; }) == 1);
+  REQUIRE(std::accumulate(weight.begin(), weight.end(), 0) == 33);
+}
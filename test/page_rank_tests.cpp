@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+#include "graph/graph.hpp"
+#include "graph/algorithm/page_rank.hpp"
+#include "graph/io/matrix_market.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include <vector>
+#include <random>
+#include <numeric>
+#include <cmath>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+
+using std::graph::page_rank;
+
+using pr_csr_graph_type = std::graph::container::csr_graph<void, void, void>;
+using pr_edge_type      = std::graph::copyable_edge_t<uint32_t, void>;
+
+// The graph for edge_list and its transpose
+static std::pair<pr_csr_graph_type, pr_csr_graph_type> make_graph_and_transpose(const vector<pr_edge_type>& edge_list,
+                                                                                uint32_t vertex_count) {
+  vector<pr_edge_type> reversed;
+  for (auto&& [uid, vid] : edge_list)
+    reversed.push_back({vid, uid});
+  std::pair<pr_csr_graph_type, pr_csr_graph_type> result;
+  result.first.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1);
+  result.second.load_unsorted_edges(reversed, std::identity(), vertex_count, 1);
+  return result;
+}
+
+// Sequential power iteration pushing the ranks along the outgoing edges, run to convergence
+template <class G>
+static vector<double> reference_page_rank(G&& g, double damping) {
+  const size_t   V = std::ranges::size(vertices(g));
+  vector<double> rank(V, 1.0 / static_cast<double>(V)), next(V);
+  for (int iteration = 0; iteration < 1000; ++iteration) {
+    double dangling = 0;
+    for (uint32_t uid = 0; uid < V; ++uid)
+      if (std::ranges::empty(edges(g, uid)))
+        dangling += rank[uid];
+    std::ranges::fill(next, (1.0 - damping + damping * dangling) / static_cast<double>(V));
+    for (uint32_t uid = 0; uid < V; ++uid) {
+      const auto degree = static_cast<double>(std::ranges::distance(edges(g, uid)));
+      for (auto&& uv : edges(g, uid))
+        next[target_id(g, uv)] += damping * rank[uid] / degree;
+    }
+    rank.swap(next);
+  }
+  return rank;
+}
+
+TEST_CASE("page_rank directed", "[page_rank]") {
+  // 3 is dangling, 4 has no incoming edges
+  vector<pr_edge_type> edge_list = {{0, 1}, {0, 2}, {1, 2}, {2, 0}, {2, 3}, {4, 2}, {4, 0}};
+  auto [g, gt]                   = make_graph_and_transpose(edge_list, 5);
+  auto expected                  = reference_page_rank(g, 0.85);
+
+  for (size_t num_threads : {size_t(1), size_t(3)}) {
+    vector<double> ranks(5);
+    size_t         iterations = page_rank(g, gt, ranks, 0.85, 1e-12, 1000, num_threads);
+    REQUIRE(iterations < 1000);
+    REQUIRE(std::accumulate(ranks.begin(), ranks.end(), 0.0) == Approx(1.0));
+    for (size_t uid = 0; uid < 5; ++uid)
+      REQUIRE(ranks[uid] == Approx(expected[uid]).epsilon(1e-9));
+    REQUIRE(ranks[4] == Approx(expected[4]));
+    REQUIRE(ranks[2] > ranks[1]);
+  }
+
+  SECTION("max_iterations") {
+    vector<double> ranks(5);
+    REQUIRE(page_rank(g, gt, ranks, 0.85, 0.0, 3, 1) == 3);
+    REQUIRE(page_rank(g, gt, ranks, 0.85, 1e-12, 0, 1) == 0);
+    REQUIRE(ranks[0] == 0.2); // the initial rank
+  }
+  SECTION("no damping") {
+    vector<double> ranks(5);
+    page_rank(g, gt, ranks, 0.0, 1e-12, 100, 1);
+    for (double rank : ranks)
+      REQUIRE(rank == Approx(0.2));
+  }
+}
+
+TEST_CASE("page_rank random graphs", "[page_rank]") {
+  std::mt19937 rng(7);
+  for (uint32_t vertex_count : {1u, 100u, 5000u}) {
+    std::uniform_int_distribution<uint32_t> vid_dist(0, vertex_count - 1);
+    vector<pr_edge_type>                    edge_list;
+    for (uint32_t i = 0; i < vertex_count * 4; ++i)
+      edge_list.push_back({vid_dist(rng), vid_dist(rng) / 2}); // the upper half has no incoming edges
+    auto [g, gt]  = make_graph_and_transpose(edge_list, vertex_count);
+    auto expected = reference_page_rank(g, 0.85);
+
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      vector<double> ranks(vertex_count);
+      page_rank(g, gt, ranks, 0.85, 1e-10, 1000, num_threads);
+      for (size_t uid = 0; uid < vertex_count; ++uid)
+        REQUIRE(ranks[uid] == Approx(expected[uid]).epsilon(1e-6));
+
+      vector<float> franks(vertex_count);
+      page_rank(g, gt, franks, 0.85, 1e-5, 1000, num_threads);
+      REQUIRE(std::accumulate(franks.begin(), franks.end(), 0.0) == Approx(1.0).epsilon(1e-4));
+      for (size_t uid = 0; uid < vertex_count; ++uid)
+        REQUIRE(franks[uid] == Approx(expected[uid]).epsilon(1e-2));
+    }
+  }
+}
+
+TEST_CASE("page_rank undirected", "[page_rank][dynamic]") {
+  std::graph::io::mtx_reader<uint32_t> mtx(TEST_DATA_ROOT_DIR "karate.mtx");
+  pr_csr_graph_type                    g;
+  g.load_unsorted_edges(mtx, std::identity(), mtx.vertex_count(), 1);
+  auto expected = reference_page_rank(g, 0.85);
+
+  vector<double> ranks(34);
+  page_rank(g, ranks, 0.85, 1e-12, 1000, 2);
+  for (size_t uid = 0; uid < 34; ++uid)
+    REQUIRE(ranks[uid] == Approx(expected[uid]).epsilon(1e-9));
+  REQUIRE(std::ranges::max_element(ranks) - ranks.begin() == 33); // the administrator
+  REQUIRE(ranks[33] == Approx(0.1009).margin(1e-4));
+
+  // the same ranks from a dynamic_graph
+  using G = std::graph::container::dynamic_adjacency_graph<std::graph::container::vofl_graph_traits<void>>;
+  std::graph::io::mtx_reader<uint32_t> mtx2(TEST_DATA_ROOT_DIR "karate.mtx");
+  G                                    dg;
+  dg.load_edges(mtx2, std::identity(), mtx2.vertex_count());
+  vector<double> dranks(34);
+  page_rank(dg, dranks, 0.85, 1e-12, 1000, 1);
+  for (size_t uid = 0; uid < 34; ++uid)
+    REQUIRE(dranks[uid] == Approx(ranks[uid]));
+}
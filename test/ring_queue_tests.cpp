@@ -0,0 +1,56 @@
+#include <catch2/catch.hpp>
+#include "graph/container/ring_queue.hpp"
+#include <queue>
+#include <random>
+
+using std::graph::container::ring_queue;
+
+TEST_CASE("ring_queue FIFO order", "[queue][ring_queue]") {
+  ring_queue<uint32_t> q;
+  REQUIRE(q.empty());
+  REQUIRE(q.size() == 0);
+  REQUIRE(q.capacity() == 0);
+
+  for (uint32_t i = 0; i < 100; ++i) {
+    q.push(i);
+    REQUIRE(q.front() == 0);
+    REQUIRE(q.back() == i);
+  }
+  REQUIRE(q.size() == 100);
+  REQUIRE(q.capacity() == 128);
+  for (uint32_t i = 0; i < 100; ++i) {
+    REQUIRE(q.front() == i);
+    q.pop();
+  }
+  REQUIRE(q.empty());
+}
+
+TEST_CASE("ring_queue wraps and grows like std::queue", "[queue][ring_queue]") {
+  ring_queue<uint32_t> q(10);
+  std::queue<uint32_t> expected;
+  REQUIRE(q.capacity() == 16);
+
+  std::mt19937 rng(3);
+  uint32_t     next = 0;
+  for (int step = 0; step < 10000; ++step) {
+    // mostly push early on, mostly pop later, so the ring wraps both while full and while growing
+    if (expected.empty() || rng() % 100 < (step < 5000 ? 60u : 40u)) {
+      q.push(next);
+      expected.push(next++);
+    } else {
+      REQUIRE(q.front() == expected.front());
+      q.pop();
+      expected.pop();
+    }
+    REQUIRE(q.size() == expected.size());
+    if (!q.empty()) {
+      REQUIRE(q.front() == expected.front());
+      REQUIRE(q.back() == expected.back());
+    }
+  }
+
+  q.clear();
+  REQUIRE(q.empty());
+  q.emplace(42u);
+  REQUIRE(q.front() == 42);
+}
@@ -3,7 +3,9 @@
 #include "graph/graph.hpp"
 #include "graph/algorithm/shortest_paths.hpp"
 #include "graph/container/dynamic_graph.hpp"
+#include "graph/container/csr_graph.hpp"
 #include <cassert>
+#include <random>
 #ifdef _MSC_VER
 #  include "Windows.h"
 #endif
@@ -73,3 +75,436 @@ TEST_CASE("Dijkstra's Shortest Distances", "[csv][vofl][shortest_distances][dijk
   vector<vertex_id_t<G>> predecessor(size(vertices(g)));
   dijkstra_shortest_distances(g, frankfurt_id, distance);
 }
+
+TEST_CASE("Dijkstra's Shortest Paths with indexed_dary_heap and priority_queue",
+          "[csv][vofl][shortest_paths][dijkstra][indexed_dary_heap]") {
+  init_console();
+  using G             = routes_volf_graph_type;
+  auto&& g            = load_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+  auto   frankfurt_id = find_frankfurt_id(g);
+  auto   weight       = [&g](std::graph::edge_reference_t<G> uv) -> double { return edge_value(g, uv); };
+  using weighted_vertex_type = std::graph::weighted_vertex<G, double>;
+  using pq_type              = std::priority_queue<weighted_vertex_type, vector<weighted_vertex_type>,
+                                      std::greater<weighted_vertex_type>>;
+
+  const double           invalid = std::graph::dijkstra_invalid_distance<G, double>();
+  vector<double>         distance(size(vertices(g)), invalid);
+  vector<vertex_id_t<G>> predecessor(size(vertices(g)));
+  dijkstra_shortest_paths(g, frankfurt_id, distance, predecessor, weight); // default: indexed_dary_heap
+
+  vector<double>         pq_distance(size(vertices(g)), invalid);
+  vector<vertex_id_t<G>> pq_predecessor(size(vertices(g)));
+  dijkstra_shortest_paths(g, frankfurt_id, pq_distance, pq_predecessor, weight, pq_type());
+
+  REQUIRE(distance == pq_distance);
+  REQUIRE(distance[frankfurt_id] == 0.0);
+  REQUIRE(predecessor[frankfurt_id] == frankfurt_id);
+  for (vertex_id_t<G> uid = 0; uid < size(vertices(g)); ++uid) {
+    if (uid == frankfurt_id || distance[uid] == invalid)
+      continue;
+    // the distance must be reached through the predecessor's edge
+    bool found = false;
+    for (auto&& uv : edges(g, predecessor[uid]))
+      if (target_id(g, uv) == uid && distance[predecessor[uid]] + edge_value(g, uv) == distance[uid])
+        found = true;
+    REQUIRE(found);
+  }
+  REQUIRE(distance[find_city_id(g, "M\xC3\xBCnchen")] == 487.0);
+}
+
+// Counts the pushes and pops made by dijkstra_shortest_paths() on the queue it wraps. The counters are
+// shared so they survive the queue being passed by value.
+struct dijkstra_counters {
+  size_t pushes = 0;
+  size_t pops   = 0;
+  size_t scans  = 0; // edges scanned (calls to the weight function)
+};
+
+template <class Q>
+class counting_queue : public Q {
+public:
+  using value_type = typename Q::value_type;
+  using size_type  = typename Q::size_type;
+  using reference  = typename Q::reference;
+
+  counting_queue(dijkstra_counters& counters) : counters_(&counters) {}
+
+  void push(const value_type& value) {
+    ++counters_->pushes;
+    Q::push(value);
+  }
+  void pop() {
+    ++counters_->pops;
+    Q::pop();
+  }
+
+private:
+  dijkstra_counters* counters_ = nullptr;
+};
+
+// A grid of rows x cols vertices with edges in both directions between horizontal and vertical neighbors.
+// Weights are in the range [1,16] and are deterministic.
+static auto make_weighted_grid(uint32_t rows, uint32_t cols) {
+  using G = std::graph::container::csr_graph<double, void, void>;
+  vector<std::graph::copyable_edge_t<uint32_t, double>> edges;
+  edges.reserve(4ull * rows * cols);
+  auto add = [&edges](uint32_t uid, uint32_t vid) {
+    edges.push_back({uid, vid, static_cast<double>(1 + (uid * 2654435761u ^ vid) % 16)});
+  };
+  for (uint32_t r = 0; r < rows; ++r) {
+    for (uint32_t c = 0; c < cols; ++c) {
+      uint32_t uid = r * cols + c;
+      if (r > 0)
+        add(uid, uid - cols);
+      if (c > 0)
+        add(uid, uid - 1);
+      if (c + 1 < cols)
+        add(uid, uid + 1);
+      if (r + 1 < rows)
+        add(uid, uid + cols);
+    }
+  }
+  G g;
+  g.load_edges(edges, std::identity());
+  return g;
+}
+
+static void test_dijkstra_grid_work(uint32_t rows, uint32_t cols) {
+  auto&& g = make_weighted_grid(rows, cols);
+  using G  = std::remove_cvref_t<decltype(g)>;
+  using weighted_vertex_type = std::graph::weighted_vertex<G, double>;
+  using pq_type              = std::priority_queue<weighted_vertex_type, vector<weighted_vertex_type>,
+                                      std::greater<weighted_vertex_type>>;
+  using heap_type            = std::graph::container::indexed_dary_heap<weighted_vertex_type>;
+
+  const size_t V       = size(vertices(g));
+  size_t       E       = 0;
+  for (auto&& u : vertices(g))
+    E += size(edges(g, u));
+  const double invalid = std::graph::dijkstra_invalid_distance<G, double>();
+
+  dijkstra_counters pq_counts;
+  vector<double>    pq_distance(V, invalid);
+  vector<uint32_t>  pq_predecessor(V);
+  auto              pq_weight = [&g, &pq_counts](std::graph::edge_reference_t<G> uv) {
+    ++pq_counts.scans;
+    return edge_value(g, uv);
+  };
+  dijkstra_shortest_paths(g, 0u, pq_distance, pq_predecessor, pq_weight,
+                          counting_queue<pq_type>(pq_counts));
+
+  // Each vertex is settled once, so every edge is scanned once. The queue holds at most one entry
+  // per relaxation, which bounds the work at O((V+E) log V).
+  REQUIRE(pq_counts.pops == pq_counts.pushes);
+  REQUIRE(pq_counts.pushes <= E + 1);
+  REQUIRE(pq_counts.scans == E);
+
+  dijkstra_counters heap_counts;
+  vector<double>    heap_distance(V, invalid);
+  vector<uint32_t>  heap_predecessor(V);
+  auto              heap_weight = [&g, &heap_counts](std::graph::edge_reference_t<G> uv) {
+    ++heap_counts.scans;
+    return edge_value(g, uv);
+  };
+  dijkstra_shortest_paths(g, 0u, heap_distance, heap_predecessor, heap_weight,
+                          counting_queue<heap_type>(heap_counts));
+
+  // decrease-key: each vertex is popped exactly once
+  REQUIRE(heap_counts.pops == V);
+  REQUIRE(heap_counts.scans == E);
+  REQUIRE(heap_distance == pq_distance);
+}
+
+TEST_CASE("Dijkstra's Shortest Paths work on a grid", "[shortest_paths][dijkstra][grid]") {
+  test_dijkstra_grid_work(100, 100);
+}
+
+TEST_CASE("Dijkstra's Shortest Paths work on a 1M vertex grid", "[.][benchmark][shortest_paths][dijkstra][grid]") {
+  test_dijkstra_grid_work(1000, 1000);
+}
+
+// Checks that each reachable vertex other than seed is reached by a shortest path edge from its predecessor
+template <class G, class WF>
+static void check_predecessors(G&&                                        g,
+                               vertex_id_t<G>                             seed,
+                               const vector<double>&                      distance,
+                               const vector<vertex_id_t<G>>&              predecessor,
+                               WF                                         weight) {
+  const double invalid = std::graph::dijkstra_invalid_distance<G, double>();
+  REQUIRE(predecessor[seed] == seed);
+  for (vertex_id_t<G> uid = 0; uid < size(vertices(g)); ++uid) {
+    if (uid == seed || distance[uid] == invalid)
+      continue;
+    bool found = false;
+    for (auto&& uv : edges(g, predecessor[uid]))
+      if (target_id(g, uv) == uid && distance[predecessor[uid]] + weight(uv) == distance[uid])
+        found = true;
+    REQUIRE(found);
+  }
+}
+
+TEST_CASE("Delta-stepping Shortest Paths", "[csv][vofl][shortest_paths][delta_stepping]") {
+  init_console();
+  using G             = routes_volf_graph_type;
+  auto&& g            = load_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+  auto   frankfurt_id = find_frankfurt_id(g);
+  auto   weight       = [&g](std::graph::edge_reference_t<G> uv) -> double { return edge_value(g, uv); };
+
+  const double           invalid = std::graph::dijkstra_invalid_distance<G, double>();
+  vector<double>         expected(size(vertices(g)), invalid);
+  vector<vertex_id_t<G>> predecessor(size(vertices(g)));
+  dijkstra_shortest_paths(g, frankfurt_id, expected, predecessor, weight);
+
+  for (double delta : {1.0, 50.0, 200.0, 10000.0}) {
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      vector<double>         distance(size(vertices(g)), invalid);
+      vector<vertex_id_t<G>> delta_predecessor(size(vertices(g)));
+      std::graph::delta_stepping_shortest_paths(g, frankfurt_id, distance, delta_predecessor, weight, delta,
+                                                num_threads);
+      REQUIRE(distance == expected);
+      check_predecessors(g, frankfurt_id, distance, delta_predecessor, weight);
+    }
+  }
+}
+
+TEST_CASE("Delta-stepping Shortest Paths on a grid", "[shortest_paths][delta_stepping][grid]") {
+  auto&& g = make_weighted_grid(200, 300);
+  using G  = std::remove_cvref_t<decltype(g)>;
+  auto weight = [&g](std::graph::edge_reference_t<G> uv) { return edge_value(g, uv); };
+
+  const size_t     V       = size(vertices(g));
+  const double     invalid = std::graph::dijkstra_invalid_distance<G, double>();
+  const uint32_t   seed    = 12345;
+  vector<double>   expected(V, invalid);
+  vector<uint32_t> predecessor(V);
+  dijkstra_shortest_paths(g, seed, expected, predecessor, weight);
+
+  for (double delta : {1.0, 3.0, 16.0, 64.0}) {
+    vector<double>   distance(V, invalid);
+    vector<uint32_t> delta_predecessor(V);
+    std::graph::delta_stepping_shortest_paths(g, seed, distance, delta_predecessor, weight, delta, 4);
+    REQUIRE(distance == expected);
+    check_predecessors(g, seed, distance, delta_predecessor, weight);
+  }
+
+  SECTION("distances only with unit weights") {
+    vector<int> distance(V, std::numeric_limits<int>::max());
+    std::graph::delta_stepping_shortest_distances(
+          g, 0u, distance, [](std::graph::edge_reference_t<G>) { return 1; }, 2, 3);
+    for (uint32_t r = 0; r < 200; r += 17)
+      for (uint32_t c = 0; c < 300; c += 13)
+        REQUIRE(distance[r * 300 + c] == static_cast<int>(r + c)); // Manhattan distance
+  }
+}
+
+TEST_CASE("Delta-stepping Shortest Paths with a small delta and large weights",
+          "[shortest_paths][delta_stepping]") {
+  // the distances span about 10^10 buckets of width 1
+  using G = std::graph::container::csr_graph<double, void, void>;
+  std::mt19937                                          rng(7);
+  std::uniform_int_distribution<uint32_t>               any(0, 1999);
+  std::uniform_int_distribution<uint32_t>               weight_dist(1, 1000000000);
+  vector<std::graph::copyable_edge_t<uint32_t, double>> edge_list;
+  for (int i = 0; i < 10000; ++i)
+    edge_list.push_back({any(rng), any(rng), static_cast<double>(weight_dist(rng))});
+  std::ranges::sort(edge_list, std::less<>(), [](auto&& e) { return e.source_id; });
+  G g;
+  g.load_edges(edge_list, std::identity(), 2000);
+  auto weight = [&g](std::graph::edge_reference_t<G> uv) { return edge_value(g, uv); };
+
+  const size_t     V       = size(vertices(g));
+  const double     invalid = std::graph::dijkstra_invalid_distance<G, double>();
+  vector<double>   expected(V, invalid);
+  vector<uint32_t> predecessor(V);
+  dijkstra_shortest_paths(g, 0u, expected, predecessor, weight);
+
+  for (double delta : {1.0, 1000.0}) {
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      vector<double>   distance(V, invalid);
+      vector<uint32_t> delta_predecessor(V);
+      std::graph::delta_stepping_shortest_paths(g, 0u, distance, delta_predecessor, weight, delta, num_threads);
+      REQUIRE(distance == expected);
+      check_predecessors(g, 0u, distance, delta_predecessor, weight);
+    }
+  }
+}
+
+TEST_CASE("Bellman-Ford Shortest Paths", "[shortest_paths][bellman_ford]") {
+  using G     = std::graph::container::csr_graph<int, void, void>;
+  auto weight = [](const auto& g) {
+    return [&g](std::graph::edge_reference_t<G> uv) { return edge_value(g, uv); };
+  };
+  const int invalid = std::graph::dijkstra_invalid_distance<G, int>();
+
+  SECTION("negative edges (CLRS fig 24.4)") {
+    //  s=0, t=1, x=2, y=3, z=4
+    G g({{0, 1, 6},  {0, 3, 7},  {1, 2, 5}, {1, 3, 8}, {1, 4, -4},
+         {2, 1, -2}, {3, 2, -3}, {3, 4, 9}, {4, 0, 2}, {4, 2, 7}});
+    const vector<int> expected = {0, 2, 4, 7, -2};
+
+    vector<int>      distance(size(vertices(g)), invalid);
+    vector<uint32_t> predecessor(size(vertices(g)));
+    auto             cycle = std::graph::bellman_ford_shortest_paths(g, 0u, distance, predecessor, weight(g));
+    REQUIRE(!cycle.has_value());
+    REQUIRE(distance == expected);
+    REQUIRE(predecessor == vector<uint32_t>{0, 2, 3, 0, 1});
+
+    vector<int> distance2(size(vertices(g)), invalid);
+    REQUIRE(!std::graph::bellman_ford_shortest_distances(g, 0u, distance2, weight(g)).has_value());
+    REQUIRE(distance2 == expected);
+
+    for (size_t num_threads : {size_t(1), size_t(3)}) {
+      vector<int>      par_distance(size(vertices(g)), invalid);
+      vector<uint32_t> par_predecessor(size(vertices(g)));
+      REQUIRE(!std::graph::parallel_bellman_ford_shortest_paths(g, 0u, par_distance, par_predecessor, weight(g),
+                                                                num_threads)
+                     .has_value());
+      REQUIRE(par_distance == expected);
+      REQUIRE(par_predecessor == vector<uint32_t>{0, 2, 3, 0, 1});
+    }
+  }
+
+  SECTION("negative cycle") {
+    // 1 -> 2 -> 3 -> 1 has a weight of -3
+    G g({{0, 1, 1}, {1, 2, -1}, {2, 3, -1}, {3, 1, -1}, {3, 4, 1}, {5, 0, 1}});
+
+    vector<int>      distance(size(vertices(g)), invalid);
+    vector<uint32_t> predecessor(size(vertices(g)));
+    auto             cycle = std::graph::bellman_ford_shortest_paths(g, 0u, distance, predecessor, weight(g));
+    REQUIRE(cycle.has_value());
+
+    vector<uint32_t> cycle_ids;
+    std::graph::find_negative_cycle(g, predecessor, cycle, back_inserter(cycle_ids));
+    REQUIRE(cycle_ids.size() == 3);
+    std::ranges::rotate(cycle_ids, std::ranges::min_element(cycle_ids));
+    REQUIRE(cycle_ids == vector<uint32_t>{1, 2, 3});
+
+    vector<int> distance2(size(vertices(g)), invalid);
+    REQUIRE(std::graph::bellman_ford_shortest_distances(g, 0u, distance2, weight(g)).has_value());
+
+    vector<int>      par_distance(size(vertices(g)), invalid);
+    vector<uint32_t> par_predecessor(size(vertices(g)));
+    auto par_cycle = std::graph::parallel_bellman_ford_shortest_paths(g, 0u, par_distance, par_predecessor, weight(g), 2);
+    REQUIRE(par_cycle.has_value());
+    vector<uint32_t> par_cycle_ids;
+    std::graph::find_negative_cycle(g, par_predecessor, par_cycle, back_inserter(par_cycle_ids));
+    std::ranges::rotate(par_cycle_ids, std::ranges::min_element(par_cycle_ids));
+    REQUIRE(par_cycle_ids == vector<uint32_t>{1, 2, 3});
+
+    // the cycle isn't reachable from 4
+    vector<int> distance4(size(vertices(g)), invalid);
+    REQUIRE(!std::graph::bellman_ford_shortest_distances(g, 4u, distance4, weight(g)).has_value());
+    REQUIRE(distance4[4] == 0);
+    REQUIRE(distance4[0] == invalid);
+  }
+
+  SECTION("negative self-loop at the seed") {
+    G g({{0, 1, 1}, {1, 1, -1}});
+
+    vector<int>      distance(size(vertices(g)), invalid);
+    vector<uint32_t> predecessor(size(vertices(g)));
+    auto             cycle = std::graph::bellman_ford_shortest_paths(g, 1u, distance, predecessor, weight(g));
+    REQUIRE(cycle == 1u);
+    vector<uint32_t> cycle_ids;
+    std::graph::find_negative_cycle(g, predecessor, cycle, back_inserter(cycle_ids));
+    REQUIRE(cycle_ids == vector<uint32_t>{1});
+
+    vector<int> distance2(size(vertices(g)), invalid);
+    REQUIRE(std::graph::bellman_ford_shortest_distances(g, 1u, distance2, weight(g)) == 1u);
+
+    // the parallel variant falls back to the sequential search to find the cycle
+    vector<int>      par_distance(size(vertices(g)), invalid);
+    vector<uint32_t> par_predecessor(size(vertices(g)));
+    auto par_cycle = std::graph::parallel_bellman_ford_shortest_paths(g, 1u, par_distance, par_predecessor, weight(g), 2);
+    REQUIRE(par_cycle == 1u);
+    vector<uint32_t> par_cycle_ids;
+    std::graph::find_negative_cycle(g, par_predecessor, par_cycle, back_inserter(par_cycle_ids));
+    REQUIRE(par_cycle_ids == vector<uint32_t>{1});
+
+    // a cycle through the seed that isn't a self-loop
+    G                g2({{0, 1, 1}, {1, 2, -1}, {2, 1, -1}});
+    vector<int>      distance3(size(vertices(g2)), invalid);
+    vector<uint32_t> predecessor3(size(vertices(g2)));
+    auto             cycle3 = std::graph::bellman_ford_shortest_paths(g2, 1u, distance3, predecessor3, weight(g2));
+    REQUIRE(cycle3 == 1u);
+    vector<uint32_t> cycle_ids3;
+    std::graph::find_negative_cycle(g2, predecessor3, cycle3, back_inserter(cycle_ids3));
+    std::ranges::rotate(cycle_ids3, std::ranges::min_element(cycle_ids3));
+    REQUIRE(cycle_ids3 == vector<uint32_t>{1, 2});
+  }
+
+  SECTION("negative self-loop at the seed with double weights") {
+    using DG = std::graph::container::csr_graph<double, void, void>;
+    DG   g({{0, 1, 1.0}, {1, 2, 1.0}, {2, 2, -2.5}});
+    auto dweight = [&g](std::graph::edge_reference_t<DG> uv) { return edge_value(g, uv); };
+
+    vector<double>   distance(size(vertices(g)), std::graph::dijkstra_invalid_distance<DG, double>());
+    vector<uint32_t> predecessor(size(vertices(g)));
+    auto             cycle = std::graph::bellman_ford_shortest_paths(g, 2u, distance, predecessor, dweight);
+    REQUIRE(cycle == 2u);
+    vector<uint32_t> cycle_ids;
+    std::graph::find_negative_cycle(g, predecessor, cycle, back_inserter(cycle_ids));
+    REQUIRE(cycle_ids == vector<uint32_t>{2});
+
+    vector<double>   par_distance(size(vertices(g)), std::graph::dijkstra_invalid_distance<DG, double>());
+    vector<uint32_t> par_predecessor(size(vertices(g)));
+    REQUIRE(std::graph::parallel_bellman_ford_shortest_paths(g, 2u, par_distance, par_predecessor, dweight, 2) == 2u);
+  }
+
+  SECTION("no negative cycle with negative edges on a larger graph") {
+    // forward edges with negative weights on a grid, back edges with large positive weights
+    vector<std::graph::copyable_edge_t<uint32_t, int>> edge_list;
+    const uint32_t                                     n = 60;
+    for (uint32_t uid = 0; uid < n * n; ++uid) {
+      if (uid % n + 1 < n)
+        edge_list.push_back({uid, uid + 1, static_cast<int>((uid * 7) % 11) - 4});
+      if (uid >= n)
+        edge_list.push_back({uid, uid - n, 20});
+      if (uid + n < n * n)
+        edge_list.push_back({uid, uid + n, static_cast<int>((uid * 13) % 9) - 3});
+    }
+    G g;
+    g.load_edges(edge_list, std::identity());
+
+    vector<int>      distance(size(vertices(g)), invalid);
+    vector<uint32_t> predecessor(size(vertices(g)));
+    REQUIRE(!std::graph::bellman_ford_shortest_paths(g, 0u, distance, predecessor, weight(g)).has_value());
+
+    vector<int>      par_distance(size(vertices(g)), invalid);
+    vector<uint32_t> par_predecessor(size(vertices(g)));
+    REQUIRE(!std::graph::parallel_bellman_ford_shortest_paths(g, 0u, par_distance, par_predecessor, weight(g), 4)
+                   .has_value());
+    REQUIRE(par_distance == distance);
+    for (uint32_t uid = 1; uid < n * n; ++uid) {
+      bool found = false;
+      for (auto&& uv : edges(g, par_predecessor[uid]))
+        if (target_id(g, uv) == uid && par_distance[par_predecessor[uid]] + edge_value(g, uv) == par_distance[uid])
+          found = true;
+      REQUIRE(found);
+    }
+  }
+}
+
+TEST_CASE("Bellman-Ford Shortest Paths on routes", "[csv][vofl][shortest_paths][bellman_ford]") {
+  init_console();
+  using G             = routes_volf_graph_type;
+  auto&& g            = load_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+  auto   frankfurt_id = find_frankfurt_id(g);
+  auto   weight       = [&g](std::graph::edge_reference_t<G> uv) -> double { return edge_value(g, uv); };
+
+  const double           invalid = std::graph::dijkstra_invalid_distance<G, double>();
+  vector<double>         expected(size(vertices(g)), invalid);
+  vector<vertex_id_t<G>> predecessor(size(vertices(g)));
+  dijkstra_shortest_paths(g, frankfurt_id, expected, predecessor, weight);
+
+  vector<double> distance(size(vertices(g)), invalid);
+  REQUIRE(!std::graph::bellman_ford_shortest_paths(g, frankfurt_id, distance, predecessor, weight).has_value());
+  REQUIRE(distance == expected);
+  check_predecessors(g, frankfurt_id, distance, predecessor, weight);
+
+  vector<double> par_distance(size(vertices(g)), invalid);
+  REQUIRE(!std::graph::parallel_bellman_ford_shortest_paths(g, frankfurt_id, par_distance, predecessor, weight, 4)
+                 .has_value());
+  REQUIRE(par_distance == expected);
+  check_predecessors(g, frankfurt_id, par_distance, predecessor, weight);
+}
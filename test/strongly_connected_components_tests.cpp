@@ -0,0 +1,185 @@
+#include <catch2/catch.hpp>
+#include "graph/graph.hpp"
+#include "graph/algorithm/strongly_connected_components.hpp"
+#include "graph/io/matrix_market.hpp"
+#include "graph/container/csr_graph.hpp"
+#include "graph/container/bidirectional_csr_graph.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include <vector>
+#include <random>
+#include <algorithm>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+
+using std::graph::strongly_connected_components;
+
+using scc_csr_graph_type = std::graph::container::csr_graph<void, void, void>;
+using scc_edge_type      = std::graph::copyable_edge_t<uint32_t, void>;
+
+// Relabel each component with the smallest vertex id in it, so labellings can be compared
+template <class T>
+static vector<uint32_t> min_id_labels(const vector<T>& component) {
+  vector<uint32_t> smallest(component.size(), UINT32_MAX);
+  for (uint32_t uid = 0; uid < component.size(); ++uid)
+    smallest[static_cast<size_t>(component[uid])] = std::min(smallest[static_cast<size_t>(component[uid])], uid);
+  vector<uint32_t> label(component.size());
+  for (uint32_t uid = 0; uid < component.size(); ++uid)
+    label[uid] = smallest[static_cast<size_t>(component[uid])];
+  return label;
+}
+
+// Mostly short forward edges with some short back edges, which make components of many sizes, plus a few
+// long edges in both directions
+static vector<scc_edge_type> scc_edges(uint32_t vertex_count, uint32_t seed) {
+  std::mt19937                            rng(seed);
+  std::uniform_int_distribution<uint32_t> any(0, vertex_count - 1);
+  std::uniform_int_distribution<uint32_t> step(1, 4);
+  std::bernoulli_distribution             back(0.3);
+  vector<scc_edge_type>                   edge_list;
+  for (uint32_t uid = 0; uid < vertex_count; ++uid) {
+    if (uid + 4 < vertex_count)
+      edge_list.push_back({uid, uid + step(rng)});
+    if (uid >= 4 && back(rng))
+      edge_list.push_back({uid, uid - step(rng)});
+  }
+  for (uint32_t i = 0; i < vertex_count / 50; ++i)
+    edge_list.push_back({any(rng), any(rng)});
+  return edge_list;
+}
+
+// Brute force: u and v are in the same component when each reaches the other
+static vector<uint32_t> reference_components(const scc_csr_graph_type& g) {
+  const uint32_t       V = static_cast<uint32_t>(std::ranges::size(vertices(g)));
+  vector<vector<char>> reach(V, vector<char>(V, 0));
+  for (uint32_t seed = 0; seed < V; ++seed) {
+    vector<uint32_t> stack = {seed};
+    reach[seed][seed]      = 1;
+    while (!stack.empty()) {
+      uint32_t uid = stack.back();
+      stack.pop_back();
+      for (auto&& uv : edges(g, uid))
+        if (!reach[seed][target_id(g, uv)]) {
+          reach[seed][target_id(g, uv)] = 1;
+          stack.push_back(target_id(g, uv));
+        }
+    }
+  }
+  vector<uint32_t> label(V);
+  for (uint32_t uid = 0; uid < V; ++uid)
+    for (uint32_t vid = 0; vid <= uid; ++vid)
+      if (reach[uid][vid] && reach[vid][uid]) {
+        label[uid] = vid;
+        break;
+      }
+  return label;
+}
+
+TEST_CASE("strongly_connected_components small graphs", "[scc]") {
+  for (uint32_t seed : {1u, 2u, 3u}) {
+    scc_csr_graph_type g;
+    g.load_unsorted_edges(scc_edges(300, seed), std::identity(), 300, 1);
+    const auto expected = reference_components(g);
+    const auto count    = static_cast<size_t>(std::ranges::count_if(
+          std::views::iota(0u, 300u), [&](uint32_t uid) { return expected[uid] == uid; }));
+
+    vector<uint32_t> component(300);
+    REQUIRE(strongly_connected_components(g, component) == count);
+    REQUIRE(min_id_labels(component) == expected);
+    REQUIRE(*std::ranges::max_element(component) == count - 1);
+
+    // reverse topological order
+    for (uint32_t uid = 0; uid < 300; ++uid)
+      for (auto&& uv : edges(g, uid))
+        REQUIRE(component[uid] >= component[target_id(g, uv)]);
+
+    const auto gt = g.transpose(1);
+    for (size_t num_threads : {size_t(1), size_t(3)}) {
+      vector<uint32_t> parallel(300);
+      REQUIRE(strongly_connected_components(g, gt, parallel, num_threads) == count);
+      REQUIRE(parallel == expected);
+    }
+  }
+}
+
+TEST_CASE("strongly_connected_components larger graphs", "[scc]") {
+  for (uint32_t vertex_count : {1u, 2u, 50000u}) {
+    std::graph::container::bidirectional_csr_graph<void> g;
+    g.load_unsorted_edges(scc_edges(vertex_count, 7), std::identity(), vertex_count, 1);
+
+    vector<uint64_t> component(vertex_count);
+    const size_t     count    = strongly_connected_components(g, component);
+    const auto       expected = min_id_labels(component);
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      vector<int> parallel(vertex_count);
+      REQUIRE(strongly_connected_components(g, g.transpose_graph(), parallel, num_threads) == count);
+      REQUIRE(std::ranges::equal(parallel, expected));
+    }
+  }
+
+  // random graphs without locality, from many small components to a large one
+  for (size_t edge_count : {15000u, 25000u, 60000u}) {
+    std::mt19937                            rng(11);
+    std::uniform_int_distribution<uint32_t> any(0, 19999);
+    vector<scc_edge_type>                   edge_list;
+    for (size_t i = 0; i < edge_count; ++i)
+      edge_list.push_back({any(rng), any(rng)});
+    scc_csr_graph_type g;
+    g.load_unsorted_edges(edge_list, std::identity(), 20000, 1);
+
+    vector<uint32_t> component(20000);
+    const size_t     count    = strongly_connected_components(g, component);
+    const auto       expected = min_id_labels(component);
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      REQUIRE(strongly_connected_components(g, g.transpose(num_threads), component, num_threads) == count);
+      REQUIRE(component == expected);
+    }
+  }
+
+  SECTION("empty graph") {
+    scc_csr_graph_type empty;
+    vector<uint32_t>   none;
+    REQUIRE(strongly_connected_components(empty, none) == 0);
+    REQUIRE(strongly_connected_components(empty, empty, none, 2) == 0);
+  }
+}
+
+TEST_CASE("strongly_connected_components deep search", "[scc]") {
+  // a path of a million vertices is searched without recursion
+  const uint32_t        vertex_count = 1000000;
+  vector<scc_edge_type> edge_list;
+  for (uint32_t uid = 0; uid + 1 < vertex_count; ++uid)
+    edge_list.push_back({uid, uid + 1});
+  scc_csr_graph_type path;
+  path.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1);
+  vector<uint32_t> component(vertex_count);
+  REQUIRE(strongly_connected_components(path, component) == vertex_count);
+  REQUIRE(component[0] == vertex_count - 1);
+  REQUIRE(component[vertex_count - 1] == 0);
+
+  // closing the path makes a cycle, which is one component
+  edge_list.push_back({vertex_count - 1, 0});
+  scc_csr_graph_type cycle;
+  cycle.load_unsorted_edges(edge_list, std::identity(), vertex_count, 1);
+  REQUIRE(strongly_connected_components(cycle, component) == 1);
+  REQUIRE(std::ranges::count(component, 0u) == vertex_count);
+  REQUIRE(strongly_connected_components(cycle, cycle.transpose(2), component, 2) == 1);
+  REQUIRE(std::ranges::count(component, 0u) == vertex_count);
+}
+
+TEST_CASE("strongly_connected_components dynamic_graph", "[scc][dynamic]") {
+  using G = std::graph::container::dynamic_adjacency_graph<std::graph::container::vofl_graph_traits<void>>;
+  std::graph::io::mtx_reader<uint32_t> mtx(TEST_DATA_ROOT_DIR "karate.mtx");
+  G                                    g;
+  g.load_edges(mtx, std::identity(), mtx.vertex_count() + 1); // an isolated vertex
+
+  vector<uint32_t> component(35);
+  REQUIRE(strongly_connected_components(g, component) == 2);
+  REQUIRE(std::ranges::count(component, component[0]) == 34);
+  REQUIRE(strongly_connected_components(g, g, component, 2) == 2); // symmetric, so g is its own transpose
+  REQUIRE(std::ranges::count(component, 0u) == 34);
+  REQUIRE(component[34] == 34);
+}
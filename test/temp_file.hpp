@@ -0,0 +1,18 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+// A file in the temp directory that's removed when it goes out of scope
+struct temp_file {
+  std::filesystem::path path;
+
+  explicit temp_file(const char* name) : path(std::filesystem::temp_directory_path() / name) {}
+  temp_file(const char* name, const char* contents) : temp_file(name) {
+    std::ofstream(path, std::ios::binary) << contents;
+  }
+  ~temp_file() { std::filesystem::remove(path); }
+
+  temp_file(const temp_file&)            = delete;
+  temp_file& operator=(const temp_file&) = delete;
+};
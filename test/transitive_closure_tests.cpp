@@ -7,6 +7,7 @@
 #include "graph/views/neighbors.hpp"
 //#include "graph/view/edgelist_view.hpp"
 #include "graph/container/dynamic_graph.hpp"
+#include "graph/container/csr_graph.hpp"
 #include <cassert>
 #ifdef _MSC_VER
 #  include "Windows.h"
@@ -59,3 +60,124 @@ TEST_CASE("Warshall's Algorithm", "[csv][vofl][transitive_closure][warshall]") {
   std::vector<std::graph::reaches<G>> reaches;
   std::graph::warshall_transitive_closure(g, std::back_inserter(reaches));
 }
+
+// Reachability by a search from each vertex, to validate the transitive closure algorithms.
+// A vertex only reaches itself if it's on a cycle or has a self-loop.
+template <class G>
+auto search_transitive_closure(G&& g) {
+  using vertex_id_type = vertex_id_t<G>;
+  std::vector<std::pair<vertex_id_type, vertex_id_type>> result;
+  const size_t                                           V = size(vertices(g));
+  for (vertex_id_type uid = 0; uid < V; ++uid) {
+    std::vector<bool>           reached(V, false);
+    std::vector<vertex_id_type> stk{uid};
+    while (!stk.empty()) {
+      vertex_id_type xid = stk.back();
+      stk.pop_back();
+      for (auto&& uv : edges(g, xid)) {
+        vertex_id_type vid = static_cast<vertex_id_type>(target_id(g, uv));
+        if (!reached[vid]) {
+          reached[vid] = true;
+          stk.push_back(vid);
+        }
+      }
+    }
+    for (vertex_id_type vid = 0; vid < V; ++vid)
+      if (reached[vid])
+        result.push_back({uid, vid});
+  }
+  return result;
+}
+
+template <class G>
+auto to_pairs(const std::vector<std::graph::reaches<G>>& reaches) {
+  std::vector<std::pair<vertex_id_t<G>, vertex_id_t<G>>> result;
+  for (auto&& r : reaches)
+    result.push_back({r.from, r.to});
+  return result;
+}
+
+TEST_CASE("Warshall's Algorithm results", "[csv][vofl][transitive_closure][warshall]") {
+  init_console();
+  using G  = routes_volf_graph_type;
+  auto&& g = load_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+
+  std::vector<std::graph::reaches<G>> reaches;
+  std::graph::warshall_transitive_closure(g, std::back_inserter(reaches));
+  REQUIRE(to_pairs(reaches) == search_transitive_closure(g));
+}
+
+// more than 2 blocks of 64 vertices, with cycles across blocks, self-loops and unreachable vertices
+static auto make_closure_test_graph() {
+  using G = std::graph::container::csr_graph<int, void, void>;
+  std::vector<std::graph::copyable_edge_t<uint32_t, int>> edge_list;
+  const uint32_t                                          n = 150;
+  for (uint32_t uid = 0; uid < n; ++uid) {
+    if (uid % 10 != 9)
+      edge_list.push_back({uid, (uid * 37 + 11) % n, 1});
+    if (uid % 7 == 0)
+      edge_list.push_back({uid, (uid + 100) % n, 1});
+    if (uid % 31 == 0)
+      edge_list.push_back({uid, uid, 1});
+  }
+  G g;
+  g.load_edges(edge_list, std::identity(), n);
+  return g;
+}
+
+TEST_CASE("Warshall's Algorithm on a graph with cycles", "[transitive_closure][warshall]") {
+  auto&& g = make_closure_test_graph();
+  using G  = std::remove_cvref_t<decltype(g)>;
+
+  std::vector<std::graph::reaches<G>> reaches;
+  std::graph::warshall_transitive_closure(g, std::back_inserter(reaches));
+  REQUIRE(to_pairs(reaches) == search_transitive_closure(g));
+}
+
+template <class G>
+auto sorted_pairs(const std::vector<std::graph::reaches<G>>& reaches) {
+  auto result = to_pairs(reaches);
+  std::ranges::sort(result);
+  return result;
+}
+
+TEST_CASE("DFS Transitive Closure", "[csv][vofl][transitive_closure][dfs]") {
+  init_console();
+  using G  = routes_volf_graph_type;
+  auto&& g = load_graph<G>(TEST_DATA_ROOT_DIR "germany_routes.csv");
+
+  std::vector<std::graph::reaches<G>> reaches;
+  std::graph::dfs_transitive_closure(g, std::back_inserter(reaches));
+  REQUIRE(sorted_pairs(reaches) == search_transitive_closure(g));
+}
+
+TEST_CASE("DFS Transitive Closure on a graph with cycles", "[transitive_closure][dfs]") {
+  auto&& g = make_closure_test_graph();
+  using G  = std::remove_cvref_t<decltype(g)>;
+
+  std::vector<std::graph::reaches<G>> reaches;
+  std::graph::dfs_transitive_closure(g, std::back_inserter(reaches));
+  REQUIRE(sorted_pairs(reaches) == search_transitive_closure(g));
+}
+
+TEST_CASE("DFS Transitive Closure on a large sparse graph", "[transitive_closure][dfs]") {
+  // 30,000 vertices: chains of 50 vertices with small cycles and links to other chains. There are enough
+  // components that the reachability bitsets are evaluated in more than one window.
+  using G = std::graph::container::csr_graph<int, void, void>;
+  std::vector<std::graph::copyable_edge_t<uint32_t, int>> edge_list;
+  const uint32_t                                          n = 30000;
+  for (uint32_t uid = 0; uid < n; ++uid) {
+    if (uid % 50 != 0)
+      edge_list.push_back({uid, uid - 1, 1});
+    if (uid % 1000 == 7)
+      edge_list.push_back({uid, uid + 2, 1}); // cycle of 3
+    if (uid % 977 == 0 && uid >= 5000)
+      edge_list.push_back({uid, uid - 4999, 1}); // to an earlier chain
+  }
+  G g;
+  g.load_edges(edge_list, std::identity(), n);
+
+  std::vector<std::graph::reaches<G>> reaches;
+  std::graph::dfs_transitive_closure(g, std::back_inserter(reaches));
+  REQUIRE(sorted_pairs(reaches) == search_transitive_closure(g));
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch.hpp>
+#include "undirected_graphs.hpp"
+#include "graph/graph.hpp"
+#include "graph/algorithm/triangle_count.hpp"
+#include "graph/container/csr_graph.hpp"
+#include <vector>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <set>
+
+using std::vector;
+
+using std::graph::vertices;
+using std::graph::edges;
+using std::graph::target_id;
+
+using std::graph::triangle_count;
+using std::graph::local_triangle_count;
+
+using tc_csr_graph_type = std::graph::container::csr_graph<void, void, void>;
+using tc_edge_type      = std::graph::copyable_edge_t<uint32_t, void>;
+
+// Brute force: the triangles of each vertex, counting each distinct neighbor pair that's connected
+template <class G>
+static vector<size_t> reference_local_counts(G&& g) {
+  const size_t                   V = std::ranges::size(vertices(g));
+  vector<std::set<uint32_t>>     adj(V);
+  for (uint32_t uid = 0; uid < V; ++uid)
+    for (auto&& uv : edges(g, uid))
+      if (target_id(g, uv) != uid)
+        adj[uid].insert(target_id(g, uv));
+  vector<size_t> count(V);
+  for (uint32_t uid = 0; uid < V; ++uid)
+    for (auto v = adj[uid].begin(); v != adj[uid].end(); ++v)
+      for (auto w = std::next(v); w != adj[uid].end(); ++w)
+        count[uid] += adj[*v].contains(*w);
+  return count;
+}
+
+TEST_CASE("triangle_count karate", "[triangle_count]") {
+  std::graph::io::mtx_reader<uint32_t> mtx(TEST_DATA_ROOT_DIR "karate.mtx");
+  tc_csr_graph_type                    g;
+  g.load_unsorted_edges(mtx, std::identity(), mtx.vertex_count(), 1);
+
+  REQUIRE(triangle_count(g, 1) == 45);
+  REQUIRE(triangle_count(g, 3) == 45);
+
+  vector<uint32_t> count(std::ranges::size(vertices(g)));
+  REQUIRE(local_triangle_count(g, count, 2) == 45);
+  auto expected = reference_local_counts(g);
+  REQUIRE(std::ranges::equal(count, expected));
+  REQUIRE(count[0] == 18); // the instructor
+  REQUIRE(count[33] == 15); // the administrator
+
+  // sorted rows give the same result
+  g.sort_rows(1);
+  REQUIRE(triangle_count(g, 2) == 45);
+}
+
+TEST_CASE("triangle_count random graphs", "[triangle_count]") {
+  std::mt19937 rng(17);
+  for (uint32_t vertex_count : {1u, 50u, 400u}) {
+    std::uniform_int_distribution<uint32_t> vid_dist(0, vertex_count - 1);
+    vector<tc_edge_type>                    edge_list;
+    for (uint32_t i = 0; i < vertex_count * 8; ++i) // includes duplicates and self-loops
+      edge_list.push_back({vid_dist(rng), vid_dist(rng)});
+    for (uint32_t vid = 1; vid < vertex_count; vid += 2) // vertex 0 is a hub, for skewed intersections
+      edge_list.push_back({0, vid});
+    std::ranges::shuffle(edge_list, rng); // random row order
+    auto g = make_undirected_graph<tc_csr_graph_type>(edge_list, vertex_count);
+
+    auto   expected = reference_local_counts(g);
+    size_t sum      = 0;
+    for (auto&& c : expected)
+      sum += c;
+    REQUIRE(sum % 3 == 0);
+
+    for (size_t num_threads : {size_t(1), size_t(4)}) {
+      REQUIRE(triangle_count(g, num_threads) == sum / 3);
+      vector<uint64_t> count(vertex_count, 99);
+      REQUIRE(local_triangle_count(g, count, num_threads) == sum / 3);
+      REQUIRE(std::ranges::equal(count, expected));
+    }
+  }
+}
+
+TEST_CASE("triangle_count karate dynamic_graph", "[triangle_count][dynamic]") {
+  auto g = load_karate_graph();
+  REQUIRE(triangle_count(g, 1) == 45);
+  vector<int> count(std::ranges::size(vertices(g)));
+  REQUIRE(local_triangle_count(g, count, 3) == 45);
+  REQUIRE(std::ranges::equal(count, reference_local_counts(g)));
+}
+
+TEST_CASE("triangle_count intersection kernels", "[triangle_count]") {
+  std::mt19937 rng(5);
+  for (size_t na : std::array<size_t, 6>{0, 3, 8, 17, 64, 300}) {
+    for (size_t nb : std::array<size_t, 6>{0, 1, 9, 64, 1000, 20000}) {
+      auto make = [&rng](size_t n, uint32_t range) {
+        vector<uint32_t>                        v;
+        std::uniform_int_distribution<uint32_t> dist(0, range);
+        while (v.size() < n)
+          v.push_back(dist(rng));
+        std::ranges::sort(v);
+        v.erase(std::ranges::unique(v).begin(), v.end());
+        return v;
+      };
+      const uint32_t   range = static_cast<uint32_t>(2 * std::max(na, nb) + 1);
+      vector<uint32_t> a = make(na, range), b = make(nb, range), expected;
+      std::ranges::set_intersection(a, b, std::back_inserter(expected));
+
+      vector<uint32_t> found;
+      auto             visit = [&found](uint32_t w) { found.push_back(w); };
+      const uint32_t*  a0 = a.data();
+      const uint32_t*  b0 = b.data();
+      REQUIRE(std::graph::_detail::intersect_sorted<true>(a0, a0 + a.size(), b0, b0 + b.size(), visit) ==
+              expected.size());
+      std::ranges::sort(found);
+      REQUIRE(found == expected);
+      REQUIRE(std::graph::_detail::intersect_merge<false>(a0, a0 + a.size(), b0, b0 + b.size(), visit) ==
+              expected.size());
+      REQUIRE(std::graph::_detail::intersect_gallop<false>(a0, a0 + a.size(), b0, b0 + b.size(), visit) ==
+              expected.size());
+#if defined(GRAPH_TRIANGLE_COUNT_AVX2)
+      if (std::graph::_detail::cpu_has_avx2()) {
+        found.clear();
+        REQUIRE(std::graph::_detail::intersect_avx2<true>(a0, a0 + a.size(), b0, b0 + b.size(), visit) ==
+                expected.size());
+        std::ranges::sort(found);
+        REQUIRE(found == expected);
+      }
+#endif
+    }
+  }
+}
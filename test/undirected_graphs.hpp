@@ -0,0 +1,37 @@
+#pragma once
+
+#include "graph/graph.hpp"
+#include "graph/io/matrix_market.hpp"
+#include "graph/container/dynamic_graph.hpp"
+#include <vector>
+#include <utility>
+#include <functional>
+#include <cstdint>
+
+// A graph of type G with each edge of edge_list stored in both directions, as the algorithms for undirected
+// graphs require. G must have load_unsorted_edges, e.g. a csr_graph.
+template <class G, class E>
+G make_undirected_graph(const std::vector<E>& edge_list, uint32_t vertex_count) {
+  std::vector<E> both;
+  both.reserve(2 * edge_list.size());
+  for (auto&& uv : edge_list) {
+    both.push_back(uv);
+    both.push_back(uv);
+    std::swap(both.back().source_id, both.back().target_id);
+  }
+  G g;
+  g.load_unsorted_edges(both, std::identity(), vertex_count, 1);
+  return g;
+}
+
+// Zachary's karate club: 34 vertices and 78 undirected edges. The Matrix Market file is symmetric, so the
+// reader yields each edge in both directions.
+using karate_graph_type =
+      std::graph::container::dynamic_adjacency_graph<std::graph::container::vofl_graph_traits<void>>;
+
+inline karate_graph_type load_karate_graph() {
+  std::graph::io::mtx_reader<uint32_t> mtx(TEST_DATA_ROOT_DIR "karate.mtx");
+  karate_graph_type                    g;
+  g.load_edges(mtx, std::identity(), mtx.vertex_count());
+  return g;
+}